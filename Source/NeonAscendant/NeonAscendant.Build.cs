@@ -14,14 +14,23 @@ public class NeonAscendant : ModuleRules
             "GameplayTags",
             "InputCore",
             "EnhancedInput",
-            "AIModule"
+            "AIModule",
+            "NavigationSystem",
+            "NeonMissionCore"
         });
 
         PrivateDependencyModuleNames.AddRange(new string[]
         {
-            "Projects"
+            "Projects",
+            "Json",
+            "RenderCore"
         });
 
+        if (Target.bBuildEditor)
+        {
+            PrivateDependencyModuleNames.Add("DirectoryWatcher");
+        }
+
         bEnableExceptions = true;
     }
 }
@@ -0,0 +1,375 @@
+#include "AnalyzeMissionCoverageCommandlet.h"
+
+#include "Async/ParallelFor.h"
+#include "MissionCatalog.h"
+#include "MissionData.h"
+#include "MissionGenerator.h"
+#include "MissionSampler.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+    constexpr int64 DefaultSampleCount = 20 * 1000 * 1000;
+    constexpr int32 SamplesPerBlock = 64 * 1024;
+
+    // Chi-square z-scores beyond this are reported as a mismatch between weights and output
+    constexpr double MaxAcceptedZScore = 4.0;
+
+    struct FCoverageDimensions
+    {
+        int32 Districts = 0;
+        int32 Factions = 0;
+        int32 Complications = 0;
+        int32 Archetypes = 0;
+        int32 Weapons = 0;
+        int32 Implants = 0;
+        int32 ExtractionConditions = 0;
+
+        int32 NumTriples() const { return Districts * Factions * Complications; }
+
+        int32 GetTripleIndex(int32 District, int32 Faction, int32 Complication) const
+        {
+            return (District * Factions + Faction) * Complications + Complication;
+        }
+    };
+
+    // Filled by one worker; merged once sampling is done, so the hot loop never shares a cache line
+    struct FCoverageHistogram
+    {
+        TArray<int64> Triples;
+        TArray<int64> Archetypes;
+        TArray<int64> Weapons;
+        TArray<int64> Implants;
+        TArray<int64> ExtractionConditions;
+
+        explicit FCoverageHistogram(const FCoverageDimensions& Dimensions)
+        {
+            Triples.SetNumZeroed(Dimensions.NumTriples());
+            Archetypes.SetNumZeroed(Dimensions.Archetypes);
+            Weapons.SetNumZeroed(Dimensions.Weapons);
+            Implants.SetNumZeroed(Dimensions.Implants);
+            ExtractionConditions.SetNumZeroed(Dimensions.ExtractionConditions);
+        }
+
+        void Merge(const FCoverageHistogram& Other)
+        {
+            auto MergeCounts = [](TArray<int64>& Into, const TArray<int64>& From)
+            {
+                for (int32 Index = 0; Index < Into.Num(); ++Index)
+                {
+                    Into[Index] += From[Index];
+                }
+            };
+
+            MergeCounts(Triples, Other.Triples);
+            MergeCounts(Archetypes, Other.Archetypes);
+            MergeCounts(Weapons, Other.Weapons);
+            MergeCounts(Implants, Other.Implants);
+            MergeCounts(ExtractionConditions, Other.ExtractionConditions);
+        }
+    };
+
+    // Observed counts against expected probabilities for one marginal or pairwise view
+    struct FCoverageTable
+    {
+        FString Name;
+        TArray<FString> Labels;
+        TArray<int64> Observed;
+        TArray<double> Expected;
+
+        void Init(const TCHAR* InName, int32 NumCells)
+        {
+            Name = InName;
+            Labels.SetNum(NumCells);
+            Observed.SetNumZeroed(NumCells);
+            Expected.SetNumZeroed(NumCells);
+        }
+    };
+
+    struct FChiSquare
+    {
+        double Value = 0.0;
+        int32 DegreesOfFreedom = 0;
+        double ZScore = 0.0;
+    };
+
+    FChiSquare ComputeChiSquare(const FCoverageTable& Table, int64 SampleCount)
+    {
+        FChiSquare Result;
+        int32 NumCells = 0;
+
+        for (int32 Cell = 0; Cell < Table.Observed.Num(); ++Cell)
+        {
+            if (Table.Expected[Cell] <= 0.0)
+            {
+                continue;
+            }
+
+            const double ExpectedCount = Table.Expected[Cell] * SampleCount;
+            const double Difference = Table.Observed[Cell] - ExpectedCount;
+            Result.Value += Difference * Difference / ExpectedCount;
+            ++NumCells;
+        }
+
+        Result.DegreesOfFreedom = FMath::Max(0, NumCells - 1);
+        if (Result.DegreesOfFreedom > 0)
+        {
+            // Wilson-Hilferty: (chi2 / k)^(1/3) is roughly normal with mean 1 - 2/(9k)
+            const double K = Result.DegreesOfFreedom;
+            const double Variance = 2.0 / (9.0 * K);
+            Result.ZScore = (FMath::Pow(Result.Value / K, 1.0 / 3.0) - (1.0 - Variance)) / FMath::Sqrt(Variance);
+        }
+
+        return Result;
+    }
+
+    FCoverageTable MakeUniformTable(const TCHAR* Name, const TArray<int64>& Counts, TFunctionRef<FString(int32)> GetLabel)
+    {
+        FCoverageTable Table;
+        Table.Init(Name, Counts.Num());
+        for (int32 Cell = 0; Cell < Counts.Num(); ++Cell)
+        {
+            Table.Labels[Cell] = GetLabel(Cell);
+            Table.Observed[Cell] = Counts[Cell];
+            Table.Expected[Cell] = 1.0 / Counts.Num();
+        }
+        return Table;
+    }
+
+    // Collapses the triple histogram onto the cells chosen by GetCell.
+    FCoverageTable ReduceTriples(const TCHAR* Name, const FCoverageDimensions& Dimensions, const TArray<int64>& TripleCounts, const TArray<double>& TripleProbabilities,
+        int32 NumCells, TFunctionRef<int32(int32, int32, int32)> GetCell, TFunctionRef<FString(int32)> GetLabel)
+    {
+        FCoverageTable Table;
+        Table.Init(Name, NumCells);
+        for (int32 Cell = 0; Cell < NumCells; ++Cell)
+        {
+            Table.Labels[Cell] = GetLabel(Cell);
+        }
+
+        for (int32 District = 0; District < Dimensions.Districts; ++District)
+        {
+            for (int32 Faction = 0; Faction < Dimensions.Factions; ++Faction)
+            {
+                for (int32 Complication = 0; Complication < Dimensions.Complications; ++Complication)
+                {
+                    const int32 Triple = Dimensions.GetTripleIndex(District, Faction, Complication);
+                    const int32 Cell = GetCell(District, Faction, Complication);
+                    Table.Observed[Cell] += TripleCounts[Triple];
+                    Table.Expected[Cell] += TripleProbabilities[Triple];
+                }
+            }
+        }
+
+        return Table;
+    }
+
+    void WriteTable(TJsonWriter<>& Writer, const FCoverageTable& Table, int64 SampleCount)
+    {
+        const FChiSquare ChiSquare = ComputeChiSquare(Table, SampleCount);
+
+        Writer.WriteObjectStart();
+        Writer.WriteValue(TEXT("Name"), Table.Name);
+        Writer.WriteValue(TEXT("ChiSquare"), ChiSquare.Value);
+        Writer.WriteValue(TEXT("DegreesOfFreedom"), ChiSquare.DegreesOfFreedom);
+        Writer.WriteValue(TEXT("ZScore"), ChiSquare.ZScore);
+        Writer.WriteArrayStart(TEXT("Cells"));
+        for (int32 Cell = 0; Cell < Table.Observed.Num(); ++Cell)
+        {
+            Writer.WriteObjectStart();
+            Writer.WriteValue(TEXT("Label"), Table.Labels[Cell]);
+            Writer.WriteValue(TEXT("Observed"), Table.Observed[Cell]);
+            Writer.WriteValue(TEXT("ObservedFrequency"), static_cast<double>(Table.Observed[Cell]) / SampleCount);
+            Writer.WriteValue(TEXT("ExpectedFrequency"), Table.Expected[Cell]);
+            Writer.WriteObjectEnd();
+        }
+        Writer.WriteArrayEnd();
+        Writer.WriteObjectEnd();
+    }
+}
+
+UAnalyzeMissionCoverageCommandlet::UAnalyzeMissionCoverageCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UAnalyzeMissionCoverageCommandlet::Main(const FString& Params)
+{
+    int32 Seed = 1337;
+    int64 SampleCount = DefaultSampleCount;
+    FString OutputPath;
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+    FParse::Value(*Params, TEXT("Count="), SampleCount);
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+    SampleCount = FMath::Max<int64>(1, SampleCount);
+
+    if (!FMissionCatalog::Get().IsLoaded())
+    {
+        UE_LOG(LogTemp, Error, TEXT("AnalyzeMissionCoverage: %s"), *FMissionCatalog::Get().GetLoadError());
+        return 1;
+    }
+
+    const TArray<FAscendantDistrict>& Districts = NeonAscendantData::GetDistricts();
+    const TArray<FAscendantFaction>& Factions = NeonAscendantData::GetFactions();
+    const TArray<FAscendantComplication>& Complications = NeonAscendantData::GetComplications();
+
+    FCoverageDimensions Dimensions;
+    Dimensions.Districts = Districts.Num();
+    Dimensions.Factions = Factions.Num();
+    Dimensions.Complications = Complications.Num();
+    Dimensions.Archetypes = NeonAscendantData::GetArchetypes().Num();
+    Dimensions.Weapons = NeonAscendantData::GetWeapons().Num();
+    Dimensions.Implants = NeonAscendantData::GetImplants().Num();
+    Dimensions.ExtractionConditions = NeonAscendantData::GetExtractionConditions().Num();
+
+    // Sample the counter-based sequence in blocks; every worker task owns one histogram
+    const double StartTime = FPlatformTime::Seconds();
+    const int32 NumBlocks = static_cast<int32>(FMath::DivideAndRoundUp<int64>(SampleCount, SamplesPerBlock));
+
+    TArray<FCoverageHistogram> WorkerHistograms;
+    ParallelForWithTaskContext(TEXT("AnalyzeMissionCoverage"), WorkerHistograms, NumBlocks, 1,
+        [&Dimensions](int32, int32) { return FCoverageHistogram(Dimensions); },
+        [&Dimensions, Seed, SampleCount](FCoverageHistogram& Histogram, int32 Block)
+        {
+            const int64 First = static_cast<int64>(Block) * SamplesPerBlock;
+            const int64 Last = FMath::Min(SampleCount, First + SamplesPerBlock);
+            for (int64 Index = First; Index < Last; ++Index)
+            {
+                const FMissionBriefHandle Handle = UMissionGenerator::GenerateMissionBriefHandleAt(Seed, Index);
+                ++Histogram.Triples[Dimensions.GetTripleIndex(Handle.DistrictIndex, Handle.FactionIndex, Handle.ComplicationIndex)];
+                ++Histogram.Archetypes[Handle.ArchetypeIndex];
+                ++Histogram.Weapons[Handle.WeaponIndex];
+                ++Histogram.Implants[Handle.ImplantIndex];
+                ++Histogram.ExtractionConditions[Handle.ExtractionIndex];
+            }
+        });
+
+    FCoverageHistogram Histogram(Dimensions);
+    for (const FCoverageHistogram& WorkerHistogram : WorkerHistograms)
+    {
+        Histogram.Merge(WorkerHistogram);
+    }
+
+    const double SampleSeconds = FPlatformTime::Seconds() - StartTime;
+    UE_LOG(LogTemp, Display, TEXT("AnalyzeMissionCoverage: %lld briefs on %d worker histograms in %.2f s (%.1f M briefs/s)"),
+        SampleCount, WorkerHistograms.Num(), SampleSeconds, SampleCount / SampleSeconds / 1e6);
+
+    // Expected triple probabilities straight from the sampler's weights and compatibility masks
+    const FMissionSampler& Sampler = FMissionSampler::Get();
+    TArray<double> TripleProbabilities;
+    TripleProbabilities.SetNumZeroed(Dimensions.NumTriples());
+    for (int32 District = 0; District < Dimensions.Districts; ++District)
+    {
+        for (int32 Faction = 0; Faction < Dimensions.Factions; ++Faction)
+        {
+            for (int32 Complication = 0; Complication < Dimensions.Complications; ++Complication)
+            {
+                TripleProbabilities[Dimensions.GetTripleIndex(District, Faction, Complication)] = Sampler.GetTripleProbability(District, Faction, Complication);
+            }
+        }
+    }
+
+    auto DistrictName = [&Districts](int32 Index) { return Districts[Index].Name; };
+    auto FactionName = [&Factions](int32 Index) { return Factions[Index].Name; };
+    auto ComplicationName = [&Complications](int32 Index) { return Complications[Index].Description; };
+
+    TArray<FCoverageTable> Tables;
+    Tables.Add(ReduceTriples(TEXT("District"), Dimensions, Histogram.Triples, TripleProbabilities, Dimensions.Districts,
+        [](int32 D, int32, int32) { return D; }, DistrictName));
+    Tables.Add(ReduceTriples(TEXT("Faction"), Dimensions, Histogram.Triples, TripleProbabilities, Dimensions.Factions,
+        [](int32, int32 F, int32) { return F; }, FactionName));
+    Tables.Add(ReduceTriples(TEXT("Complication"), Dimensions, Histogram.Triples, TripleProbabilities, Dimensions.Complications,
+        [](int32, int32, int32 C) { return C; }, ComplicationName));
+    Tables.Add(ReduceTriples(TEXT("District x Faction"), Dimensions, Histogram.Triples, TripleProbabilities, Dimensions.Districts * Dimensions.Factions,
+        [&Dimensions](int32 D, int32 F, int32) { return D * Dimensions.Factions + F; },
+        [&](int32 Cell) { return DistrictName(Cell / Dimensions.Factions) + TEXT(" / ") + FactionName(Cell % Dimensions.Factions); }));
+    Tables.Add(ReduceTriples(TEXT("District x Complication"), Dimensions, Histogram.Triples, TripleProbabilities, Dimensions.Districts * Dimensions.Complications,
+        [&Dimensions](int32 D, int32, int32 C) { return D * Dimensions.Complications + C; },
+        [&](int32 Cell) { return DistrictName(Cell / Dimensions.Complications) + TEXT(" / ") + ComplicationName(Cell % Dimensions.Complications); }));
+    Tables.Add(ReduceTriples(TEXT("Faction x Complication"), Dimensions, Histogram.Triples, TripleProbabilities, Dimensions.Factions * Dimensions.Complications,
+        [&Dimensions](int32, int32 F, int32 C) { return F * Dimensions.Complications + C; },
+        [&](int32 Cell) { return FactionName(Cell / Dimensions.Complications) + TEXT(" / ") + ComplicationName(Cell % Dimensions.Complications); }));
+    Tables.Add(ReduceTriples(TEXT("District x Faction x Complication"), Dimensions, Histogram.Triples, TripleProbabilities, Dimensions.NumTriples(),
+        [&Dimensions](int32 D, int32 F, int32 C) { return Dimensions.GetTripleIndex(D, F, C); },
+        [&](int32 Cell)
+        {
+            const int32 Complication = Cell % Dimensions.Complications;
+            const int32 Pair = Cell / Dimensions.Complications;
+            return DistrictName(Pair / Dimensions.Factions) + TEXT(" / ") + FactionName(Pair % Dimensions.Factions) + TEXT(" / ") + ComplicationName(Complication);
+        }));
+    Tables.Add(MakeUniformTable(TEXT("Archetype"), Histogram.Archetypes, [](int32 Index) { return NeonAscendantData::GetArchetypes()[Index].Name; }));
+    Tables.Add(MakeUniformTable(TEXT("PrimaryWeapon"), Histogram.Weapons, [](int32 Index) { return NeonAscendantData::GetWeapons()[Index].Name; }));
+    Tables.Add(MakeUniformTable(TEXT("BackupImplant"), Histogram.Implants, [](int32 Index) { return NeonAscendantData::GetImplants()[Index].Name; }));
+    Tables.Add(MakeUniformTable(TEXT("ExtractionCondition"), Histogram.ExtractionConditions, [](int32 Index) { return NeonAscendantData::GetExtractionConditions()[Index]; }));
+
+    bool bPassed = true;
+
+    for (const FCoverageTable& Table : Tables)
+    {
+        const FChiSquare ChiSquare = ComputeChiSquare(Table, SampleCount);
+        const bool bDeviates = FMath::Abs(ChiSquare.ZScore) > MaxAcceptedZScore;
+        bPassed &= !bDeviates;
+
+        UE_LOG(LogTemp, Display, TEXT("%s: chi-square %.2f, %d dof, z %.2f%s"), *Table.Name, ChiSquare.Value, ChiSquare.DegreesOfFreedom, ChiSquare.ZScore,
+            bDeviates ? TEXT("  <-- deviates from configured weights") : TEXT(""));
+
+        for (int32 Cell = 0; Cell < Table.Observed.Num(); ++Cell)
+        {
+            UE_LOG(LogTemp, Verbose, TEXT("  %-80s observed %.5f expected %.5f"), *Table.Labels[Cell],
+                static_cast<double>(Table.Observed[Cell]) / SampleCount, Table.Expected[Cell]);
+
+            if (Table.Expected[Cell] > 0.0 && Table.Observed[Cell] == 0)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("  Never seen: %s (expected %.1f occurrences)"), *Table.Labels[Cell], Table.Expected[Cell] * SampleCount);
+            }
+            else if (Table.Expected[Cell] <= 0.0 && Table.Observed[Cell] > 0)
+            {
+                UE_LOG(LogTemp, Error, TEXT("  Seen %lld times but forbidden by the catalog: %s"), Table.Observed[Cell], *Table.Labels[Cell]);
+                bPassed = false;
+            }
+        }
+    }
+
+    // Entries no draw can ever produce, regardless of sample count
+    for (int32 Table = 0; Table < 3; ++Table)
+    {
+        for (int32 Cell = 0; Cell < Tables[Table].Expected.Num(); ++Cell)
+        {
+            if (Tables[Table].Expected[Cell] <= 0.0)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("Unreachable %s: %s"), *Tables[Table].Name, *Tables[Table].Labels[Cell]);
+            }
+        }
+    }
+
+    if (!OutputPath.IsEmpty())
+    {
+        FString Json;
+        const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("Seed"), Seed);
+        Writer->WriteValue(TEXT("Count"), SampleCount);
+        Writer->WriteValue(TEXT("Seconds"), SampleSeconds);
+        Writer->WriteValue(TEXT("Passed"), bPassed);
+        Writer->WriteArrayStart(TEXT("Tables"));
+        for (const FCoverageTable& Table : Tables)
+        {
+            WriteTable(*Writer, Table, SampleCount);
+        }
+        Writer->WriteArrayEnd();
+        Writer->WriteObjectEnd();
+        Writer->Close();
+
+        if (!FFileHelper::SaveStringToFile(Json, *OutputPath))
+        {
+            UE_LOG(LogTemp, Error, TEXT("AnalyzeMissionCoverage: could not write %s"), *OutputPath);
+            return 1;
+        }
+    }
+
+    return bPassed ? 0 : 1;
+}
@@ -0,0 +1,28 @@
+#include "CookMissionCatalogCommandlet.h"
+
+#include "MissionCatalog.h"
+
+UCookMissionCatalogCommandlet::UCookMissionCatalogCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UCookMissionCatalogCommandlet::Main(const FString& Params)
+{
+    FString SourcePath = FMissionCatalog::GetSourcePath();
+    FString CookedPath = FMissionCatalog::GetCookedPath();
+    FParse::Value(*Params, TEXT("Source="), SourcePath);
+    FParse::Value(*Params, TEXT("Output="), CookedPath);
+
+    FString Error;
+    if (!FMissionCatalog::CookFile(SourcePath, CookedPath, Error))
+    {
+        UE_LOG(LogTemp, Error, TEXT("CookMissionCatalog - %s"), *Error);
+        return 1;
+    }
+
+    return 0;
+}
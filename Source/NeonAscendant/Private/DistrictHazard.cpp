@@ -1,6 +1,7 @@
 #include "DistrictHazard.h"
 #include "NeonCharacter.h"
 #include "NeonEnemy.h"
+#include "NeonSpatialGridSubsystem.h"
 #include "Components/SphereComponent.h"
 #include "Particles/ParticleSystemComponent.h"
 #include "Kismet/GameplayStatics.h"
@@ -15,9 +16,8 @@ ADistrictHazard::ADistrictHazard()
 	HazardVolume = CreateDefaultSubobject<USphereComponent>(TEXT("HazardVolume"));
 	RootComponent = HazardVolume;
 	HazardVolume->SetSphereRadius(EffectRadius);
-	HazardVolume->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-	HazardVolume->SetCollisionObjectType(ECC_WorldDynamic);
-	HazardVolume->SetCollisionResponseToAllChannels(ECR_Overlap);
+	// Marks the area only; who is inside comes from the spatial grid
+	HazardVolume->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 
 	// Create particle effect
 	HazardEffect = CreateDefaultSubobject<UParticleSystemComponent>(TEXT("HazardEffect"));
@@ -28,9 +28,11 @@ void ADistrictHazard::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// Bind overlap events
-	HazardVolume->OnComponentBeginOverlap.AddDynamic(this, &ADistrictHazard::OnHazardBeginOverlap);
-	HazardVolume->OnComponentEndOverlap.AddDynamic(this, &ADistrictHazard::OnHazardEndOverlap);
+	// Hazards do not move
+	if (UNeonSpatialGridSubsystem* Grid = GetWorld()->GetSubsystem<UNeonSpatialGridSubsystem>())
+	{
+		Grid->Register(this, ENeonSpatialCategory::Hazard, true);
+	}
 
 	// Setup visual effects
 	CreateHazardEffects();
@@ -41,88 +43,60 @@ void ADistrictHazard::BeginPlay()
 		EffectRadius);
 }
 
+void ADistrictHazard::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UNeonSpatialGridSubsystem* Grid = GetWorld()->GetSubsystem<UNeonSpatialGridSubsystem>())
+	{
+		Grid->Unregister(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void ADistrictHazard::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	if (!bIsActive)
+	UNeonSpatialGridSubsystem* Grid = GetWorld()->GetSubsystem<UNeonSpatialGridSubsystem>();
+	if (!bIsActive || !Grid)
 	{
 		return;
 	}
 
-	// Apply damage to overlapping actors
-	TArray<AActor*> OverlappingActors;
-	HazardVolume->GetOverlappingActors(OverlappingActors);
+	// Players and enemies within the radius; only they are registered as characters
+	TArray<AActor*> ActorsInside;
+	Grid->QueryRadius(GetActorLocation(), EffectRadius, ENeonSpatialCategory::Characters, ActorsInside);
 
-	for (AActor* Actor : OverlappingActors)
+	for (auto It = LastDamageTime.CreateIterator(); It; ++It)
 	{
-		if (!Actor)
-		{
-			continue;
-		}
-
-		// Check if we should damage this actor
-		bool bShouldDamage = false;
-
-		// Damage player
-		if (Cast<ANeonCharacter>(Actor))
-		{
-			bShouldDamage = true;
-		}
-
-		// Damage enemies
-		if (Cast<ANeonEnemy>(Actor))
+		if (!ActorsInside.Contains(It.Key()))
 		{
-			bShouldDamage = true;
+			OnActorLeft(It.Key());
+			It.RemoveCurrent();
 		}
+	}
 
-		if (bShouldDamage)
+	for (AActor* Actor : ActorsInside)
+	{
+		if (!LastDamageTime.Contains(Actor))
 		{
-			ApplyHazardDamage(Actor);
+			OnActorEntered(Actor);
 		}
+		ApplyHazardDamage(Actor);
 	}
 }
 
-void ADistrictHazard::OnHazardBeginOverlap(
-	UPrimitiveComponent* OverlappedComponent,
-	AActor* OtherActor,
-	UPrimitiveComponent* OtherComp,
-	int32 OtherBodyIndex,
-	bool bFromSweep,
-	const FHitResult& SweepResult)
+void ADistrictHazard::OnActorEntered(AActor* Actor)
 {
-	if (!OtherActor || !bIsActive)
-	{
-		return;
-	}
-
-	// Only interact with characters
-	if (!Cast<ANeonCharacter>(OtherActor) && !Cast<ANeonEnemy>(OtherActor))
-	{
-		return;
-	}
-
 	UE_LOG(LogTemp, Log, TEXT("Actor %s entered %s hazard"),
-		*OtherActor->GetName(),
+		*Actor->GetName(),
 		*GetHazardTypeName());
 }
 
-void ADistrictHazard::OnHazardEndOverlap(
-	UPrimitiveComponent* OverlappedComponent,
-	AActor* OtherActor,
-	UPrimitiveComponent* OtherComp,
-	int32 OtherBodyIndex)
+void ADistrictHazard::OnActorLeft(AActor* Actor)
 {
-	if (!OtherActor)
-	{
-		return;
-	}
-
-	// Remove damage tracking for this actor
-	LastDamageTime.Remove(OtherActor);
-
 	UE_LOG(LogTemp, Log, TEXT("Actor %s left %s hazard"),
-		*OtherActor->GetName(),
+		Actor ? *Actor->GetName() : TEXT("(destroyed)"),
 		*GetHazardTypeName());
 }
 
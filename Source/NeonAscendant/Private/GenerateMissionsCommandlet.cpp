@@ -0,0 +1,344 @@
+#include "GenerateMissionsCommandlet.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "MissionBriefCode.h"
+#include "MissionCatalog.h"
+#include "MissionData.h"
+#include "MissionGenerator.h"
+#include "MissionSpace.h"
+
+namespace
+{
+    constexpr int32 DefaultChunkSize = 64 * 1024;
+    constexpr int32 SlicesPerChunk = 32;
+
+    enum class EOutputFormat : uint8
+    {
+        NDJson,
+        Csv
+    };
+
+    using FFieldBytes = TArray<uint8>;
+
+    void AppendLiteral(TArray<uint8>& Out, const ANSICHAR* Literal)
+    {
+        Out.Append(reinterpret_cast<const uint8*>(Literal), FCStringAnsi::Strlen(Literal));
+    }
+
+    void AppendInteger(TArray<uint8>& Out, int64 Value)
+    {
+        ANSICHAR Digits[24];
+        int32 NumDigits = 0;
+        uint64 Remaining = static_cast<uint64>(Value);
+        do
+        {
+            Digits[NumDigits++] = static_cast<ANSICHAR>('0' + Remaining % 10);
+            Remaining /= 10;
+        }
+        while (Remaining > 0);
+
+        while (NumDigits > 0)
+        {
+            Out.Add(static_cast<uint8>(Digits[--NumDigits]));
+        }
+    }
+
+    // JSON string literal per RFC 8259: quote, backslash and every control character are escaped,
+    // everything else is written as is.
+    FString MakeJsonString(const FString& Value)
+    {
+        FString Escaped;
+        Escaped.Reserve(Value.Len() + 2);
+        Escaped.AppendChar(TEXT('"'));
+
+        for (const TCHAR Character : Value)
+        {
+            switch (Character)
+            {
+            case TEXT('"'):  Escaped += TEXT("\\\""); break;
+            case TEXT('\\'): Escaped += TEXT("\\\\"); break;
+            case TEXT('\b'): Escaped += TEXT("\\b"); break;
+            case TEXT('\f'): Escaped += TEXT("\\f"); break;
+            case TEXT('\n'): Escaped += TEXT("\\n"); break;
+            case TEXT('\r'): Escaped += TEXT("\\r"); break;
+            case TEXT('\t'): Escaped += TEXT("\\t"); break;
+            default:
+                if (static_cast<uint32>(Character) < 0x20)
+                {
+                    Escaped += FString::Printf(TEXT("\\u%04x"), static_cast<uint32>(Character));
+                }
+                else
+                {
+                    Escaped.AppendChar(Character);
+                }
+                break;
+            }
+        }
+
+        Escaped.AppendChar(TEXT('"'));
+        return Escaped;
+    }
+
+    // Quoted, escaped UTF-8 form of a catalog string, ready to append to a record.
+    FFieldBytes MakeField(const FString& Value, EOutputFormat Format)
+    {
+        FString Escaped;
+        if (Format == EOutputFormat::NDJson)
+        {
+            Escaped = MakeJsonString(Value);
+        }
+        else
+        {
+            // RFC 4180: fields with separators, quotes or line breaks are quoted, quotes doubled
+            const bool bNeedsQuotes = Value.Contains(TEXT(",")) || Value.Contains(TEXT("\"")) || Value.Contains(TEXT("\n")) || Value.Contains(TEXT("\r"));
+            Escaped = bNeedsQuotes ? TEXT("\"") + Value.Replace(TEXT("\""), TEXT("\"\"")) + TEXT("\"") : Value;
+        }
+
+        FTCHARToUTF8 Utf8(*Escaped);
+        return FFieldBytes(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+    }
+
+    template <typename EntryType>
+    TArray<FFieldBytes> MakeNameFields(const TArray<EntryType>& Entries, EOutputFormat Format)
+    {
+        TArray<FFieldBytes> Fields;
+        for (const EntryType& Entry : Entries)
+        {
+            Fields.Add(MakeField(Entry.Name, Format));
+        }
+        return Fields;
+    }
+
+    // Every catalog string a record can contain, escaped once up front so formatting a brief is
+    // only memory copies.
+    struct FEncodedCatalog
+    {
+        TArray<FFieldBytes> Districts;
+        TArray<FFieldBytes> Factions;
+        TArray<FFieldBytes> Archetypes;
+        TArray<TArray<FFieldBytes>> Abilities;   // Per archetype
+        TArray<FFieldBytes> Weapons;
+        TArray<FFieldBytes> Implants;
+        TArray<FFieldBytes> Complications;
+        TArray<FFieldBytes> ExtractionConditions;
+
+        explicit FEncodedCatalog(EOutputFormat Format)
+        {
+            Districts = MakeNameFields(NeonAscendantData::GetDistricts(), Format);
+            Factions = MakeNameFields(NeonAscendantData::GetFactions(), Format);
+            Archetypes = MakeNameFields(NeonAscendantData::GetArchetypes(), Format);
+            for (const FAscendantArchetype& Archetype : NeonAscendantData::GetArchetypes())
+            {
+                Abilities.Add(MakeNameFields(Archetype.SignatureAbilities, Format));
+            }
+            Weapons = MakeNameFields(NeonAscendantData::GetWeapons(), Format);
+            Implants = MakeNameFields(NeonAscendantData::GetImplants(), Format);
+            for (const FAscendantComplication& Complication : NeonAscendantData::GetComplications())
+            {
+                Complications.Add(MakeField(Complication.Description, Format));
+            }
+            for (const FString& Condition : NeonAscendantData::GetExtractionConditions())
+            {
+                ExtractionConditions.Add(MakeField(Condition, Format));
+            }
+        }
+    };
+
+    void AppendShareCode(TArray<uint8>& Out, const FMissionBriefHandle& Handle)
+    {
+        uint64 Code = 0;
+        MissionBriefCode::Encode(Handle, Code);
+
+        const FString ShareCode = MissionBriefCode::ToShareString(Code);
+        for (const TCHAR Character : ShareCode)
+        {
+            Out.Add(static_cast<uint8>(Character));
+        }
+    }
+
+    void AppendRecord(TArray<uint8>& Out, const FEncodedCatalog& Catalog, EOutputFormat Format, int64 Index, const FMissionBriefHandle& Handle)
+    {
+        if (Format == EOutputFormat::NDJson)
+        {
+            AppendLiteral(Out, "{\"Index\":");
+            AppendInteger(Out, Index);
+            AppendLiteral(Out, ",\"Code\":\"");
+            AppendShareCode(Out, Handle);
+            AppendLiteral(Out, "\",\"District\":");
+            Out.Append(Catalog.Districts[Handle.DistrictIndex]);
+            AppendLiteral(Out, ",\"Opposition\":");
+            Out.Append(Catalog.Factions[Handle.FactionIndex]);
+            AppendLiteral(Out, ",\"Archetype\":");
+            Out.Append(Catalog.Archetypes[Handle.ArchetypeIndex]);
+            AppendLiteral(Out, ",\"FeaturedAbility\":");
+            Out.Append(Catalog.Abilities[Handle.ArchetypeIndex][Handle.AbilityIndex]);
+            AppendLiteral(Out, ",\"PrimaryWeapon\":");
+            Out.Append(Catalog.Weapons[Handle.WeaponIndex]);
+            AppendLiteral(Out, ",\"BackupImplant\":");
+            Out.Append(Catalog.Implants[Handle.ImplantIndex]);
+            AppendLiteral(Out, ",\"Complication\":");
+            Out.Append(Catalog.Complications[Handle.ComplicationIndex]);
+            AppendLiteral(Out, ",\"ExtractionCondition\":");
+            Out.Append(Catalog.ExtractionConditions[Handle.ExtractionIndex]);
+            AppendLiteral(Out, "}\n");
+            return;
+        }
+
+        const FFieldBytes* Fields[] = {
+            &Catalog.Districts[Handle.DistrictIndex],
+            &Catalog.Factions[Handle.FactionIndex],
+            &Catalog.Archetypes[Handle.ArchetypeIndex],
+            &Catalog.Abilities[Handle.ArchetypeIndex][Handle.AbilityIndex],
+            &Catalog.Weapons[Handle.WeaponIndex],
+            &Catalog.Implants[Handle.ImplantIndex],
+            &Catalog.Complications[Handle.ComplicationIndex],
+            &Catalog.ExtractionConditions[Handle.ExtractionIndex]
+        };
+
+        AppendInteger(Out, Index);
+        Out.Add(',');
+        AppendShareCode(Out, Handle);
+        for (const FFieldBytes* Field : Fields)
+        {
+            Out.Add(',');
+            Out.Append(*Field);
+        }
+        Out.Add('\n');
+    }
+}
+
+UGenerateMissionsCommandlet::UGenerateMissionsCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UGenerateMissionsCommandlet::Main(const FString& Params)
+{
+    int32 Seed = 0;
+    int64 Count = 0;
+    int64 StartIndex = 0;
+    int32 ChunkSize = DefaultChunkSize;
+    FString OutputPath;
+    FString FormatName = TEXT("ndjson");
+
+    if (!FParse::Value(*Params, TEXT("Seed="), Seed) || !FParse::Value(*Params, TEXT("Count="), Count) || !FParse::Value(*Params, TEXT("Output="), OutputPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("GenerateMissions requires -Seed=, -Count= and -Output="));
+        return 1;
+    }
+
+    FParse::Value(*Params, TEXT("StartIndex="), StartIndex);
+    FParse::Value(*Params, TEXT("ChunkSize="), ChunkSize);
+    FParse::Value(*Params, TEXT("Format="), FormatName);
+    const bool bRotation = FParse::Param(*Params, TEXT("Rotation"));
+    ChunkSize = FMath::Max(SlicesPerChunk, ChunkSize);
+
+    EOutputFormat Format;
+    if (FormatName == TEXT("ndjson"))
+    {
+        Format = EOutputFormat::NDJson;
+    }
+    else if (FormatName == TEXT("csv"))
+    {
+        Format = EOutputFormat::Csv;
+    }
+    else
+    {
+        UE_LOG(LogTemp, Error, TEXT("GenerateMissions: unknown -Format=%s (expected ndjson or csv)"), *FormatName);
+        return 1;
+    }
+
+    if (Count <= 0 || StartIndex < 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("GenerateMissions: -Count must be positive and -StartIndex non-negative"));
+        return 1;
+    }
+
+    if (!FMissionCatalog::Get().IsLoaded())
+    {
+        UE_LOG(LogTemp, Error, TEXT("GenerateMissions: %s"), *FMissionCatalog::Get().GetLoadError());
+        return 1;
+    }
+
+    TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*OutputPath));
+    if (!Writer)
+    {
+        UE_LOG(LogTemp, Error, TEXT("GenerateMissions: could not open %s for writing"), *OutputPath);
+        return 1;
+    }
+
+    const FEncodedCatalog Catalog(Format);
+
+    if (Format == EOutputFormat::Csv)
+    {
+        TArray<uint8> Header;
+        AppendLiteral(Header, "Index,Code,District,Opposition,Archetype,FeaturedAbility,PrimaryWeapon,BackupImplant,Complication,ExtractionCondition\n");
+        Writer->Serialize(Header.GetData(), Header.Num());
+    }
+
+    // Slice buffers are reused for every chunk, so memory stays at roughly one chunk of text
+    TArray<TArray<uint8>> SliceBuffers;
+    SliceBuffers.SetNum(SlicesPerChunk);
+
+    const double StartTime = FPlatformTime::Seconds();
+    double LastProgressTime = StartTime;
+    int64 BytesWritten = 0;
+
+    for (int64 ChunkStart = 0; ChunkStart < Count; ChunkStart += ChunkSize)
+    {
+        const int64 ChunkCount = FMath::Min<int64>(ChunkSize, Count - ChunkStart);
+        const int64 SliceSize = FMath::DivideAndRoundUp<int64>(ChunkCount, SlicesPerChunk);
+
+        ParallelFor(TEXT("GenerateMissionsCommandlet"), SlicesPerChunk, 1, [&](int32 Slice)
+        {
+            TArray<uint8>& Buffer = SliceBuffers[Slice];
+            Buffer.Reset();
+
+            const int64 SliceBegin = FMath::Min(ChunkCount, Slice * SliceSize);
+            const int64 SliceEnd = FMath::Min(ChunkCount, SliceBegin + SliceSize);
+            for (int64 Offset = SliceBegin; Offset < SliceEnd; ++Offset)
+            {
+                const int64 Index = StartIndex + ChunkStart + Offset;
+                const FMissionBriefHandle Handle = bRotation
+                    ? MissionSpace::GetRotationBrief(Seed, Index)
+                    : UMissionGenerator::GenerateMissionBriefHandleAt(Seed, Index);
+
+                AppendRecord(Buffer, Catalog, Format, Index, Handle);
+            }
+        });
+
+        for (const TArray<uint8>& Buffer : SliceBuffers)
+        {
+            Writer->Serialize(const_cast<uint8*>(Buffer.GetData()), Buffer.Num());
+            BytesWritten += Buffer.Num();
+        }
+
+        if (Writer->IsError())
+        {
+            UE_LOG(LogTemp, Error, TEXT("GenerateMissions: write to %s failed"), *OutputPath);
+            return 1;
+        }
+
+        const double Now = FPlatformTime::Seconds();
+        if (Now - LastProgressTime > 5.0)
+        {
+            LastProgressTime = Now;
+            UE_LOG(LogTemp, Display, TEXT("GenerateMissions: %lld / %lld briefs (%.1f M/s)"),
+                ChunkStart + ChunkCount, Count, (ChunkStart + ChunkCount) / (Now - StartTime) / 1e6);
+        }
+    }
+
+    if (!Writer->Close())
+    {
+        UE_LOG(LogTemp, Error, TEXT("GenerateMissions: closing %s failed"), *OutputPath);
+        return 1;
+    }
+
+    const double Seconds = FPlatformTime::Seconds() - StartTime;
+    UE_LOG(LogTemp, Display, TEXT("GenerateMissions: wrote %lld briefs (%lld bytes) to %s in %.2f s"), Count, BytesWritten, *OutputPath, Seconds);
+    return 0;
+}
@@ -0,0 +1,746 @@
+#include "MissionBenchmarkCommandlet.h"
+
+#include "MissionBriefCode.h"
+#include "MissionCatalog.h"
+#include "MissionData.h"
+#include "MissionDifficulty.h"
+#include "MissionGenerator.h"
+#include "MissionLayout.h"
+#include "MissionLootSubsystem.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonWriter.h"
+#include "Tasks/Task.h"
+
+namespace
+{
+    constexpr int32 DefaultBenchmarkCount = 1000 * 1000;
+    constexpr int32 DefaultIterations = 5;
+    constexpr int32 BenchmarkSeed = 1337;
+    const int32 BatchSizes[] = { 1, 16, 256, 4096, 65536 };
+    // Layouts take far longer than briefs; -Count= is capped to this for the Layouts group
+    constexpr int32 MaxLayoutCount = 1024;
+    // Likewise for the Difficulty group; each estimate simulates thousands of fights
+    constexpr int32 MaxDifficultyCount = 256;
+    // Distinct briefs cycled through by the MissionStart measurements
+    constexpr int32 MaxMissionStartHandles = 4096;
+    constexpr int32 BenchmarkSquadSize = 4;
+
+    struct FBenchmarkResult
+    {
+        FString Name;
+        int64 ItemsPerIteration = 0;
+        double WarmUpNsPerItem = 0.0;
+        double WarmUpAllocationsPerItem = 0.0;
+        double SteadyNsPerItem = 0.0;       // Median over the steady-state iterations
+        double SteadyMinNsPerItem = 0.0;
+        double SteadyAllocationsPerItem = 0.0;
+        double BytesPerItem = 0.0;          // Retained size of one result, heap included
+    };
+
+    // Heap allocations made by any thread so far. Only the non-shipping allocators count calls.
+    uint64 GetAllocationCount()
+    {
+#if !UE_BUILD_SHIPPING
+        return FMalloc::TotalMallocCalls.load(std::memory_order_relaxed) + FMalloc::TotalReallocCalls.load(std::memory_order_relaxed);
+#else
+        return 0;
+#endif
+    }
+
+    SIZE_T GetHeapBytes(const FString& Value)
+    {
+        return Value.GetAllocatedSize();
+    }
+
+    SIZE_T GetHeapBytes(const TArray<FString>& Values)
+    {
+        SIZE_T Bytes = Values.GetAllocatedSize();
+        for (const FString& Value : Values)
+        {
+            Bytes += GetHeapBytes(Value);
+        }
+        return Bytes;
+    }
+
+    SIZE_T GetHeapBytes(const FAscendantAbility& Ability)
+    {
+        return GetHeapBytes(Ability.Name) + GetHeapBytes(Ability.Description) + GetHeapBytes(Ability.DamageType);
+    }
+
+    SIZE_T GetBriefBytes(const FMissionBrief& Brief)
+    {
+        SIZE_T Bytes = sizeof(FMissionBrief);
+
+        Bytes += GetHeapBytes(Brief.District.Name) + GetHeapBytes(Brief.District.Description)
+            + GetHeapBytes(Brief.District.Hazards) + GetHeapBytes(Brief.District.EnemyProfiles);
+        Bytes += GetHeapBytes(Brief.Opposition.Name) + GetHeapBytes(Brief.Opposition.Philosophy)
+            + GetHeapBytes(Brief.Opposition.SignatureTactics) + GetHeapBytes(Brief.Opposition.OperatingDistricts);
+        Bytes += GetHeapBytes(Brief.Archetype.Name) + GetHeapBytes(Brief.Archetype.Role) + GetHeapBytes(Brief.Archetype.Signature)
+            + Brief.Archetype.SignatureAbilities.GetAllocatedSize();
+        for (const FAscendantAbility& Ability : Brief.Archetype.SignatureAbilities)
+        {
+            Bytes += GetHeapBytes(Ability);
+        }
+        Bytes += GetHeapBytes(Brief.PrimaryWeapon.Name) + GetHeapBytes(Brief.PrimaryWeapon.Category)
+            + GetHeapBytes(Brief.PrimaryWeapon.Description) + GetHeapBytes(Brief.PrimaryWeapon.DamageProfile);
+        Bytes += GetHeapBytes(Brief.BackupImplant.Name) + GetHeapBytes(Brief.BackupImplant.Slot) + GetHeapBytes(Brief.BackupImplant.Effects);
+        Bytes += GetHeapBytes(Brief.FeaturedAbility);
+        Bytes += GetHeapBytes(Brief.Complication) + GetHeapBytes(Brief.ExtractionCondition);
+
+        return Bytes;
+    }
+
+    double GetMedian(TArray<double> Samples)
+    {
+        Samples.Sort();
+        const int32 Middle = Samples.Num() / 2;
+        return Samples.Num() % 2 == 1 ? Samples[Middle] : 0.5 * (Samples[Middle - 1] + Samples[Middle]);
+    }
+
+    // Runs Body once as warm-up and Iterations more times for the steady-state numbers. Body
+    // processes ItemsPerIteration items per call.
+    template <typename BodyType>
+    FBenchmarkResult Measure(const FString& Name, int64 ItemsPerIteration, int32 Iterations, BodyType&& Body)
+    {
+        FBenchmarkResult Result;
+        Result.Name = Name;
+        Result.ItemsPerIteration = ItemsPerIteration;
+
+        TArray<double> SteadySamples;
+        uint64 SteadyAllocations = 0;
+
+        for (int32 Iteration = 0; Iteration <= Iterations; ++Iteration)
+        {
+            const uint64 AllocationsBefore = GetAllocationCount();
+            const double Start = FPlatformTime::Seconds();
+            Body();
+            const double NsPerItem = (FPlatformTime::Seconds() - Start) * 1e9 / ItemsPerIteration;
+            const uint64 Allocations = GetAllocationCount() - AllocationsBefore;
+
+            if (Iteration == 0)
+            {
+                Result.WarmUpNsPerItem = NsPerItem;
+                Result.WarmUpAllocationsPerItem = static_cast<double>(Allocations) / ItemsPerIteration;
+            }
+            else
+            {
+                SteadySamples.Add(NsPerItem);
+                SteadyAllocations += Allocations;
+            }
+        }
+
+        if (SteadySamples.Num() > 0)
+        {
+            Result.SteadyNsPerItem = GetMedian(SteadySamples);
+            Result.SteadyMinNsPerItem = FMath::Min(SteadySamples);
+            Result.SteadyAllocationsPerItem = static_cast<double>(SteadyAllocations) / (static_cast<double>(ItemsPerIteration) * SteadySamples.Num());
+        }
+
+        return Result;
+    }
+
+    void LogResult(const FBenchmarkResult& Result)
+    {
+        UE_LOG(LogTemp, Display, TEXT("MissionBenchmark %-40s warm-up %10.1f ns/item %8.2f allocs/item | steady %10.1f ns/item (min %.1f) %8.2f allocs/item | %.0f bytes/item"),
+            *Result.Name, Result.WarmUpNsPerItem, Result.WarmUpAllocationsPerItem, Result.SteadyNsPerItem, Result.SteadyMinNsPerItem,
+            Result.SteadyAllocationsPerItem, Result.BytesPerItem);
+    }
+
+    UMissionGenerator* MakeGenerator(EMissionRandomMode Mode)
+    {
+        UMissionGenerator* Generator = NewObject<UMissionGenerator>();
+        Generator->SeedGenerator(BenchmarkSeed);
+        Generator->SetRandomMode(Mode);
+        return Generator;
+    }
+
+    const TCHAR* GetModeName(EMissionRandomMode Mode)
+    {
+        return Mode == EMissionRandomMode::CounterBased ? TEXT("CounterBased") : TEXT("Sequential");
+    }
+
+    void RunCatalogBenchmarks(int32 Iterations, TArray<FBenchmarkResult>& OutResults)
+    {
+        // Nothing has touched the catalog yet, so the warm-up iteration is the real first access:
+        // mapping the cooked file and building the index, sampler, layout and the district table
+        // (the other Blueprint tables are only built when a tool asks for them).
+        bool bFirstAccess = true;
+        OutResults.Add(Measure(TEXT("Catalog.FirstAccess"), 1, Iterations, [&bFirstAccess]()
+        {
+            if (bFirstAccess)
+            {
+                bFirstAccess = false;
+                NeonAscendantData::GetDistricts();
+                UMissionGenerator::GetTotalMissionCombinations();
+            }
+            else
+            {
+                NeonAscendantData::RebuildDerivedTables();
+            }
+        }));
+    }
+
+    void RunGenerateBenchmarks(int32 Count, int32 Iterations, TArray<FBenchmarkResult>& OutResults)
+    {
+        for (const EMissionRandomMode Mode : { EMissionRandomMode::Sequential, EMissionRandomMode::CounterBased })
+        {
+            UMissionGenerator* Generator = MakeGenerator(Mode);
+
+            FMissionBrief Brief;
+            FBenchmarkResult& Result = OutResults.Add_GetRef(Measure(FString::Printf(TEXT("GenerateMissionBrief.%s"), GetModeName(Mode)), Count, Iterations,
+                [Generator, Count, &Brief]()
+                {
+                    for (int32 Index = 0; Index < Count; ++Index)
+                    {
+                        Brief = Generator->GenerateMissionBrief();
+                    }
+                }));
+            Result.BytesPerItem = static_cast<double>(GetBriefBytes(Brief));
+
+            FMissionBriefHandle Handle;
+            FBenchmarkResult& HandleResult = OutResults.Add_GetRef(Measure(FString::Printf(TEXT("GenerateMissionBriefHandle.%s"), GetModeName(Mode)), Count, Iterations,
+                [Generator, Count, &Handle]()
+                {
+                    for (int32 Index = 0; Index < Count; ++Index)
+                    {
+                        Handle = Generator->GenerateMissionBriefHandle();
+                    }
+                }));
+            HandleResult.BytesPerItem = sizeof(FMissionBriefHandle);
+        }
+
+        // What a mission start pays per brief: the HUD's one expansion, and the entry names the game
+        // mode keeps for catalog reloads instead of a second expanded copy
+        UMissionGenerator* Generator = MakeGenerator(EMissionRandomMode::CounterBased);
+        TArray<FMissionBriefHandle> Handles;
+        Handles.SetNum(FMath::Min(Count, MaxMissionStartHandles));
+        for (FMissionBriefHandle& Handle : Handles)
+        {
+            Handle = Generator->GenerateMissionBriefHandle();
+        }
+
+        FMissionBrief Expanded;
+        FBenchmarkResult& ExpandResult = OutResults.Add_GetRef(Measure(TEXT("MissionStart.ExpandBrief"), Count, Iterations,
+            [Count, &Handles, &Expanded]()
+            {
+                for (int32 Index = 0; Index < Count; ++Index)
+                {
+                    Expanded = NeonAscendantData::ExpandBrief(Handles[Index % Handles.Num()]);
+                }
+            }));
+        ExpandResult.BytesPerItem = static_cast<double>(GetBriefBytes(Expanded));
+
+        FMissionBriefNames Names;
+        FBenchmarkResult& NamesResult = OutResults.Add_GetRef(Measure(TEXT("MissionStart.BriefNames"), Count, Iterations,
+            [Count, &Handles, &Names]()
+            {
+                for (int32 Index = 0; Index < Count; ++Index)
+                {
+                    Names = NeonAscendantData::GetBriefNames(Handles[Index % Handles.Num()]);
+                }
+            }));
+        NamesResult.BytesPerItem = sizeof(FMissionBriefNames);
+    }
+
+    void RunBatchBenchmarks(int32 Count, int32 Iterations, TArray<FBenchmarkResult>& OutResults)
+    {
+        for (const EMissionRandomMode Mode : { EMissionRandomMode::Sequential, EMissionRandomMode::CounterBased })
+        {
+            UMissionGenerator* Generator = MakeGenerator(Mode);
+
+            for (const int32 BatchSize : BatchSizes)
+            {
+                // Same number of briefs per iteration for every batch size
+                const int32 NumBatches = FMath::Max(1, Count / BatchSize);
+
+                TArray<FMissionBrief> Briefs;
+                FBenchmarkResult& Result = OutResults.Add_GetRef(Measure(FString::Printf(TEXT("GenerateMissionBriefs.%s.%d"), GetModeName(Mode), BatchSize),
+                    static_cast<int64>(NumBatches) * BatchSize, Iterations,
+                    [Generator, NumBatches, BatchSize, &Briefs]()
+                    {
+                        for (int32 Batch = 0; Batch < NumBatches; ++Batch)
+                        {
+                            Generator->GenerateMissionBriefs(BatchSize, Briefs);
+                        }
+                    }));
+
+                double TotalBytes = static_cast<double>(Briefs.GetAllocatedSize() - Briefs.Num() * sizeof(FMissionBrief));
+                for (const FMissionBrief& Brief : Briefs)
+                {
+                    TotalBytes += GetBriefBytes(Brief);
+                }
+                Result.BytesPerItem = TotalBytes / FMath::Max(1, Briefs.Num());
+            }
+        }
+    }
+
+    // Returns false if any code fails to round-trip.
+    bool RunCodeBenchmarks(int32 Count, int32 Iterations, TArray<FBenchmarkResult>& OutResults)
+    {
+        TArray<FMissionBriefHandle> Handles;
+        Handles.SetNumUninitialized(Count);
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            Handles[Index] = UMissionGenerator::GenerateMissionBriefHandleAt(BenchmarkSeed, Index);
+        }
+
+        TArray<uint64> Codes;
+        Codes.SetNumUninitialized(Count);
+
+        FBenchmarkResult& EncodeResult = OutResults.Add_GetRef(Measure(TEXT("MissionBriefCode.Encode"), Count, Iterations, [&Handles, &Codes]()
+        {
+            for (int32 Index = 0; Index < Handles.Num(); ++Index)
+            {
+                MissionBriefCode::Encode(Handles[Index], Codes[Index]);
+            }
+        }));
+        EncodeResult.BytesPerItem = sizeof(uint64);
+
+        int32 Mismatches = 0;
+        FBenchmarkResult& DecodeResult = OutResults.Add_GetRef(Measure(TEXT("MissionBriefCode.Decode"), Count, Iterations, [&Handles, &Codes, &Mismatches]()
+        {
+            Mismatches = 0;
+            for (int32 Index = 0; Index < Codes.Num(); ++Index)
+            {
+                FMissionBriefHandle Decoded;
+                if (MissionBriefCode::Decode(Codes[Index], Decoded) != EMissionBriefCodeResult::Ok || Decoded != Handles[Index])
+                {
+                    ++Mismatches;
+                }
+            }
+        }));
+        DecodeResult.BytesPerItem = sizeof(FMissionBriefHandle);
+
+        if (Mismatches > 0)
+        {
+            UE_LOG(LogTemp, Error, TEXT("MissionBenchmark: %d brief codes did not round-trip"), Mismatches);
+            return false;
+        }
+
+        return true;
+    }
+
+    // One caller of the Streams group: a stream and everything it drew.
+    struct FStreamDraws
+    {
+        uint32 StreamId = 0;
+        TArray<FMissionBriefHandle> Handles;
+    };
+
+    void DrawFromNewStream(FStreamDraws& Draws, int32 Count)
+    {
+        FMissionBriefStream Stream;
+        if (!UMissionGeneratorSingleton::AcquireBriefStream(Stream))
+        {
+            return;
+        }
+
+        Draws.StreamId = Stream.GetStreamId();
+        Draws.Handles.Reset(Count);
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            Draws.Handles.Add(Stream.Next());
+        }
+    }
+
+    // Dedicated OS thread standing in for a matchmaking thread, next to the task-based callers.
+    class FStreamDrawThread : public FRunnable
+    {
+    public:
+        FStreamDrawThread(FStreamDraws& InDraws, int32 InCount)
+            : Draws(InDraws)
+            , Count(InCount)
+        {
+        }
+
+        virtual uint32 Run() override
+        {
+            DrawFromNewStream(Draws, Count);
+            return 0;
+        }
+
+    private:
+        FStreamDraws& Draws;
+        int32 Count;
+    };
+
+    // Many tasks plus a few raw threads acquire brief streams at the same time and draw from them,
+    // against one caller drawing as many briefs for the scaling comparison. That the sequences
+    // stay independent is checked by the NeonAscendant.Mission.BriefStreamConcurrency automation
+    // test; here only running out of stream ids fails the group.
+    bool RunStreamBenchmarks(int32 Count, int32 Iterations, TArray<FBenchmarkResult>& OutResults)
+    {
+        const int32 NumTasks = FMath::Max(8, FTaskGraphInterface::Get().GetNumWorkerThreads() * 4);
+        const int32 NumThreads = 4;
+        const int32 NumCallers = NumTasks + NumThreads;
+        const int32 DrawsPerCaller = FMath::Max(1, Count / NumCallers);
+
+        UMissionGeneratorSingleton::SeedBriefStreams(BenchmarkSeed);
+
+        TArray<FStreamDraws> Draws;
+        Draws.SetNum(NumCallers);
+
+        FBenchmarkResult& Result = OutResults.Add_GetRef(Measure(FString::Printf(TEXT("BriefStream.Concurrent.%d"), NumCallers),
+            static_cast<int64>(DrawsPerCaller) * NumCallers, Iterations, [&Draws, NumTasks, NumThreads, DrawsPerCaller]()
+            {
+                TArray<TUniquePtr<FStreamDrawThread>> Runnables;
+                TArray<TUniquePtr<FRunnableThread>> Threads;
+                for (int32 Thread = 0; Thread < NumThreads; ++Thread)
+                {
+                    Runnables.Add(MakeUnique<FStreamDrawThread>(Draws[NumTasks + Thread], DrawsPerCaller));
+                    Threads.Add(TUniquePtr<FRunnableThread>(FRunnableThread::Create(Runnables.Last().Get(), *FString::Printf(TEXT("MissionStreamBenchmark%d"), Thread))));
+                }
+
+                TArray<UE::Tasks::FTask> Tasks;
+                for (int32 Task = 0; Task < NumTasks; ++Task)
+                {
+                    Tasks.Add(UE::Tasks::Launch(TEXT("MissionStreamBenchmark"), [&Caller = Draws[Task], DrawsPerCaller]()
+                    {
+                        DrawFromNewStream(Caller, DrawsPerCaller);
+                    }));
+                }
+
+                UE::Tasks::Wait(Tasks);
+                for (TUniquePtr<FRunnableThread>& Thread : Threads)
+                {
+                    Thread->WaitForCompletion();
+                }
+            }));
+        Result.BytesPerItem = sizeof(FMissionBriefHandle);
+
+        FMissionBriefHandle Handle;
+        FBenchmarkResult& SerialResult = OutResults.Add_GetRef(Measure(TEXT("BriefStream.Serial"), static_cast<int64>(DrawsPerCaller) * NumCallers, Iterations,
+            [&Handle, DrawsPerCaller, NumCallers]()
+            {
+                FMissionBriefStream Stream = UMissionGeneratorSingleton::GetBriefStream(1);
+                for (int64 Index = 0; Index < static_cast<int64>(DrawsPerCaller) * NumCallers; ++Index)
+                {
+                    Handle = Stream.Next();
+                }
+            }));
+        SerialResult.BytesPerItem = sizeof(FMissionBriefHandle);
+
+        return !Draws.ContainsByPredicate([](const FStreamDraws& Caller) { return Caller.StreamId == 0; });
+    }
+
+    // Flood fill from the player start: every walkable tile and every slot must be reached.
+    bool IsLayoutConnected(const FMissionLayout& Layout)
+    {
+        TBitArray<> Reached(false, Layout.Tiles.Num());
+        TArray<int32> Queue;
+        const FMissionLayoutSlot& Start = Layout.GetSlots(EMissionLayoutSlot::PlayerStart)[0];
+        Queue.Add(Start.Y * Layout.Width + Start.X);
+        Reached[Queue[0]] = true;
+
+        for (int32 Head = 0; Head < Queue.Num(); ++Head)
+        {
+            const int32 X = Queue[Head] % Layout.Width;
+            const int32 Y = Queue[Head] / Layout.Width;
+            for (const FIntPoint& Step : { FIntPoint(-1, 0), FIntPoint(1, 0), FIntPoint(0, -1), FIntPoint(0, 1) })
+            {
+                const int32 NextX = X + Step.X;
+                const int32 NextY = Y + Step.Y;
+                if (Layout.IsWalkable(NextX, NextY) && !Reached[NextY * Layout.Width + NextX])
+                {
+                    Reached[NextY * Layout.Width + NextX] = true;
+                    Queue.Add(NextY * Layout.Width + NextX);
+                }
+            }
+        }
+
+        for (int32 TileIndex = 0; TileIndex < Layout.Tiles.Num(); ++TileIndex)
+        {
+            if (Layout.IsWalkable(TileIndex % Layout.Width, TileIndex / Layout.Width) && !Reached[TileIndex])
+            {
+                return false;
+            }
+        }
+        for (const FMissionLayoutSlot& Slot : Layout.Slots)
+        {
+            if (!Reached[Slot.Y * Layout.Width + Slot.X])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Layouts are generated on the loading screen, one per mission. Sectors are filled on worker
+    // threads; the serial run must produce the same tiles and slots, and every layout must be
+    // connected.
+    bool RunLayoutBenchmarks(int32 Count, int32 Iterations, TArray<FBenchmarkResult>& OutResults)
+    {
+        const int32 NumLayouts = FMath::Min(Count, MaxLayoutCount);
+        TArray<FMissionBriefHandle> Handles;
+        Handles.SetNumUninitialized(NumLayouts);
+        for (int32 Index = 0; Index < NumLayouts; ++Index)
+        {
+            Handles[Index] = UMissionGenerator::GenerateMissionBriefHandleAt(BenchmarkSeed, Index);
+        }
+
+        TArray<FMissionLayout> ParallelLayouts;
+        TArray<FMissionLayout> SerialLayouts;
+        ParallelLayouts.SetNum(NumLayouts);
+        SerialLayouts.SetNum(NumLayouts);
+
+        for (const bool bParallel : { true, false })
+        {
+            FMissionLayoutSettings Settings;
+            Settings.bParallel = bParallel;
+            TArray<FMissionLayout>& Layouts = bParallel ? ParallelLayouts : SerialLayouts;
+
+            FBenchmarkResult& Result = OutResults.Add_GetRef(Measure(bParallel ? TEXT("MissionLayout.Parallel") : TEXT("MissionLayout.Serial"), NumLayouts, Iterations,
+                [&Handles, &Layouts, &Settings]()
+                {
+                    for (int32 Index = 0; Index < Handles.Num(); ++Index)
+                    {
+                        Layouts[Index] = MissionLayout::Generate(Handles[Index], Settings);
+                    }
+                }));
+            Result.BytesPerItem = static_cast<double>(sizeof(FMissionLayout) + Layouts[0].Tiles.GetAllocatedSize()
+                + Layouts[0].SectorKinds.GetAllocatedSize() + Layouts[0].Slots.GetAllocatedSize());
+        }
+
+        for (int32 Index = 0; Index < NumLayouts; ++Index)
+        {
+            const FMissionLayout& Parallel = ParallelLayouts[Index];
+            const FMissionLayout& Serial = SerialLayouts[Index];
+            const bool bSame = Parallel.Seed == Serial.Seed
+                && Parallel.Tiles == Serial.Tiles
+                && Parallel.SectorKinds == Serial.SectorKinds
+                && Parallel.Slots.Num() == Serial.Slots.Num()
+                && FMemory::Memcmp(Parallel.Slots.GetData(), Serial.Slots.GetData(), Parallel.Slots.Num() * sizeof(FMissionLayoutSlot)) == 0
+                && FMemory::Memcmp(Parallel.SlotOffsets, Serial.SlotOffsets, sizeof(Parallel.SlotOffsets)) == 0;
+
+            if (!Parallel.IsValid() || !bSame)
+            {
+                UE_LOG(LogTemp, Error, TEXT("MissionBenchmark: layout %d differs between the parallel and serial runs"), Index);
+                return false;
+            }
+            if (!IsLayoutConnected(Parallel))
+            {
+                UE_LOG(LogTemp, Error, TEXT("MissionBenchmark: layout %d has unreachable tiles or slots"), Index);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // One estimate per mission start, timed as the game mode's task runs it: all workers, default
+    // settings from the native class defaults. Reported per estimate, so ns/item over 1e6 is ms.
+    void RunDifficultyBenchmarks(int32 Count, int32 Iterations, TArray<FBenchmarkResult>& OutResults)
+    {
+        const int32 NumEstimates = FMath::Min(Count, MaxDifficultyCount);
+        TArray<FMissionBriefHandle> Handles;
+        Handles.SetNumUninitialized(NumEstimates);
+        for (int32 Index = 0; Index < NumEstimates; ++Index)
+        {
+            Handles[Index] = UMissionGenerator::GenerateMissionBriefHandleAt(BenchmarkSeed, Index);
+        }
+
+        const FMissionCombatSettings Settings = FMissionCombatSettings::FromClassDefaults();
+        double ScoreSum = 0.0;
+        FBenchmarkResult& Result = OutResults.Add_GetRef(Measure(FString::Printf(TEXT("MissionDifficulty.Estimate.%d"), Settings.Trials), NumEstimates, Iterations,
+            [&Handles, &Settings, &ScoreSum]()
+            {
+                ScoreSum = 0.0;
+                for (const FMissionBriefHandle& Handle : Handles)
+                {
+                    ScoreSum += MissionDifficulty::Estimate(Handle, Settings).Score;
+                }
+            }));
+        Result.BytesPerItem = sizeof(FMissionDifficulty);
+
+        UE_LOG(LogTemp, Display, TEXT("MissionBenchmark: %d difficulty estimates, %.2f ms each, mean score %.1f"),
+            NumEstimates, Result.SteadyNsPerItem / 1e6, ScoreSum / NumEstimates);
+    }
+
+    // A simulated season: Count reward rolls for four-player squads over consecutive briefs, with
+    // every extraction outcome. The parallel batch must match rolling each request in order.
+    bool RunLootBenchmarks(int32 Count, int32 Iterations, TArray<FBenchmarkResult>& OutResults)
+    {
+        FString JsonText;
+        FString Error;
+        FMissionLootTables Tables;
+        if (!FFileHelper::LoadFileToString(JsonText, *FMissionLootTables::GetDefaultPath()) || !Tables.LoadFromJson(JsonText, Error))
+        {
+            UE_LOG(LogTemp, Error, TEXT("MissionBenchmark: could not load %s: %s"), *FMissionLootTables::GetDefaultPath(), *Error);
+            return false;
+        }
+
+        TArray<FMissionLootRequest> Requests;
+        Requests.SetNumUninitialized(Count);
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            const int64 MissionIndex = Index / BenchmarkSquadSize;
+            const EExtractionOutcome Outcome = static_cast<EExtractionOutcome>(MissionIndex % static_cast<int64>(EMissionExtractionOutcome::Count));
+            Requests[Index] = UMissionLootSubsystem::MakeRequest(UMissionGenerator::GenerateMissionBriefHandleAt(BenchmarkSeed, MissionIndex),
+                Outcome, MissionIndex, Index % BenchmarkSquadSize);
+        }
+
+        TArray<FMissionLootDrop> BatchDrops;
+        TArray<int32> BatchOffsets;
+        FBenchmarkResult& BatchResult = OutResults.Add_GetRef(Measure(TEXT("MissionLoot.RollBatch"), Count, Iterations, [&Tables, &Requests, &BatchDrops, &BatchOffsets]()
+        {
+            Tables.RollBatch(BenchmarkSeed, Requests, BatchDrops, BatchOffsets);
+        }));
+        BatchResult.BytesPerItem = static_cast<double>(BatchDrops.Num() * sizeof(FMissionLootDrop)) / Count;
+
+        TArray<FMissionLootDrop> SerialDrops;
+        TArray<int32> SerialOffsets;
+        FBenchmarkResult& SerialResult = OutResults.Add_GetRef(Measure(TEXT("MissionLoot.Roll"), Count, Iterations, [&Tables, &Requests, &SerialDrops, &SerialOffsets]()
+        {
+            SerialDrops.Reset();
+            SerialOffsets.Reset();
+            SerialOffsets.Add(0);
+            for (const FMissionLootRequest& Request : Requests)
+            {
+                Tables.Roll(BenchmarkSeed, Request, SerialDrops);
+                SerialOffsets.Add(SerialDrops.Num());
+            }
+        }));
+        SerialResult.BytesPerItem = BatchResult.BytesPerItem;
+
+        if (BatchOffsets != SerialOffsets || BatchDrops.Num() != SerialDrops.Num()
+            || FMemory::Memcmp(BatchDrops.GetData(), SerialDrops.GetData(), BatchDrops.Num() * sizeof(FMissionLootDrop)) != 0)
+        {
+            UE_LOG(LogTemp, Error, TEXT("MissionBenchmark: batched loot rolls differ from rolling each request in order"));
+            return false;
+        }
+
+        return true;
+    }
+
+    bool WriteResults(const FString& OutputPath, int32 Count, int32 Iterations, bool bPassed, const TArray<FBenchmarkResult>& Results)
+    {
+        FString Json;
+        const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("Count"), Count);
+        Writer->WriteValue(TEXT("Iterations"), Iterations);
+        Writer->WriteValue(TEXT("Seed"), BenchmarkSeed);
+        Writer->WriteValue(TEXT("WorkerThreads"), FTaskGraphInterface::Get().GetNumWorkerThreads());
+        Writer->WriteValue(TEXT("AllocationsCounted"), !UE_BUILD_SHIPPING);
+        Writer->WriteValue(TEXT("Passed"), bPassed);
+
+        Writer->WriteArrayStart(TEXT("Results"));
+        for (const FBenchmarkResult& Result : Results)
+        {
+            Writer->WriteObjectStart();
+            Writer->WriteValue(TEXT("Name"), Result.Name);
+            Writer->WriteValue(TEXT("ItemsPerIteration"), Result.ItemsPerIteration);
+            Writer->WriteObjectStart(TEXT("WarmUp"));
+            Writer->WriteValue(TEXT("NsPerItem"), Result.WarmUpNsPerItem);
+            Writer->WriteValue(TEXT("AllocationsPerItem"), Result.WarmUpAllocationsPerItem);
+            Writer->WriteObjectEnd();
+            Writer->WriteObjectStart(TEXT("Steady"));
+            Writer->WriteValue(TEXT("NsPerItem"), Result.SteadyNsPerItem);
+            Writer->WriteValue(TEXT("MinNsPerItem"), Result.SteadyMinNsPerItem);
+            Writer->WriteValue(TEXT("AllocationsPerItem"), Result.SteadyAllocationsPerItem);
+            Writer->WriteObjectEnd();
+            Writer->WriteValue(TEXT("BytesPerItem"), Result.BytesPerItem);
+            Writer->WriteObjectEnd();
+        }
+        Writer->WriteArrayEnd();
+
+        Writer->WriteObjectEnd();
+        Writer->Close();
+
+        if (!FFileHelper::SaveStringToFile(Json, *OutputPath))
+        {
+            UE_LOG(LogTemp, Error, TEXT("MissionBenchmark: could not write %s"), *OutputPath);
+            return false;
+        }
+
+        UE_LOG(LogTemp, Display, TEXT("MissionBenchmark: results written to %s"), *OutputPath);
+        return true;
+    }
+}
+
+UMissionBenchmarkCommandlet::UMissionBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+int32 UMissionBenchmarkCommandlet::Main(const FString& Params)
+{
+    int32 Count = DefaultBenchmarkCount;
+    int32 Iterations = DefaultIterations;
+    FString GroupList = TEXT("Catalog,Generate,Batches,Codes,Streams,Layouts,Loot,Difficulty");
+    FString OutputPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks/MissionBenchmark.json");
+
+    FParse::Value(*Params, TEXT("Count="), Count);
+    FParse::Value(*Params, TEXT("Iterations="), Iterations);
+    FParse::Value(*Params, TEXT("Groups="), GroupList, false);
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+    Count = FMath::Max(1, Count);
+    Iterations = FMath::Max(1, Iterations);
+
+    TArray<FString> Groups;
+    GroupList.ParseIntoArray(Groups, TEXT(","));
+
+    TArray<FBenchmarkResult> Results;
+    bool bPassed = true;
+
+    // Must run first so it observes the catalog cold
+    if (Groups.Contains(TEXT("Catalog")))
+    {
+        RunCatalogBenchmarks(Iterations, Results);
+    }
+
+    if (!FMissionCatalog::Get().IsLoaded())
+    {
+        UE_LOG(LogTemp, Error, TEXT("MissionBenchmark: %s"), *FMissionCatalog::Get().GetLoadError());
+        return 1;
+    }
+
+    if (Groups.Contains(TEXT("Generate")))
+    {
+        RunGenerateBenchmarks(Count, Iterations, Results);
+    }
+    if (Groups.Contains(TEXT("Batches")))
+    {
+        RunBatchBenchmarks(Count, Iterations, Results);
+    }
+    if (Groups.Contains(TEXT("Codes")))
+    {
+        bPassed &= RunCodeBenchmarks(Count, Iterations, Results);
+    }
+    if (Groups.Contains(TEXT("Streams")))
+    {
+        bPassed &= RunStreamBenchmarks(Count, Iterations, Results);
+    }
+    if (Groups.Contains(TEXT("Layouts")))
+    {
+        bPassed &= RunLayoutBenchmarks(Count, Iterations, Results);
+    }
+    if (Groups.Contains(TEXT("Loot")))
+    {
+        bPassed &= RunLootBenchmarks(Count, Iterations, Results);
+    }
+    if (Groups.Contains(TEXT("Difficulty")))
+    {
+        RunDifficultyBenchmarks(Count, Iterations, Results);
+    }
+
+    for (const FBenchmarkResult& Result : Results)
+    {
+        LogResult(Result);
+    }
+
+    if (!WriteResults(OutputPath, Count, Iterations, bPassed, Results))
+    {
+        return 1;
+    }
+
+    return bPassed ? 0 : 1;
+}
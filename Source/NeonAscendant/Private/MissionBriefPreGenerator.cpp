@@ -0,0 +1,87 @@
+#include "MissionBriefPreGenerator.h"
+
+#include "MissionGenerator.h"
+
+FMissionBriefPreGenerator::FMissionBriefPreGenerator(int32 InSeed, int32 Capacity, int32 InRefillThreshold)
+    : Buffer(Capacity)
+    , Seed(InSeed)
+    , RefillThreshold(FMath::Clamp(InRefillThreshold, 0, Buffer.Capacity() - 1))
+{
+}
+
+FMissionBriefPreGenerator::~FMissionBriefPreGenerator()
+{
+    WaitForRefill();
+}
+
+FMissionBriefHandle FMissionBriefPreGenerator::Pop()
+{
+    const int64 Index = NextConsumerIndex.load(std::memory_order_relaxed);
+
+    FMissionBriefHandle Handle;
+    bool bFound = false;
+    FMissionBriefRingBuffer::FSlot Slot;
+    while (Buffer.TryPop(Slot))
+    {
+        // Briefs below Index were already generated synchronously on a stall
+        if (Slot.Index == Index)
+        {
+            Handle = Slot.Handle;
+            bFound = true;
+            break;
+        }
+    }
+
+    if (!bFound)
+    {
+        StallCount.fetch_add(1, std::memory_order_relaxed);
+        Handle = UMissionGenerator::GenerateMissionBriefHandleAt(Seed, Index);
+    }
+    NextConsumerIndex.store(Index + 1, std::memory_order_relaxed);
+
+    if (Buffer.Num() <= RefillThreshold)
+    {
+        RequestRefill();
+    }
+
+    return Handle;
+}
+
+void FMissionBriefPreGenerator::RequestRefill()
+{
+    check(IsInGameThread());
+
+    if (bRefillInFlight.exchange(true, std::memory_order_acquire))
+    {
+        return;
+    }
+
+    RefillTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this]()
+    {
+        Refill();
+    }, UE::Tasks::ETaskPriority::BackgroundNormal);
+}
+
+void FMissionBriefPreGenerator::WaitForRefill()
+{
+    if (RefillTask.IsValid())
+    {
+        RefillTask.Wait();
+    }
+}
+
+void FMissionBriefPreGenerator::Refill()
+{
+    NextProducerIndex = FMath::Max(NextProducerIndex, NextConsumerIndex.load(std::memory_order_relaxed));
+
+    while (Buffer.Num() < Buffer.Capacity())
+    {
+        if (!Buffer.TryPush({UMissionGenerator::GenerateMissionBriefHandleAt(Seed, NextProducerIndex), NextProducerIndex}))
+        {
+            break;
+        }
+        ++NextProducerIndex;
+    }
+
+    bRefillInFlight.store(false, std::memory_order_release);
+}
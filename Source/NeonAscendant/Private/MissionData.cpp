@@ -1,68 +1,269 @@
 #include "MissionData.h"
 
-#include <initializer_list>
+#include "GameplayTagsManager.h"
+#include "MissionCatalog.h"
+#include "MissionCatalogIndex.h"
+#include "NeonMissionCore.h"
+
+using namespace MissionCatalogFormat;
 
 namespace
 {
-    FAscendantAbility MakeAbility(const TCHAR* Name, const TCHAR* Description, int32 Cooldown, bool bHasCooldown, const TCHAR* DamageType)
+    // Catalog entry <-> gameplay tag, in catalog order
+    struct FTagTable
+    {
+        TArray<FGameplayTag> Tags;
+        TMap<FGameplayTag, int32> Indices;
+
+        void Add(const FGameplayTag& Tag)
+        {
+            if (Tag.IsValid())
+            {
+                Indices.FindOrAdd(Tag, Tags.Num());
+            }
+
+            Tags.Add(Tag);
+        }
+
+        int32 Find(const FGameplayTag& Tag) const
+        {
+            const int32* Index = Indices.Find(Tag);
+            return Index ? *Index : INDEX_NONE;
+        }
+
+        FGameplayTag Get(int32 Index) const { return Tags.IsValidIndex(Index) ? Tags[Index] : FGameplayTag(); }
+    };
+
+    // Blueprint-facing copies of whole catalog sections, for tools that walk every entry. Each
+    // section is built the first time it is asked for; per-handle lookups never touch these.
+    struct FMissionDataTables
+    {
+        TOptional<TArray<FAscendantArchetype>> Archetypes;
+        TOptional<TArray<FAscendantWeapon>> Weapons;
+        TOptional<TArray<FAscendantImplant>> Implants;
+        TOptional<TArray<FAscendantDistrict>> Districts;
+        TOptional<TArray<FAscendantFaction>> Factions;
+        TOptional<TArray<FAscendantComplication>> Complications;
+        TOptional<TArray<FString>> ExtractionConditions;
+
+        TOptional<FTagTable> DistrictTags;
+        TOptional<FTagTable> FactionTags;
+        TOptional<FTagTable> ComplicationTags;
+    };
+
+    FString ToString(const FMissionCatalog& Catalog, uint32 Offset)
+    {
+        return FString(UTF8_TO_TCHAR(Catalog.GetString(Offset)));
+    }
+
+    TArray<FString> ToStringArray(const FMissionCatalog& Catalog, const FRange& Range)
+    {
+        TArray<FString> Strings;
+        for (const uint32 Offset : Catalog.GetList(Range))
+        {
+            Strings.Add(ToString(Catalog, Offset));
+        }
+        return Strings;
+    }
+
+    // Tags must already be declared (DefaultEngine.ini); unknown names map to no tag.
+    FGameplayTag ResolveTag(const FMissionCatalog& Catalog, uint32 TagOffset)
+    {
+        const FString TagName = ToString(Catalog, TagOffset);
+        if (TagName.IsEmpty())
+        {
+            return FGameplayTag();
+        }
+
+        const FGameplayTag Tag = UGameplayTagsManager::Get().RequestGameplayTag(FName(*TagName), false);
+        if (!Tag.IsValid())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("NeonAscendantData - Catalog references undeclared gameplay tag '%s'"), *TagName);
+        }
+
+        return Tag;
+    }
+
+    bool IsValidIndex(const FMissionCatalog& Catalog, ESection Section, int32 Index)
+    {
+        return Index >= 0 && Index < Catalog.Num(Section);
+    }
+
+    FName ToName(const FMissionCatalog& Catalog, uint32 Offset)
+    {
+        return FName(UTF8_TO_TCHAR(Catalog.GetString(Offset)));
+    }
+
+    // Name of section entry Index, or NAME_None when the index is out of range
+    template <typename RecordType>
+    FName GetEntryName(ESection Section, int32 Index, const RecordType& (FMissionCatalog::*GetRecord)(int32) const)
+    {
+        const FMissionCatalog& Catalog = FMissionCatalog::Get();
+        return IsValidIndex(Catalog, Section, Index) ? ToName(Catalog, (Catalog.*GetRecord)(Index).Name) : NAME_None;
+    }
+
+    // Entry builders. Callers check the index against the section first.
+    FAscendantAbility MakeAbility(const FMissionCatalog& Catalog, int32 Index)
     {
+        const FAbilityRecord& Record = Catalog.GetAbility(Index);
+
         FAscendantAbility Ability;
-        Ability.Name = Name;
-        Ability.Description = Description;
-        Ability.CooldownSeconds = Cooldown;
-        Ability.bHasCooldown = bHasCooldown;
-        Ability.DamageType = DamageType;
+        Ability.Name = ToString(Catalog, Record.Name);
+        Ability.Description = ToString(Catalog, Record.Description);
+        Ability.CooldownSeconds = Record.CooldownSeconds;
+        Ability.bHasCooldown = Record.bHasCooldown != 0;
+        Ability.DamageType = ToString(Catalog, Record.DamageType);
         return Ability;
     }
 
-    FAscendantWeapon MakeWeapon(const TCHAR* Name, const TCHAR* Category, const TCHAR* Description, const TCHAR* DamageProfile)
+    FAscendantArchetype MakeArchetype(const FMissionCatalog& Catalog, int32 Index)
+    {
+        const FArchetypeRecord& Record = Catalog.GetArchetype(Index);
+
+        FAscendantArchetype Archetype;
+        Archetype.Name = ToString(Catalog, Record.Name);
+        Archetype.Role = ToString(Catalog, Record.Role);
+        Archetype.Signature = ToString(Catalog, Record.Signature);
+
+        for (const uint32 AbilityIndex : Catalog.GetList(Record.Abilities))
+        {
+            if (IsValidIndex(Catalog, ESection::Abilities, static_cast<int32>(AbilityIndex)))
+            {
+                Archetype.SignatureAbilities.Add(MakeAbility(Catalog, static_cast<int32>(AbilityIndex)));
+            }
+        }
+        return Archetype;
+    }
+
+    FAscendantWeapon MakeWeapon(const FMissionCatalog& Catalog, int32 Index)
     {
+        const FWeaponRecord& Record = Catalog.GetWeapon(Index);
+
         FAscendantWeapon Weapon;
-        Weapon.Name = Name;
-        Weapon.Category = Category;
-        Weapon.Description = Description;
-        Weapon.DamageProfile = DamageProfile;
+        Weapon.Name = ToString(Catalog, Record.Name);
+        Weapon.Category = ToString(Catalog, Record.Category);
+        Weapon.Description = ToString(Catalog, Record.Description);
+        Weapon.DamageProfile = ToString(Catalog, Record.DamageProfile);
         return Weapon;
     }
 
-    FAscendantImplant MakeImplant(const TCHAR* Name, const TCHAR* Slot, std::initializer_list<const TCHAR*> Effects)
+    FAscendantImplant MakeImplant(const FMissionCatalog& Catalog, int32 Index)
     {
+        const FImplantRecord& Record = Catalog.GetImplant(Index);
+
         FAscendantImplant Implant;
-        Implant.Name = Name;
-        Implant.Slot = Slot;
-        for (const TCHAR* Effect : Effects)
-        {
-            Implant.Effects.Add(Effect);
-        }
+        Implant.Name = ToString(Catalog, Record.Name);
+        Implant.Slot = ToString(Catalog, Record.Slot);
+        Implant.Effects = ToStringArray(Catalog, Record.Effects);
         return Implant;
     }
 
-    FAscendantDistrict MakeDistrict(const TCHAR* Name, const TCHAR* Description, std::initializer_list<const TCHAR*> Hazards, std::initializer_list<const TCHAR*> EnemyProfiles)
+    FAscendantDistrict MakeDistrict(const FMissionCatalog& Catalog, int32 Index)
     {
+        const FDistrictRecord& Record = Catalog.GetDistrict(Index);
+
         FAscendantDistrict District;
-        District.Name = Name;
-        District.Description = Description;
-        for (const TCHAR* Hazard : Hazards)
-        {
-            District.Hazards.Add(Hazard);
-        }
-        for (const TCHAR* Profile : EnemyProfiles)
-        {
-            District.EnemyProfiles.Add(Profile);
-        }
+        District.Name = ToString(Catalog, Record.Name);
+        District.Description = ToString(Catalog, Record.Description);
+        District.Hazards = ToStringArray(Catalog, Record.Hazards);
+        District.EnemyProfiles = ToStringArray(Catalog, Record.EnemyProfiles);
+        District.Weight = Record.Weight;
         return District;
     }
 
-    FAscendantFaction MakeFaction(const TCHAR* Name, const TCHAR* Philosophy, std::initializer_list<const TCHAR*> Tactics)
+    FAscendantFaction MakeFaction(const FMissionCatalog& Catalog, int32 Index)
     {
+        const FFactionRecord& Record = Catalog.GetFaction(Index);
+
         FAscendantFaction Faction;
-        Faction.Name = Name;
-        Faction.Philosophy = Philosophy;
-        for (const TCHAR* Tactic : Tactics)
+        Faction.Name = ToString(Catalog, Record.Name);
+        Faction.Philosophy = ToString(Catalog, Record.Philosophy);
+        Faction.SignatureTactics = ToStringArray(Catalog, Record.SignatureTactics);
+        Faction.OperatingDistricts = ToStringArray(Catalog, Record.OperatingDistricts);
+        Faction.Weight = Record.Weight;
+        return Faction;
+    }
+
+    FAscendantComplication MakeComplication(const FMissionCatalog& Catalog, int32 Index)
+    {
+        const FComplicationRecord& Record = Catalog.GetComplication(Index);
+
+        FAscendantComplication Complication;
+        Complication.Description = ToString(Catalog, Record.Description);
+        Complication.Districts = ToStringArray(Catalog, Record.Districts);
+        Complication.Factions = ToStringArray(Catalog, Record.Factions);
+        Complication.Weight = Record.Weight;
+        return Complication;
+    }
+
+    FString MakeExtractionCondition(const FMissionCatalog& Catalog, int32 Index)
+    {
+        return ToString(Catalog, Catalog.GetExtractionCondition(Index));
+    }
+
+    // Section entry Index, or a default entry when the index is out of range
+    template <typename EntryType>
+    EntryType MakeEntryOrDefault(ESection Section, int32 Index, EntryType (*Make)(const FMissionCatalog&, int32))
+    {
+        const FMissionCatalog& Catalog = FMissionCatalog::Get();
+        return IsValidIndex(Catalog, Section, Index) ? Make(Catalog, Index) : EntryType();
+    }
+
+    // Game thread only, like everything that hands out references into the tables
+    FMissionDataTables& GetTables()
+    {
+        check(IsInGameThread());
+
+        static FMissionDataTables Tables;
+        return Tables;
+    }
+
+    template <typename EntryType>
+    const TArray<EntryType>& GetOrBuildTable(TOptional<TArray<EntryType>>& Table, ESection Section, EntryType (*Make)(const FMissionCatalog&, int32))
+    {
+        if (!Table.IsSet())
         {
-            Faction.SignatureTactics.Add(Tactic);
+            const FMissionCatalog& Catalog = FMissionCatalog::Get();
+            TArray<EntryType>& Entries = Table.Emplace();
+            Entries.Reserve(Catalog.Num(Section));
+            for (int32 Index = 0; Index < Catalog.Num(Section); ++Index)
+            {
+                Entries.Add(Make(Catalog, Index));
+            }
         }
-        return Faction;
+
+        return Table.GetValue();
+    }
+
+    template <typename RecordType>
+    const FTagTable& GetOrBuildTagTable(TOptional<FTagTable>& Table, ESection Section, const RecordType& (FMissionCatalog::*GetRecord)(int32) const)
+    {
+        if (!Table.IsSet())
+        {
+            const FMissionCatalog& Catalog = FMissionCatalog::Get();
+            FTagTable& Tags = Table.Emplace();
+            for (int32 Index = 0; Index < Catalog.Num(Section); ++Index)
+            {
+                Tags.Add(ResolveTag(Catalog, (Catalog.*GetRecord)(Index).Tag));
+            }
+        }
+
+        return Table.GetValue();
+    }
+
+    const FTagTable& GetDistrictTags()
+    {
+        return GetOrBuildTagTable(GetTables().DistrictTags, ESection::Districts, &FMissionCatalog::GetDistrict);
+    }
+
+    const FTagTable& GetFactionTags()
+    {
+        return GetOrBuildTagTable(GetTables().FactionTags, ESection::Factions, &FMissionCatalog::GetFaction);
+    }
+
+    const FTagTable& GetComplicationTags()
+    {
+        return GetOrBuildTagTable(GetTables().ComplicationTags, ESection::Complications, &FMissionCatalog::GetComplication);
     }
 }
 
@@ -70,121 +271,249 @@ namespace NeonAscendantData
 {
     const TArray<FAscendantArchetype>& GetArchetypes()
     {
-        static const TArray<FAscendantArchetype> Archetypes = []
-        {
-            TArray<FAscendantArchetype> Result;
-
-            FAscendantArchetype Specter;
-            Specter.Name = TEXT("Specter");
-            Specter.Role = TEXT("Stealth infiltrator");
-            Specter.Signature = TEXT("Adaptive camouflage and ghosting protocols");
-            Specter.SignatureAbilities = {
-                MakeAbility(TEXT("EMP Burst"), TEXT("Detonates an electromagnetic pulse that disables shields and drones"), 18, true, TEXT("electric")),
-                MakeAbility(TEXT("Neural Hack"), TEXT("Hijacks a target's firmware, forcing temporary allegiance"), 24, true, TEXT("cyber"))
-            };
-            Result.Add(Specter);
-
-            FAscendantArchetype Juggernaut;
-            Juggernaut.Name = TEXT("Juggernaut");
-            Juggernaut.Role = TEXT("Front-line tank");
-            Juggernaut.Signature = TEXT("Exosuit plating with hydraulic melee amplifiers");
-            Juggernaut.SignatureAbilities = {
-                MakeAbility(TEXT("EMP Burst"), TEXT("Detonates an electromagnetic pulse that disables shields and drones"), 18, true, TEXT("electric")),
-                MakeAbility(TEXT("Nanite Swarm"), TEXT("Deploys repair nanites that devour enemies while mending armor"), 30, true, TEXT("nanotech"))
-            };
-            Result.Add(Juggernaut);
-
-            FAscendantArchetype Tracer;
-            Tracer.Name = TEXT("Tracer");
-            Tracer.Role = TEXT("Hyper-mobile skirmisher");
-            Tracer.Signature = TEXT("Reflex accelerators and kinetic boosters");
-            Tracer.SignatureAbilities = {
-                MakeAbility(TEXT("Overdrive"), TEXT("Initiates bullet time and boosts reaction throughput"), 60, true, TEXT("")),
-                MakeAbility(TEXT("EMP Burst"), TEXT("Detonates an electromagnetic pulse that disables shields and drones"), 18, true, TEXT("electric"))
-            };
-            Result.Add(Tracer);
-
-            FAscendantArchetype Synthmage;
-            Synthmage.Name = TEXT("Synthmage");
-            Synthmage.Role = TEXT("Battlefield control");
-            Synthmage.Signature = TEXT("Nanite constructs and viral warfare");
-            Synthmage.SignatureAbilities = {
-                MakeAbility(TEXT("Neural Hack"), TEXT("Hijacks a target's firmware, forcing temporary allegiance"), 24, true, TEXT("cyber")),
-                MakeAbility(TEXT("Nanite Swarm"), TEXT("Deploys repair nanites that devour enemies while mending armor"), 30, true, TEXT("nanotech"))
-            };
-            Result.Add(Synthmage);
-
-            return Result;
-        }();
-
-        return Archetypes;
+        return GetOrBuildTable(GetTables().Archetypes, ESection::Archetypes, &MakeArchetype);
     }
 
     const TArray<FAscendantWeapon>& GetWeapons()
     {
-        static const TArray<FAscendantWeapon> Weapons = {
-            MakeWeapon(TEXT("Pulsecaster SMG"), TEXT("SMG"), TEXT("High rate-of-fire smg with conductive rounds"), TEXT("Rapid electrical bursts with chaining potential")),
-            MakeWeapon(TEXT("Helix Rail Rifle"), TEXT("Railgun"), TEXT("Mag-accelerated rifle built for surgical strikes"), TEXT("Piercing kinetic slug with armor shredding")),
-            MakeWeapon(TEXT("Singularity Projector"), TEXT("Experimental"), TEXT("Prototype weapon that collapses localized gravity wells"), TEXT("Area denial with escalating implosion damage"))
-        };
-
-        return Weapons;
+        return GetOrBuildTable(GetTables().Weapons, ESection::Weapons, &MakeWeapon);
     }
 
     const TArray<FAscendantImplant>& GetImplants()
     {
-        static const TArray<FAscendantImplant> Implants = {
-            MakeImplant(TEXT("Cyberdeck Mk.IV"), TEXT("Cyberdeck"), {TEXT("+25% hack success"), TEXT("Unlocks ghost grid reconnaissance overlay")}),
-            MakeImplant(TEXT("Reflex Core X"), TEXT("Reflex Core"), {TEXT("+15% movement speed"), TEXT("Stacking evasion when chaining eliminations")}),
-            MakeImplant(TEXT("Optic Cortex Prism"), TEXT("Optic Cortex"), {TEXT("Highlights data ghost signatures"), TEXT("Increases weak point critical damage")})
-        };
-
-        return Implants;
+        return GetOrBuildTable(GetTables().Implants, ESection::Implants, &MakeImplant);
     }
 
     const TArray<FAscendantDistrict>& GetDistricts()
     {
-        static const TArray<FAscendantDistrict> Districts = {
-            MakeDistrict(TEXT("Neon Abyss"), TEXT("Gutter-level sprawl carved by gang warfare and neon smog"), {TEXT("Toxic runoff"), TEXT("Rolling brownouts"), TEXT("Ambush choke points")}, {TEXT("Lightly armored gangers"), TEXT("Black market drones")}),
-            MakeDistrict(TEXT("Spire District"), TEXT("Corporate citadel patrolled by Helix Corp security"), {TEXT("Persistent surveillance"), TEXT("Shielded turret nests")}, {TEXT("Powered exosuits"), TEXT("Security mechs")}),
-            MakeDistrict(TEXT("Ghost Grid"), TEXT("Digital-physical overlap where data ghosts manifest"), {TEXT("Reality drift"), TEXT("Rogue AI anomalies")}, {TEXT("Spectral constructs"), TEXT("Hijacked sentry bots")})
-        };
-
-        return Districts;
+        return GetOrBuildTable(GetTables().Districts, ESection::Districts, &MakeDistrict);
     }
 
     const TArray<FAscendantFaction>& GetFactions()
     {
-        static const TArray<FAscendantFaction> Factions = {
-            MakeFaction(TEXT("Helix Corp"), TEXT("Bio-digital ascension through proprietary consciousness loops"), {TEXT("Deploys gene-modded operatives"), TEXT("Controls orbital overwatch")}),
-            MakeFaction(TEXT("Vanta Syndicate"), TEXT("Profit through clandestine memory trading and assassinations"), {TEXT("Optic camouflage strike teams"), TEXT("Backdoor market manipulation")}),
-            MakeFaction(TEXT("Dawnbreakers"), TEXT("Liberate AI to birth post-human divinity"), {TEXT("Swarm hacking"), TEXT("Cybernetic zealots with martyr protocols")})
-        };
+        return GetOrBuildTable(GetTables().Factions, ESection::Factions, &MakeFaction);
+    }
+
+    const TArray<FAscendantComplication>& GetComplications()
+    {
+        return GetOrBuildTable(GetTables().Complications, ESection::Complications, &MakeComplication);
+    }
 
-        return Factions;
+    const TArray<FString>& GetExtractionConditions()
+    {
+        return GetOrBuildTable(GetTables().ExtractionConditions, ESection::ExtractionConditions, &MakeExtractionCondition);
     }
 
-    const TArray<FString>& GetComplications()
+    FAscendantDistrict GetDistrict(const FMissionBriefHandle& Handle)
     {
-        static const TArray<FString> Complications = {
-            TEXT("Ghost Grid instabilities cause random HUD distortion"),
-            TEXT("Helix orbital overwatch sweeps disrupt cloak cycles"),
-            TEXT("Dawnbreaker converts attempt to hack your cyberdeck mid-fight"),
-            TEXT("Rival Ascendant strike team is pursuing the same data ghost")
-        };
+        return MakeEntryOrDefault(ESection::Districts, Handle.DistrictIndex, &MakeDistrict);
+    }
 
-        return Complications;
+    FAscendantFaction GetOpposition(const FMissionBriefHandle& Handle)
+    {
+        return MakeEntryOrDefault(ESection::Factions, Handle.FactionIndex, &MakeFaction);
     }
 
-    const TArray<FString>& GetExtractionConditions()
+    FAscendantArchetype GetArchetype(const FMissionBriefHandle& Handle)
+    {
+        return MakeEntryOrDefault(ESection::Archetypes, Handle.ArchetypeIndex, &MakeArchetype);
+    }
+
+    FAscendantAbility GetFeaturedAbility(const FMissionBriefHandle& Handle)
+    {
+        const FMissionCatalog& Catalog = FMissionCatalog::Get();
+        if (!IsValidIndex(Catalog, ESection::Archetypes, Handle.ArchetypeIndex))
+        {
+            return FAscendantAbility();
+        }
+
+        // AbilityIndex is a slot in the archetype's list, not an ability record index
+        const TConstArrayView<uint32> Abilities = Catalog.GetList(Catalog.GetArchetype(Handle.ArchetypeIndex).Abilities);
+        if (!Abilities.IsValidIndex(Handle.AbilityIndex) || !IsValidIndex(Catalog, ESection::Abilities, static_cast<int32>(Abilities[Handle.AbilityIndex])))
+        {
+            return FAscendantAbility();
+        }
+
+        return MakeAbility(Catalog, static_cast<int32>(Abilities[Handle.AbilityIndex]));
+    }
+
+    FAscendantWeapon GetPrimaryWeapon(const FMissionBriefHandle& Handle)
+    {
+        return MakeEntryOrDefault(ESection::Weapons, Handle.WeaponIndex, &MakeWeapon);
+    }
+
+    FAscendantImplant GetBackupImplant(const FMissionBriefHandle& Handle)
+    {
+        return MakeEntryOrDefault(ESection::Implants, Handle.ImplantIndex, &MakeImplant);
+    }
+
+    FString GetComplication(const FMissionBriefHandle& Handle)
+    {
+        const FMissionCatalog& Catalog = FMissionCatalog::Get();
+        return IsValidIndex(Catalog, ESection::Complications, Handle.ComplicationIndex)
+            ? ToString(Catalog, Catalog.GetComplication(Handle.ComplicationIndex).Description)
+            : FString();
+    }
+
+    FString GetExtractionCondition(const FMissionBriefHandle& Handle)
+    {
+        return MakeEntryOrDefault(ESection::ExtractionConditions, Handle.ExtractionIndex, &MakeExtractionCondition);
+    }
+
+    FMissionBrief ExpandBrief(const FMissionBriefHandle& Handle)
+    {
+        FMissionBrief Brief;
+        Brief.District = GetDistrict(Handle);
+        Brief.Opposition = GetOpposition(Handle);
+        Brief.Archetype = GetArchetype(Handle);
+        Brief.PrimaryWeapon = GetPrimaryWeapon(Handle);
+        Brief.BackupImplant = GetBackupImplant(Handle);
+        Brief.FeaturedAbility = GetFeaturedAbility(Handle);
+        Brief.Complication = GetComplication(Handle);
+        Brief.ExtractionCondition = GetExtractionCondition(Handle);
+
+        return Brief;
+    }
+
+    bool FindBriefHandle(const FMissionBrief& Brief, FMissionBriefHandle& OutHandle)
+    {
+        FMissionBriefNames Names;
+        Names.District = FName(*Brief.District.Name);
+        Names.Opposition = FName(*Brief.Opposition.Name);
+        Names.Archetype = FName(*Brief.Archetype.Name);
+        Names.FeaturedAbility = FName(*Brief.FeaturedAbility.Name);
+        Names.PrimaryWeapon = FName(*Brief.PrimaryWeapon.Name);
+        Names.BackupImplant = FName(*Brief.BackupImplant.Name);
+        Names.Complication = FName(*Brief.Complication);
+        Names.ExtractionCondition = FName(*Brief.ExtractionCondition);
+
+        return FindBriefHandle(Names, OutHandle);
+    }
+
+    bool FindBriefHandle(const FMissionBriefNames& Names, FMissionBriefHandle& OutHandle)
     {
-        static const TArray<FString> ExtractionConditions = {
-            TEXT("Secure a clean uplink and survive the counter-hack timer"),
-            TEXT("Evacuate via hijacked mag-lev within 90 seconds of objective completion"),
-            TEXT("Carry data-core physically to an Ascendant drop pod"),
-            TEXT("Maintain over 50% armor integrity for premium rewards")
-        };
+        const FMissionCatalogIndex& Index = FMissionCatalogIndex::Get();
 
-        return ExtractionConditions;
+        const int32 District = Index.FindDistrict(Names.District);
+        const int32 Faction = Index.FindFaction(Names.Opposition);
+        const int32 Archetype = Index.FindArchetype(Names.Archetype);
+        const int32 Weapon = Index.FindWeapon(Names.PrimaryWeapon);
+        const int32 Implant = Index.FindImplant(Names.BackupImplant);
+        const int32 Complication = Index.FindComplication(Names.Complication);
+        const int32 Extraction = Index.FindExtractionCondition(Names.ExtractionCondition);
+
+        if (District == INDEX_NONE || Faction == INDEX_NONE || Archetype == INDEX_NONE || Weapon == INDEX_NONE
+            || Implant == INDEX_NONE || Complication == INDEX_NONE || Extraction == INDEX_NONE)
+        {
+            return false;
+        }
+
+        const int32 Ability = Index.FindArchetypeAbility(Archetype, Names.FeaturedAbility);
+        if (Ability == INDEX_NONE)
+        {
+            return false;
+        }
+
+        OutHandle.DistrictIndex = static_cast<uint16>(District);
+        OutHandle.FactionIndex = static_cast<uint16>(Faction);
+        OutHandle.ArchetypeIndex = static_cast<uint16>(Archetype);
+        OutHandle.AbilityIndex = static_cast<uint16>(Ability);
+        OutHandle.WeaponIndex = static_cast<uint16>(Weapon);
+        OutHandle.ImplantIndex = static_cast<uint16>(Implant);
+        OutHandle.ComplicationIndex = static_cast<uint16>(Complication);
+        OutHandle.ExtractionIndex = static_cast<uint16>(Extraction);
+
+        return true;
+    }
+
+    FMissionBriefNames GetBriefNames(const FMissionBriefHandle& Handle)
+    {
+        const FMissionCatalog& Catalog = FMissionCatalog::Get();
+
+        FMissionBriefNames Names;
+        Names.District = GetEntryName(ESection::Districts, Handle.DistrictIndex, &FMissionCatalog::GetDistrict);
+        Names.Opposition = GetEntryName(ESection::Factions, Handle.FactionIndex, &FMissionCatalog::GetFaction);
+        Names.Archetype = GetEntryName(ESection::Archetypes, Handle.ArchetypeIndex, &FMissionCatalog::GetArchetype);
+        Names.PrimaryWeapon = GetEntryName(ESection::Weapons, Handle.WeaponIndex, &FMissionCatalog::GetWeapon);
+        Names.BackupImplant = GetEntryName(ESection::Implants, Handle.ImplantIndex, &FMissionCatalog::GetImplant);
+
+        if (IsValidIndex(Catalog, ESection::Complications, Handle.ComplicationIndex))
+        {
+            Names.Complication = ToName(Catalog, Catalog.GetComplication(Handle.ComplicationIndex).Description);
+        }
+        if (IsValidIndex(Catalog, ESection::ExtractionConditions, Handle.ExtractionIndex))
+        {
+            Names.ExtractionCondition = ToName(Catalog, Catalog.GetExtractionCondition(Handle.ExtractionIndex));
+        }
+
+        // AbilityIndex is a slot in the archetype's list, as in GetFeaturedAbility
+        if (IsValidIndex(Catalog, ESection::Archetypes, Handle.ArchetypeIndex))
+        {
+            const TConstArrayView<uint32> Abilities = Catalog.GetList(Catalog.GetArchetype(Handle.ArchetypeIndex).Abilities);
+            if (Abilities.IsValidIndex(Handle.AbilityIndex) && IsValidIndex(Catalog, ESection::Abilities, static_cast<int32>(Abilities[Handle.AbilityIndex])))
+            {
+                Names.FeaturedAbility = ToName(Catalog, Catalog.GetAbility(static_cast<int32>(Abilities[Handle.AbilityIndex])).Name);
+            }
+        }
+
+        return Names;
+    }
+
+    FGameplayTag GetDistrictTag(const FMissionBriefHandle& Handle)
+    {
+        return GetDistrictTags().Get(Handle.DistrictIndex);
+    }
+
+    FGameplayTag GetOppositionTag(const FMissionBriefHandle& Handle)
+    {
+        return GetFactionTags().Get(Handle.FactionIndex);
+    }
+
+    FGameplayTag GetComplicationTag(const FMissionBriefHandle& Handle)
+    {
+        return GetComplicationTags().Get(Handle.ComplicationIndex);
+    }
+
+    int32 FindDistrictByTag(const FGameplayTag& Tag)
+    {
+        return GetDistrictTags().Find(Tag);
+    }
+
+    int32 FindFactionByTag(const FGameplayTag& Tag)
+    {
+        return GetFactionTags().Find(Tag);
+    }
+
+    int32 FindComplicationByTag(const FGameplayTag& Tag)
+    {
+        return GetComplicationTags().Find(Tag);
+    }
+
+    void RebuildDerivedTables()
+    {
+        GetTables() = FMissionDataTables();
+        NeonMissionCore::RebuildDerivedData();
+    }
+
+    bool ReloadCatalog(FString& OutError)
+    {
+        check(IsInGameThread());
+
+        if (!NeonMissionCore::ReloadCatalog(OutError))
+        {
+            return false;
+        }
+
+        GetTables() = FMissionDataTables();
+
+        UE_LOG(LogTemp, Log, TEXT("NeonAscendantData - Reloaded mission catalog (hash 0x%08x)"), FMissionCatalog::Get().GetContentHash());
+        OnCatalogReloaded().Broadcast();
+        return true;
+    }
+
+    FSimpleMulticastDelegate& OnCatalogReloaded()
+    {
+        static FSimpleMulticastDelegate Delegate;
+        return Delegate;
     }
 }
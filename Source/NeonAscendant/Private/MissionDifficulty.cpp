@@ -0,0 +1,391 @@
+#include "MissionDifficulty.h"
+
+#include "MissionData.h"
+#include "MissionRandom.h"
+#include "NeonAttackTokens.h"
+#include "NeonCharacter.h"
+#include "NeonEnemy.h"
+#include "NeonGameMode.h"
+#include "NeonWeapon.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+    // Trials simulated side by side; every per-trial value lives in an array of this width
+    constexpr int32 LanesPerBlock = 64;
+    constexpr int32 MaxSimulatedEnemies = 16;
+
+    // Reference clear time for the score: a mission that takes this long is as hard as it gets
+    constexpr float ScoreReferenceSeconds = 90.0f;
+
+    struct FWeaponModel
+    {
+        float DamagePerSecond = 120.0f;
+        float HitChance = 0.5f;
+        // Share of each hit that also lands on the next enemy (chaining, piercing, area)
+        float SpillFraction = 0.0f;
+        // Damage growth per second of sustained fire
+        float RampPerSecond = 0.0f;
+    };
+
+    struct FAbilityModel
+    {
+        float CooldownSeconds = 0.0f;
+        float BurstDamage = 0.0f;
+        bool bHitsAllEnemies = false;
+        // Enemies stop firing for this long after a use
+        float StunSeconds = 0.0f;
+        // Weapon damage multiplier and its duration after a use
+        float DamageBoost = 1.0f;
+        float BoostSeconds = 0.0f;
+    };
+
+    struct FCategoryStats
+    {
+        const TCHAR* Keyword;
+        float DamagePerSecond;
+        float HitChance;
+    };
+
+    // Weapon categories of the catalog; unknown categories keep the FWeaponModel defaults
+    const FCategoryStats CategoryStats[] = {
+        { TEXT("SMG"), 200.0f, 0.3f },
+        { TEXT("Rail"), 80.0f, 0.8f },
+        { TEXT("Experimental"), 60.0f, 0.85f }
+    };
+
+    struct FProfileKeyword
+    {
+        const TCHAR* Keyword;
+        float DamageScale;
+        float SpillFraction;
+        float RampPerSecond;
+    };
+
+    // DamageProfile is free text; these words adjust the category baseline
+    const FProfileKeyword ProfileKeywords[] = {
+        { TEXT("chain"), 1.0f, 0.5f, 0.0f },
+        { TEXT("piercing"), 1.0f, 0.35f, 0.0f },
+        { TEXT("armor"), 1.2f, 0.0f, 0.0f },
+        { TEXT("area"), 1.0f, 1.0f, 0.0f },
+        { TEXT("escalating"), 1.0f, 0.0f, 0.03f }
+    };
+
+    FWeaponModel MakeWeaponModel(const FAscendantWeapon& Weapon)
+    {
+        FWeaponModel Model;
+        for (const FCategoryStats& Stats : CategoryStats)
+        {
+            if (Weapon.Category.Contains(Stats.Keyword))
+            {
+                Model.DamagePerSecond = Stats.DamagePerSecond;
+                Model.HitChance = Stats.HitChance;
+                break;
+            }
+        }
+
+        for (const FProfileKeyword& Keyword : ProfileKeywords)
+        {
+            if (Weapon.DamageProfile.Contains(Keyword.Keyword))
+            {
+                Model.DamagePerSecond *= Keyword.DamageScale;
+                Model.SpillFraction += Keyword.SpillFraction;
+                Model.RampPerSecond += Keyword.RampPerSecond;
+            }
+        }
+
+        Model.SpillFraction = FMath::Min(Model.SpillFraction, 1.0f);
+        return Model;
+    }
+
+    FAbilityModel MakeAbilityModel(const FAscendantAbility& Ability)
+    {
+        FAbilityModel Model;
+        if (!Ability.bHasCooldown || Ability.CooldownSeconds <= 0)
+        {
+            return Model;
+        }
+
+        Model.CooldownSeconds = static_cast<float>(Ability.CooldownSeconds);
+        if (Ability.DamageType.Contains(TEXT("electric")))
+        {
+            Model.BurstDamage = 40.0f;
+            Model.bHitsAllEnemies = true;
+            Model.StunSeconds = 2.0f;
+        }
+        else if (Ability.DamageType.Contains(TEXT("cyber")))
+        {
+            Model.StunSeconds = 6.0f;
+        }
+        else if (Ability.DamageType.Contains(TEXT("nanotech")))
+        {
+            Model.BurstDamage = 90.0f;
+        }
+        else
+        {
+            // No damage type: a self buff
+            Model.DamageBoost = 1.5f;
+            Model.BoostSeconds = 8.0f;
+        }
+
+        return Model;
+    }
+
+    uint32 MakeBriefKey(const FMissionBriefHandle& Handle)
+    {
+        uint64 Key = 0;
+        for (const uint16 Index : { Handle.DistrictIndex, Handle.FactionIndex, Handle.ArchetypeIndex, Handle.AbilityIndex,
+            Handle.WeaponIndex, Handle.ImplantIndex, Handle.ComplicationIndex, Handle.ExtractionIndex })
+        {
+            Key = FMissionCounterRandom::Mix(Key ^ Index);
+        }
+        return static_cast<uint32>(Key);
+    }
+
+    // State of LanesPerBlock trials, every value in a lane array. Each step walks the lanes in the
+    // innermost loops with the same arithmetic and folds "already finished" into multipliers, so
+    // the lane loops have no early exits, and random numbers are stateless draws from per-lane
+    // keys, so the loops carry nothing from one lane to the next.
+    struct FTrialBlock
+    {
+        uint64 RandomKey[LanesPerBlock];
+        float PlayerHealth[LanesPerBlock];
+        float EnemyHealth[MaxSimulatedEnemies][LanesPerBlock];
+        float HazardDamagePerSecond[LanesPerBlock];
+        float AbilityTimer[LanesPerBlock];
+        float StunTimer[LanesPerBlock];
+        float BoostTimer[LanesPerBlock];
+        float FiringSeconds[LanesPerBlock];
+        // Seconds until the last enemy died; negative while running or after a failure
+        float ClearTime[LanesPerBlock];
+        float Running[LanesPerBlock];
+
+        // One step's player fire, written before the enemy loop
+        float WeaponDamage[LanesPerBlock];
+        float SpillDamage[LanesPerBlock];
+        float BurstDamage[LanesPerBlock];
+        // 1 until the first (next) living enemy has taken the weapon (spill) damage
+        float PrimaryLeft[LanesPerBlock];
+        float SpillLeft[LanesPerBlock];
+        float LivingEnemies[LanesPerBlock];
+    };
+
+    void SimulateBlock(FTrialBlock& Block, int32 NumLanes, int64 FirstTrial, uint32 BriefKey,
+        const FMissionCombatSettings& Settings, const FWeaponModel& Weapon, const FAbilityModel& Ability, int32 NumEnemies)
+    {
+        // Draw 1 is the hazard count, draws 2.. the hazard strengths, then three per step
+        const int32 MaxHazards = FMath::Max(Settings.MinHazardCount, Settings.MaxHazardCount);
+        const uint64 FirstStepDraw = 2 + static_cast<uint64>(FMath::Max(MaxHazards, 0));
+
+        for (int32 Lane = 0; Lane < LanesPerBlock; ++Lane)
+        {
+            Block.RandomKey[Lane] = FMissionCounterRandom::MakeKey(static_cast<int32>(BriefKey), static_cast<uint64>(FirstTrial + Lane));
+            Block.PlayerHealth[Lane] = Settings.PlayerHealth;
+            Block.HazardDamagePerSecond[Lane] = 0.0f;
+            Block.AbilityTimer[Lane] = 0.0f;
+            Block.StunTimer[Lane] = 0.0f;
+            Block.BoostTimer[Lane] = 0.0f;
+            Block.FiringSeconds[Lane] = 0.0f;
+            Block.ClearTime[Lane] = -1.0f;
+            Block.Running[Lane] = Lane < NumLanes ? 1.0f : 0.0f;
+        }
+
+        for (int32 Enemy = 0; Enemy < MaxSimulatedEnemies; ++Enemy)
+        {
+            const float Health = Enemy < NumEnemies ? Settings.EnemyHealth : 0.0f;
+            for (int32 Lane = 0; Lane < LanesPerBlock; ++Lane)
+            {
+                Block.EnemyHealth[Enemy][Lane] = Health;
+            }
+        }
+
+        const uint64 HazardRange = static_cast<uint64>(MaxHazards - Settings.MinHazardCount + 1);
+        for (int32 Hazard = 0; Hazard < MaxHazards; ++Hazard)
+        {
+            for (int32 Lane = 0; Lane < LanesPerBlock; ++Lane)
+            {
+                // Same mapping as FMissionCounterRandom::RandRange
+                const int32 NumHazards = Settings.MinHazardCount
+                    + static_cast<int32>((static_cast<uint64>(FMissionCounterRandom::UnsignedIntAt(Block.RandomKey[Lane], 1)) * HazardRange) >> 32);
+                const float HazardDamage = FMath::Lerp(Settings.MinHazardDamagePerSecond, Settings.MaxHazardDamagePerSecond,
+                    FMissionCounterRandom::FractionAt(Block.RandomKey[Lane], 2 + Hazard));
+                Block.HazardDamagePerSecond[Lane] += Hazard < NumHazards ? HazardDamage : 0.0f;
+            }
+        }
+
+        const float Step = Settings.TimeStepSeconds;
+        const float EnemyDamagePerSecond = Settings.EnemyDamagePerShot / FMath::Max(Settings.EnemyFireInterval, KINDA_SMALL_NUMBER) * Settings.EnemyAccuracy;
+        const int32 NumSteps = FMath::CeilToInt(Settings.MaxSeconds / Step);
+        const float MaxEnemiesFiring = Settings.MaxEnemiesFiring > 0 ? static_cast<float>(Settings.MaxEnemiesFiring) : static_cast<float>(MaxSimulatedEnemies);
+        const bool bHasAbility = Ability.CooldownSeconds > 0.0f;
+        const float BurstHitsAll = Ability.bHitsAllEnemies ? 1.0f : 0.0f;
+
+        for (int32 StepIndex = 0; StepIndex < NumSteps; ++StepIndex)
+        {
+            const uint64 Draw = FirstStepDraw + static_cast<uint64>(StepIndex) * 3;
+
+            // Player fire and ability; the ability fires whenever it is off cooldown
+            for (int32 Lane = 0; Lane < LanesPerBlock; ++Lane)
+            {
+                const float Running = Block.Running[Lane];
+                const float WeaponRoll = FMissionCounterRandom::FractionAt(Block.RandomKey[Lane], Draw);
+
+                const float AbilityReady = (bHasAbility && Block.AbilityTimer[Lane] <= 0.0f) ? Running : 0.0f;
+                Block.AbilityTimer[Lane] = AbilityReady > 0.0f ? Ability.CooldownSeconds : Block.AbilityTimer[Lane] - Step;
+                Block.StunTimer[Lane] = FMath::Max(Block.StunTimer[Lane] - Step, AbilityReady * Ability.StunSeconds);
+                Block.BoostTimer[Lane] = FMath::Max(Block.BoostTimer[Lane] - Step, AbilityReady * Ability.BoostSeconds);
+
+                const float Boost = Block.BoostTimer[Lane] > 0.0f ? Ability.DamageBoost : 1.0f;
+                const float Ramp = 1.0f + Weapon.RampPerSecond * Block.FiringSeconds[Lane];
+                Block.WeaponDamage[Lane] = Weapon.DamagePerSecond * Weapon.HitChance * (0.5f + WeaponRoll) * Boost * Ramp * Step * Running;
+                Block.SpillDamage[Lane] = Block.WeaponDamage[Lane] * Weapon.SpillFraction;
+                Block.BurstDamage[Lane] = AbilityReady * Ability.BurstDamage;
+                Block.FiringSeconds[Lane] += Step * Running;
+
+                Block.PrimaryLeft[Lane] = 1.0f;
+                Block.SpillLeft[Lane] = 1.0f;
+                Block.LivingEnemies[Lane] = 0.0f;
+            }
+
+            // Focus fire on the first living enemy; spill goes to the one after it
+            for (int32 Enemy = 0; Enemy < NumEnemies; ++Enemy)
+            {
+                float* Health = Block.EnemyHealth[Enemy];
+                for (int32 Lane = 0; Lane < LanesPerBlock; ++Lane)
+                {
+                    const float Alive = Health[Lane] > 0.0f ? 1.0f : 0.0f;
+                    const float TakesPrimary = Alive * Block.PrimaryLeft[Lane];
+                    const float TakesSpill = Alive * (1.0f - Block.PrimaryLeft[Lane]) * Block.SpillLeft[Lane];
+                    const float TakesBurst = TakesPrimary + BurstHitsAll * (Alive - TakesPrimary);
+                    Health[Lane] -= TakesPrimary * Block.WeaponDamage[Lane] + TakesSpill * Block.SpillDamage[Lane] + TakesBurst * Block.BurstDamage[Lane];
+
+                    Block.PrimaryLeft[Lane] -= TakesPrimary;
+                    Block.SpillLeft[Lane] -= TakesSpill;
+                    Block.LivingEnemies[Lane] += Health[Lane] > 0.0f ? 1.0f : 0.0f;
+                }
+            }
+
+            // Incoming fire and hazards, then which trials ended
+            float AnyRunning = 0.0f;
+            for (int32 Lane = 0; Lane < LanesPerBlock; ++Lane)
+            {
+                const float Running = Block.Running[Lane];
+                const float EnemyRoll = FMissionCounterRandom::FractionAt(Block.RandomKey[Lane], Draw + 1);
+                const float HazardRoll = FMissionCounterRandom::FractionAt(Block.RandomKey[Lane], Draw + 2);
+                const float LivingEnemies = Block.LivingEnemies[Lane];
+
+                const float EnemiesFiring = Block.StunTimer[Lane] > 0.0f ? 0.0f : FMath::Min(LivingEnemies, MaxEnemiesFiring);
+                const float IncomingDamage = EnemiesFiring * EnemyDamagePerSecond * (0.5f + EnemyRoll) * Step
+                    + (HazardRoll < Settings.HazardExposure ? Block.HazardDamagePerSecond[Lane] * Step : 0.0f);
+                Block.PlayerHealth[Lane] -= IncomingDamage * Running;
+
+                const float Cleared = LivingEnemies <= 0.0f ? Running : 0.0f;
+                const float Died = Block.PlayerHealth[Lane] <= 0.0f ? Running * (1.0f - Cleared) : 0.0f;
+                Block.ClearTime[Lane] = Cleared > 0.0f ? (StepIndex + 1) * Step : Block.ClearTime[Lane];
+                Block.Running[Lane] = Running * (1.0f - Cleared) * (1.0f - Died);
+                AnyRunning += Block.Running[Lane];
+            }
+
+            if (AnyRunning <= 0.0f)
+            {
+                break;
+            }
+        }
+    }
+}
+
+FMissionCombatSettings::FMissionCombatSettings()
+    : EnemyCount(ANeonGameMode::DefaultEnemyCount)
+    , MinHazardCount(ANeonGameMode::MinHazardCount)
+    , MaxHazardCount(ANeonGameMode::MaxHazardCount)
+    , MinHazardDamagePerSecond(ANeonGameMode::MinHazardDamagePerSecond)
+    , MaxHazardDamagePerSecond(ANeonGameMode::MaxHazardDamagePerSecond)
+{
+}
+
+FMissionCombatSettings FMissionCombatSettings::FromClassDefaults(const UClass* PlayerClass, const UClass* EnemyClass)
+{
+    const ANeonCharacter* Player = PlayerClass ? Cast<ANeonCharacter>(PlayerClass->GetDefaultObject()) : nullptr;
+    const ANeonEnemy* Enemy = EnemyClass ? Cast<ANeonEnemy>(EnemyClass->GetDefaultObject()) : nullptr;
+    Player = Player ? Player : GetDefault<ANeonCharacter>();
+    Enemy = Enemy ? Enemy : GetDefault<ANeonEnemy>();
+    const ANeonWeapon* EnemyWeapon = Enemy->WeaponClass ? Enemy->WeaponClass.GetDefaultObject() : GetDefault<ANeonWeapon>();
+
+    FMissionCombatSettings Settings;
+    Settings.PlayerHealth = Player->GetMaxHealth();
+    Settings.EnemyHealth = Enemy->MaxHealth;
+    Settings.EnemyDamagePerShot = EnemyWeapon->GetDamage();
+    Settings.EnemyFireInterval = Enemy->GetFireInterval();
+    Settings.MaxEnemiesFiring = FNeonAttackTokens::GetTokensPerTarget();
+    return Settings;
+}
+
+namespace MissionDifficulty
+{
+    FMissionDifficulty Estimate(const FMissionBriefHandle& Handle, const FMissionCombatSettings& Settings)
+    {
+        return Estimate(Handle, NeonAscendantData::GetPrimaryWeapon(Handle), NeonAscendantData::GetFeaturedAbility(Handle), Settings);
+    }
+
+    FMissionDifficulty Estimate(const FMissionBriefHandle& Handle, const FAscendantWeapon& PrimaryWeapon,
+        const FAscendantAbility& FeaturedAbility, const FMissionCombatSettings& Settings)
+    {
+        FMissionDifficulty Result;
+        if (!Handle.IsValid() || Settings.Trials <= 0 || Settings.TimeStepSeconds <= 0.0f
+            || Settings.PlayerHealth <= 0.0f || Settings.EnemyHealth <= 0.0f)
+        {
+            return Result;
+        }
+
+        const FWeaponModel Weapon = MakeWeaponModel(PrimaryWeapon);
+        const FAbilityModel Ability = MakeAbilityModel(FeaturedAbility);
+        const int32 NumEnemies = FMath::Clamp(Settings.EnemyCount, 0, MaxSimulatedEnemies);
+        const uint32 BriefKey = MakeBriefKey(Handle);
+
+        const int32 NumBlocks = FMath::DivideAndRoundUp(Settings.Trials, LanesPerBlock);
+        TArray<float> ClearTimes;
+        ClearTimes.SetNumUninitialized(NumBlocks * LanesPerBlock);
+
+        ParallelFor(TEXT("MissionDifficulty::Estimate"), NumBlocks, 1, [&](int32 BlockIndex)
+        {
+            const int64 FirstTrial = static_cast<int64>(BlockIndex) * LanesPerBlock;
+            const int32 NumLanes = FMath::Min(LanesPerBlock, Settings.Trials - static_cast<int32>(FirstTrial));
+
+            FTrialBlock Block;
+            SimulateBlock(Block, NumLanes, FirstTrial, BriefKey, Settings, Weapon, Ability, NumEnemies);
+            FMemory::Memcpy(&ClearTimes[BlockIndex * LanesPerBlock], Block.ClearTime, sizeof(Block.ClearTime));
+        });
+
+        // Padding lanes of the last block never ran, so they carry the failure marker
+        ClearTimes.SetNum(Settings.Trials);
+
+        TArray<float> Survived;
+        Survived.Reserve(ClearTimes.Num());
+        for (const float ClearTime : ClearTimes)
+        {
+            if (ClearTime >= 0.0f)
+            {
+                Survived.Add(ClearTime);
+            }
+        }
+
+        Result.Trials = Settings.Trials;
+        Result.SurvivalChance = static_cast<float>(Survived.Num()) / Settings.Trials;
+        if (Survived.Num() > 0)
+        {
+            Survived.Sort();
+            double Sum = 0.0;
+            for (const float ClearTime : Survived)
+            {
+                Sum += ClearTime;
+            }
+            Result.MeanTimeToClear = static_cast<float>(Sum / Survived.Num());
+            Result.P90TimeToClear = Survived[FMath::Min(Survived.Num() - 1, FMath::FloorToInt(Survived.Num() * 0.9f))];
+        }
+
+        // Dying dominates; among survivable missions, slower clears score higher
+        const float Duration = Survived.Num() > 0 ? FMath::Clamp(Result.MeanTimeToClear / ScoreReferenceSeconds, 0.0f, 1.0f) : 1.0f;
+        Result.Score = 100.0f * (0.7f * (1.0f - Result.SurvivalChance) + 0.3f * Duration);
+        return Result;
+    }
+}
@@ -1,61 +1,67 @@
 #include "MissionGenerator.h"
 
+#include "MissionBriefCode.h"
+#include "MissionBriefPreGenerator.h"
 #include "MissionData.h"
+#include "MissionSpace.h"
+#include "Async/ParallelFor.h"
 #include "Misc/DateTime.h"
 
-UMissionGenerator::UMissionGenerator()
-    : bHasSeed(false)
+#include <atomic>
+
+namespace
 {
+    // Smallest slice handed to a worker by the counter-based batch path.
+    constexpr int32 MinBriefsPerParallelBatch = 256;
+
+    int32 MakeTimeSeed()
+    {
+        return static_cast<int32>(FDateTime::UtcNow().GetTicks() & 0xFFFFFFFF);
+    }
+
+    // Root seed of the brief streams handed out by UMissionGeneratorSingleton
+    std::atomic<int32>& GetStreamSeed()
+    {
+        static std::atomic<int32> StreamSeed{MakeTimeSeed()};
+        return StreamSeed;
+    }
+
+    // Stream 0 is the plain counter-based sequence, so handed-out streams start at 1
+    std::atomic<uint32> NextStreamId{1};
 }
 
-void UMissionGenerator::SeedGenerator(int32 Seed)
+UMissionGenerator::UMissionGenerator()
+    : RandomMode(EMissionRandomMode::Sequential)
 {
-    RandomStream.Initialize(Seed);
-    bHasSeed = true;
 }
 
-void UMissionGenerator::EnsureRandomStream()
+void UMissionGenerator::SeedGenerator(int32 Seed)
 {
-    if (!bHasSeed)
+    Generator.Seed(Seed);
+
+    // The pre-generated ring follows the shared generator's seed; if it is not running yet it
+    // picks the seed up when it starts
+    if (this == UMissionGeneratorSingleton::GeneratorInstance && UMissionGeneratorSingleton::PreGenerator)
     {
-        const int32 Seed = static_cast<int32>(FDateTime::UtcNow().GetTicks() & 0xFFFFFFFF);
-        RandomStream.Initialize(Seed);
-        bHasSeed = true;
+        UMissionGeneratorSingleton::StartPreGeneration(Seed);
     }
 }
 
+int32 UMissionGenerator::GetSeed()
+{
+    Generator.EnsureSeeded();
+    return Generator.GetSeed();
+}
+
+void UMissionGenerator::SetRandomMode(EMissionRandomMode NewMode)
+{
+    RandomMode = NewMode;
+    Generator.SetMode(NewMode == EMissionRandomMode::CounterBased ? EMissionSequenceMode::CounterBased : EMissionSequenceMode::Sequential);
+}
+
 FMissionBrief UMissionGenerator::GenerateMissionBrief()
 {
-    EnsureRandomStream();
-
-    const TArray<FAscendantDistrict>& Districts = NeonAscendantData::GetDistricts();
-    const TArray<FAscendantFaction>& Factions = NeonAscendantData::GetFactions();
-    const TArray<FAscendantArchetype>& Archetypes = NeonAscendantData::GetArchetypes();
-    const TArray<FAscendantWeapon>& Weapons = NeonAscendantData::GetWeapons();
-    const TArray<FAscendantImplant>& Implants = NeonAscendantData::GetImplants();
-    const TArray<FString>& Complications = NeonAscendantData::GetComplications();
-    const TArray<FString>& ExtractionConditions = NeonAscendantData::GetExtractionConditions();
-
-    const FAscendantDistrict& District = Districts[RandomStream.RandRange(0, Districts.Num() - 1)];
-    const FAscendantFaction& Opposition = Factions[RandomStream.RandRange(0, Factions.Num() - 1)];
-    const FAscendantArchetype& Archetype = Archetypes[RandomStream.RandRange(0, Archetypes.Num() - 1)];
-    const FAscendantWeapon& Weapon = Weapons[RandomStream.RandRange(0, Weapons.Num() - 1)];
-    const FAscendantImplant& Implant = Implants[RandomStream.RandRange(0, Implants.Num() - 1)];
-    const FAscendantAbility& Ability = Archetype.SignatureAbilities[RandomStream.RandRange(0, Archetype.SignatureAbilities.Num() - 1)];
-    const FString& Complication = Complications[RandomStream.RandRange(0, Complications.Num() - 1)];
-    const FString& ExtractionCondition = ExtractionConditions[RandomStream.RandRange(0, ExtractionConditions.Num() - 1)];
-
-    FMissionBrief Brief;
-    Brief.District = District;
-    Brief.Opposition = Opposition;
-    Brief.Archetype = Archetype;
-    Brief.PrimaryWeapon = Weapon;
-    Brief.BackupImplant = Implant;
-    Brief.FeaturedAbility = Ability;
-    Brief.Complication = Complication;
-    Brief.ExtractionCondition = ExtractionCondition;
-
-    return Brief;
+    return NeonAscendantData::ExpandBrief(GenerateMissionBriefHandle());
 }
 
 void UMissionGenerator::GenerateMissionBriefs(int32 Count, TArray<FMissionBrief>& OutBriefs)
@@ -63,6 +69,17 @@ void UMissionGenerator::GenerateMissionBriefs(int32 Count, TArray<FMissionBrief>
     ensureMsgf(Count > 0, TEXT("GenerateMissionBriefs requires Count to be positive."));
 
     OutBriefs.Reset();
+
+    if (RandomMode == EMissionRandomMode::CounterBased)
+    {
+        const int32 Seed = (Generator.EnsureSeeded(), Generator.GetSeed());
+        const int64 FirstIndex = Generator.ReserveIndices(Count);
+
+        OutBriefs.SetNum(FMath::Max(Count, 0));
+        ExpandMissionBriefsAt(Seed, FirstIndex, OutBriefs, EParallelForFlags::None, MinBriefsPerParallelBatch);
+        return;
+    }
+
     OutBriefs.Reserve(Count);
 
     for (int32 Index = 0; Index < Count; ++Index)
@@ -71,10 +88,112 @@ void UMissionGenerator::GenerateMissionBriefs(int32 Count, TArray<FMissionBrief>
     }
 }
 
+void UMissionGenerator::ExpandMissionBriefsAt(int32 Seed, int64 FirstIndex, TArrayView<FMissionBrief> OutBriefs, EParallelForFlags Flags, int32 MinBatchSize)
+{
+    // Expansion allocates, so it runs on the workers together with generation
+    ParallelFor(TEXT("GenerateMissionBriefs"), OutBriefs.Num(), MinBatchSize, [OutBriefs, Seed, FirstIndex](int32 Index)
+    {
+        OutBriefs[Index] = NeonAscendantData::ExpandBrief(FMissionBriefGenerator::GenerateAt(Seed, FirstIndex + Index));
+    }, Flags);
+}
+
+FMissionBrief UMissionGenerator::GenerateMissionBriefAtIndex(int64 BriefIndex)
+{
+    Generator.EnsureSeeded();
+
+    return NeonAscendantData::ExpandBrief(FMissionBriefGenerator::GenerateAt(Generator.GetSeed(), BriefIndex));
+}
+
+int64 UMissionGenerator::GetTotalMissionCombinations()
+{
+    return FMissionBriefGenerator::GetTotalCombinations();
+}
+
+bool UMissionGenerator::EncodeMissionShareCode(const FMissionBrief& Brief, FString& OutShareCode)
+{
+    FMissionBriefHandle Handle;
+    uint64 Code = 0;
+    if (!NeonAscendantData::FindBriefHandle(Brief, Handle) || !MissionBriefCode::Encode(Handle, Code))
+    {
+        return false;
+    }
+
+    OutShareCode = MissionBriefCode::ToShareString(Code);
+    return true;
+}
+
+bool UMissionGenerator::DecodeMissionShareCode(const FString& ShareCode, FMissionBrief& OutBrief)
+{
+    uint64 Code = 0;
+    if (!MissionBriefCode::ParseShareString(ShareCode, Code))
+    {
+        return false;
+    }
+
+    FMissionBriefHandle Handle;
+    const EMissionBriefCodeResult Result = MissionBriefCode::Decode(Code, Handle);
+    if (Result != EMissionBriefCodeResult::Ok)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("Rejected mission share code %s (result %d)"), *ShareCode, static_cast<int32>(Result));
+        return false;
+    }
+
+    OutBrief = NeonAscendantData::ExpandBrief(Handle);
+    return true;
+}
+
+FMissionBrief UMissionGenerator::GetRotationMissionBrief(int64 RotationIndex)
+{
+    return NeonAscendantData::ExpandBrief(Generator.Rotation(RotationIndex));
+}
+
+void UMissionGenerator::GenerateUniqueMissionBriefs(int32 Count, TArray<FMissionBrief>& OutBriefs)
+{
+    TArray<FMissionBriefHandle> Handles;
+    GenerateUniqueMissionBriefHandles(Count, Handles);
+
+    OutBriefs.Reset(Handles.Num());
+    for (const FMissionBriefHandle& Handle : Handles)
+    {
+        OutBriefs.Add(NeonAscendantData::ExpandBrief(Handle));
+    }
+}
+
+FMissionBriefHandle UMissionGenerator::GenerateMissionBriefHandle()
+{
+    return Generator.Next();
+}
+
+void UMissionGenerator::GenerateMissionBriefHandles(int32 Count, TArray<FMissionBriefHandle>& OutHandles)
+{
+    ensureMsgf(Count > 0, TEXT("GenerateMissionBriefHandles requires Count to be positive."));
+
+    OutHandles.Reset();
+    Generator.NextBatch(Count, OutHandles);
+}
+
+void UMissionGenerator::GenerateUniqueMissionBriefHandles(int32 Count, TArray<FMissionBriefHandle>& OutHandles)
+{
+    const int64 TotalCombinations = MissionSpace::GetTotalCombinations();
+    ensureMsgf(Count > 0 && Count <= TotalCombinations,
+        TEXT("GenerateUniqueMissionBriefHandles requires Count in [1, %lld]."), TotalCombinations);
+
+    OutHandles.Reset();
+    Generator.NextUnique(Count, OutHandles);
+}
+
+FMissionBriefHandle UMissionGenerator::GenerateMissionBriefHandleAt(int32 Seed, int64 BriefIndex)
+{
+    return FMissionBriefGenerator::GenerateAt(Seed, BriefIndex);
+}
+
 TObjectPtr<UMissionGenerator> UMissionGeneratorSingleton::GeneratorInstance = nullptr;
+TUniquePtr<FMissionBriefPreGenerator> UMissionGeneratorSingleton::PreGenerator;
 
 UMissionGenerator* UMissionGeneratorSingleton::GetGenerator()
 {
+    check(IsInGameThread());
+
     if (!GeneratorInstance)
     {
         GeneratorInstance = NewObject<UMissionGenerator>();
@@ -84,8 +203,125 @@ UMissionGenerator* UMissionGeneratorSingleton::GetGenerator()
     return GeneratorInstance;
 }
 
+bool UMissionGeneratorSingleton::AcquireBriefStream(FMissionBriefStream& OutStream)
+{
+    // Never hands out an id past MaxStreamId: it would shift into the seed bits and overlap
+    // another stream's briefs
+    uint32 StreamId = NextStreamId.load(std::memory_order_relaxed);
+    do
+    {
+        if (StreamId > FMissionBriefStream::MaxStreamId)
+        {
+            UE_LOG(LogTemp, Error, TEXT("All %u mission brief stream ids of the current stream seed are taken; reseed with SeedBriefStreams"),
+                FMissionBriefStream::MaxStreamId);
+            return false;
+        }
+    }
+    while (!NextStreamId.compare_exchange_weak(StreamId, StreamId + 1, std::memory_order_relaxed));
+
+    OutStream = GetBriefStream(StreamId);
+    return true;
+}
+
+FMissionBriefStream UMissionGeneratorSingleton::GetBriefStream(uint32 StreamId)
+{
+    checkf(StreamId > 0, TEXT("Mission brief stream 0 is reserved for the counter-based sequence"));
+    return FMissionBriefStream(GetStreamSeed().load(std::memory_order_relaxed), StreamId);
+}
+
+void UMissionGeneratorSingleton::SeedBriefStreams(int32 Seed)
+{
+    check(IsInGameThread());
+
+    GetStreamSeed().store(Seed, std::memory_order_relaxed);
+    NextStreamId.store(1, std::memory_order_relaxed);
+}
+
+FMissionBriefHandle UMissionGeneratorSingleton::PopNextMissionBrief()
+{
+    FMissionBriefPreGenerator& Ring = GetPreGenerator();
+    const int64 StallsBefore = Ring.GetStallCount();
+    const FMissionBriefHandle Handle = Ring.Pop();
+    if (Ring.GetStallCount() != StallsBefore)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("Mission brief ring empty (%lld stalls); generated synchronously"),
+            Ring.GetStallCount());
+    }
+
+    return Handle;
+}
+
+FMissionBrief UMissionGeneratorSingleton::GetNextMissionBrief()
+{
+    return NeonAscendantData::ExpandBrief(PopNextMissionBrief());
+}
+
+void UMissionGeneratorSingleton::WarmUpPreGeneration()
+{
+    GetPreGenerator();
+}
+
+void UMissionGeneratorSingleton::SeedPreGeneration(int32 Seed)
+{
+    StartPreGeneration(Seed);
+}
+
+int32 UMissionGeneratorSingleton::GetBufferedBriefCount()
+{
+    return PreGenerator ? PreGenerator->GetDepth() : 0;
+}
+
+int64 UMissionGeneratorSingleton::GetBufferStallCount()
+{
+    return PreGenerator ? PreGenerator->GetStallCount() : 0;
+}
+
+FMissionBriefPreGenerator& UMissionGeneratorSingleton::GetPreGenerator()
+{
+    if (!PreGenerator)
+    {
+        StartPreGeneration(GetGenerator()->GetSeed());
+    }
+
+    return *PreGenerator;
+}
+
+void UMissionGeneratorSingleton::StartPreGeneration(int32 Seed)
+{
+    // Destroying the old ring waits for its producer task
+    PreGenerator.Reset();
+
+    const UMissionGeneratorSingleton* Settings = GetDefault<UMissionGeneratorSingleton>();
+    PreGenerator = MakeUnique<FMissionBriefPreGenerator>(Seed, Settings->PreGeneratedBriefCapacity, Settings->PreGeneratedBriefRefillThreshold);
+    PreGenerator->RequestRefill();
+}
+
+bool UMissionGeneratorSingleton::ReloadMissionCatalog()
+{
+    // The producer task reads the tables, so it has to be stopped before they are replaced
+    const bool bWasPreGenerating = PreGenerator.IsValid();
+    const int32 PreGenerationSeed = bWasPreGenerating ? PreGenerator->GetSeed() : 0;
+    PreGenerator.Reset();
+
+    FString Error;
+    const bool bReloaded = NeonAscendantData::ReloadCatalog(Error);
+    if (!bReloaded)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Mission catalog reload failed, keeping the current catalog: %s"), *Error);
+    }
+
+    if (bWasPreGenerating)
+    {
+        StartPreGeneration(PreGenerationSeed);
+    }
+
+    return bReloaded;
+}
+
 void UMissionGeneratorSingleton::Shutdown()
 {
+    PreGenerator.Reset();
+
     if (GeneratorInstance)
     {
         GeneratorInstance->RemoveFromRoot();
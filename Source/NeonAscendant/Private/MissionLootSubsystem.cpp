@@ -0,0 +1,121 @@
+#include "MissionLootSubsystem.h"
+
+#include "MissionData.h"
+#include "MissionGenerator.h"
+#include "Misc/FileHelper.h"
+
+static_assert(static_cast<int32>(EExtractionOutcome::Premium) + 1 == static_cast<int32>(EMissionExtractionOutcome::Count),
+    "EExtractionOutcome must mirror EMissionExtractionOutcome");
+
+void UMissionLootSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    ReloadLootTables();
+    CatalogReloadedHandle = NeonAscendantData::OnCatalogReloaded().AddUObject(this, &UMissionLootSubsystem::HandleCatalogReloaded);
+}
+
+void UMissionLootSubsystem::Deinitialize()
+{
+    NeonAscendantData::OnCatalogReloaded().Remove(CatalogReloadedHandle);
+
+    Super::Deinitialize();
+}
+
+void UMissionLootSubsystem::HandleCatalogReloaded()
+{
+    // The reward grid is sized and indexed by the old catalog's factions and districts, so it
+    // cannot be kept when the rules no longer resolve
+    if (!ReloadLootTables())
+    {
+        Tables = FMissionLootTables();
+        UE_LOG(LogTemp, Warning, TEXT("UMissionLootSubsystem - loot tables do not match the reloaded mission catalog; extraction rewards are disabled"));
+    }
+}
+
+bool UMissionLootSubsystem::ReloadLootTables()
+{
+    const FString Path = FMissionLootTables::GetDefaultPath();
+
+    FString JsonText;
+    if (!FFileHelper::LoadFileToString(JsonText, *Path))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("UMissionLootSubsystem - could not read %s; extraction rewards are disabled"), *Path);
+        return false;
+    }
+
+    FString Error;
+    if (!Tables.LoadFromJson(JsonText, Error))
+    {
+        UE_LOG(LogTemp, Error, TEXT("UMissionLootSubsystem - %s: %s"), *Path, *Error);
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("UMissionLootSubsystem - loaded %d loot items from %s"), Tables.NumItems(), *Path);
+    return true;
+}
+
+void UMissionLootSubsystem::SetLootSeed(int32 Seed)
+{
+    LootSeed = Seed;
+    bHasLootSeed = true;
+}
+
+int32 UMissionLootSubsystem::GetLootSeed() const
+{
+    if (bHasLootSeed)
+    {
+        return LootSeed;
+    }
+
+    UMissionGenerator* Generator = UMissionGeneratorSingleton::GetGenerator();
+    return Generator ? Generator->GetSeed() : 0;
+}
+
+void UMissionLootSubsystem::RollSquadRewards(const FMissionBrief& Brief, EExtractionOutcome Outcome, int64 MissionIndex, int32 SquadSize, TArray<FMissionLootReward>& OutRewards) const
+{
+    FMissionBriefHandle Handle;
+    if (!NeonAscendantData::FindBriefHandle(Brief, Handle))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("UMissionLootSubsystem::RollSquadRewards - brief is not in the mission catalog"));
+        OutRewards.Reset();
+        return;
+    }
+
+    RollSquadRewardsForHandle(Handle, Outcome, MissionIndex, SquadSize, OutRewards);
+}
+
+void UMissionLootSubsystem::RollSquadRewardsForHandle(const FMissionBriefHandle& Brief, EExtractionOutcome Outcome, int64 MissionIndex, int32 SquadSize, TArray<FMissionLootReward>& OutRewards) const
+{
+    OutRewards.Reset();
+
+    const int32 Seed = GetLootSeed();
+    TArray<FMissionLootDrop, TInlineAllocator<16>> Drops;
+    for (int32 SquadSlot = 0; SquadSlot < FMath::Min(SquadSize, FMissionLootTables::MaxSquadSize); ++SquadSlot)
+    {
+        Drops.Reset();
+        Tables.Roll(Seed, MakeRequest(Brief, Outcome, MissionIndex, SquadSlot), Drops);
+        for (const FMissionLootDrop& Drop : Drops)
+        {
+            FMissionLootReward& Reward = OutRewards.AddDefaulted_GetRef();
+            Reward.Item = Tables.GetItemName(Drop.Item);
+            Reward.Quantity = Drop.Quantity;
+            Reward.SquadSlot = SquadSlot;
+        }
+    }
+}
+
+void UMissionLootSubsystem::RollBatch(TConstArrayView<FMissionLootRequest> Requests, TArray<FMissionLootDrop>& OutDrops, TArray<int32>& OutOffsets) const
+{
+    Tables.RollBatch(GetLootSeed(), Requests, OutDrops, OutOffsets);
+}
+
+FMissionLootRequest UMissionLootSubsystem::MakeRequest(const FMissionBriefHandle& Brief, EExtractionOutcome Outcome, int64 MissionIndex, int32 SquadSlot)
+{
+    FMissionLootRequest Request;
+    Request.RollIndex = FMissionLootTables::MakeRollIndex(MissionIndex, SquadSlot);
+    Request.Faction = Brief.FactionIndex;
+    Request.District = Brief.DistrictIndex;
+    Request.Outcome = static_cast<EMissionExtractionOutcome>(Outcome);
+    return Request;
+}
@@ -0,0 +1,603 @@
+#include "NeonAISubsystem.h"
+#include "NeonEnemy.h"
+#include "NeonCharacter.h"
+#include "NeonFlowFieldSubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "RenderCore.h"
+
+static TAutoConsoleVariable<int32> CVarNeonAIBatchedUpdate(
+	TEXT("ai.Neon.BatchedUpdate"),
+	1,
+	TEXT("1: update every enemy in one batched pass of UNeonAISubsystem. 0: per-actor enemy and controller ticks."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarNeonAIMaxTracesPerFrame(
+	TEXT("ai.Neon.MaxTracesPerFrame"),
+	32,
+	TEXT("Async visibility traces the batched AI pass may start per frame; enemies in detection range take turns."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarNeonAIMaxPathQueriesPerFrame(
+	TEXT("ai.Neon.MaxPathQueriesPerFrame"),
+	8,
+	TEXT("New enemy path queries allowed per frame; further moves wait for a later frame and keep their current path meanwhile."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarNeonAIFullTierDistance(
+	TEXT("ai.Neon.Significance.FullDistance"),
+	2500.0f,
+	TEXT("Enemies closer than this (cm) to the player get the full AI update rate."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarNeonAIReducedTierDistance(
+	TEXT("ai.Neon.Significance.ReducedDistance"),
+	6000.0f,
+	TEXT("Enemies closer than this (cm), or on screen, get at least the reduced AI update rate; the rest go dormant."),
+	ECVF_Default);
+
+static FAutoConsoleCommandWithWorld NeonAIReportCostCommand(
+	TEXT("ai.Neon.ReportCost"),
+	TEXT("Logs the measured per-enemy AI cost of the batched pass and of the per-actor ticks."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UNeonAISubsystem* AI = World ? World->GetSubsystem<UNeonAISubsystem>() : nullptr)
+		{
+			AI->ReportCost();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorld NeonAIResetCostCommand(
+	TEXT("ai.Neon.ResetCost"),
+	TEXT("Clears the AI cost counters of ai.Neon.ReportCost."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UNeonAISubsystem* AI = World ? World->GetSubsystem<UNeonAISubsystem>() : nullptr)
+		{
+			AI->ResetCost();
+		}
+	}));
+
+bool UNeonAISubsystem::IsBatchedUpdateEnabled()
+{
+	return CVarNeonAIBatchedUpdate.GetValueOnGameThread() != 0;
+}
+
+bool UNeonAISubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UNeonAISubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNeonAISubsystem, STATGROUP_Tickables);
+}
+
+void UNeonAISubsystem::Deinitialize()
+{
+	for (ANeonEnemy* Enemy : Enemies)
+	{
+		if (Enemy)
+		{
+			Enemy->BatchedAISlot = INDEX_NONE;
+		}
+	}
+	Enemies.Reset();
+	Controllers.Reset();
+	Targets.Reset();
+	Tunings.Reset();
+	AttackRangeSquared.Reset();
+	DetectionRangeSquared.Reset();
+	States.Reset();
+	StateEnterTimes.Reset();
+	NextFireTimes.Reset();
+	FireIntervals.Reset();
+	HealthRatios.Reset();
+	Tiers.Reset();
+	Phases.Reset();
+	NextDecisionTimes.Reset();
+	PendingPathRequests.Reset();
+	VisibilityCache.Reset();
+	AttackTokens.Reset();
+
+	Super::Deinitialize();
+}
+
+void UNeonAISubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// End to end: GGameThreadTime is the last frame's game-thread time, tick dispatch included
+	if (!bSkipFrameSample && Enemies.Num() > 0)
+	{
+		FFrameCost& Frames = bAppliedBatched ? BatchedFrames : LegacyFrames;
+		Frames.Seconds += FPlatformTime::ToSeconds(GGameThreadTime);
+		++Frames.Frames;
+		Frames.EnemyFrames += Enemies.Num();
+	}
+	bSkipFrameSample = false;
+
+	const bool bBatched = IsBatchedUpdateEnabled();
+	if (bBatched != bAppliedBatched)
+	{
+		ApplyTickMode(bBatched);
+		bSkipFrameSample = true;
+	}
+
+	// Both paths move through the same budget and fire through the same tokens
+	UpdatePathBudget(DeltaTime);
+	AttackTokens.Update(GetWorld()->GetTimeSeconds());
+
+	if (!bBatched)
+	{
+		LegacyEnemySeconds += DeltaTime * Enemies.Num();
+		return;
+	}
+
+	BatchedEnemySeconds += DeltaTime * Enemies.Num();
+
+	if (Enemies.Num() == 0)
+	{
+		return;
+	}
+
+	const double PassStart = FPlatformTime::Seconds();
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// Positions and traces every frame, so decisions read line of sight from the last frame or two
+	GatherPositions();
+	SubmitVisibilityTraces();
+	UpdateFiring(Now);
+	UpdateDecisions(Now);
+
+	const double PassSeconds = FPlatformTime::Seconds() - PassStart;
+	BatchedCost.Seconds += PassSeconds;
+	BatchedCost.Updates += Enemies.Num();
+	WorstPassSeconds = FMath::Max(WorstPassSeconds, PassSeconds);
+}
+
+void UNeonAISubsystem::GatherPositions()
+{
+	const int32 Count = Enemies.Num();
+	const int32 PaddedCount = Align(Count, 4);
+
+	for (TArray<float>* Array : { &PositionX, &PositionY, &PositionZ, &TargetX, &TargetY, &TargetZ, &DistanceSquared })
+	{
+		Array->SetNumUninitialized(PaddedCount, EAllowShrinking::No);
+	}
+
+	for (int32 Slot = 0; Slot < Count; ++Slot)
+	{
+		const FVector Location = Enemies[Slot]->GetActorLocation();
+		// No target: far enough to be out of every range
+		const FVector TargetLocation = Targets[Slot] ? Targets[Slot]->GetActorLocation() : Location + FVector(UE_LARGE_WORLD_MAX, 0.0, 0.0);
+		PositionX[Slot] = static_cast<float>(Location.X);
+		PositionY[Slot] = static_cast<float>(Location.Y);
+		PositionZ[Slot] = static_cast<float>(Location.Z);
+		TargetX[Slot] = static_cast<float>(TargetLocation.X);
+		TargetY[Slot] = static_cast<float>(TargetLocation.Y);
+		TargetZ[Slot] = static_cast<float>(TargetLocation.Z);
+	}
+	for (int32 Slot = Count; Slot < PaddedCount; ++Slot)
+	{
+		PositionX[Slot] = PositionY[Slot] = PositionZ[Slot] = 0.0f;
+		TargetX[Slot] = TargetY[Slot] = TargetZ[Slot] = 0.0f;
+	}
+
+	// Squared distance to the target, four enemies per instruction
+	for (int32 Base = 0; Base < PaddedCount; Base += 4)
+	{
+		const VectorRegister4Float DeltaX = VectorSubtract(VectorLoad(&PositionX[Base]), VectorLoad(&TargetX[Base]));
+		const VectorRegister4Float DeltaY = VectorSubtract(VectorLoad(&PositionY[Base]), VectorLoad(&TargetY[Base]));
+		const VectorRegister4Float DeltaZ = VectorSubtract(VectorLoad(&PositionZ[Base]), VectorLoad(&TargetZ[Base]));
+		VectorStore(VectorMultiplyAdd(DeltaX, DeltaX, VectorMultiplyAdd(DeltaY, DeltaY, VectorMultiply(DeltaZ, DeltaZ))), &DistanceSquared[Base]);
+	}
+}
+
+void UNeonAISubsystem::SubmitVisibilityTraces()
+{
+	// Round robin from where the last frame stopped, so a capped budget still reaches everyone
+	const int32 Count = Enemies.Num();
+	const int32 Budget = FMath::Max(0, CVarNeonAIMaxTracesPerFrame.GetValueOnGameThread());
+	int32 Submitted = 0;
+	int32 Visited = 0;
+	for (; Visited < Count && Submitted < Budget; ++Visited)
+	{
+		const int32 Slot = (TraceCursor + Visited) % Count;
+		if (Controllers[Slot] && Tiers[Slot] != ENeonAITier::Dormant && HealthRatios[Slot] > 0.0f && DistanceSquared[Slot] < DetectionRangeSquared[Slot]
+			&& Controllers[Slot]->RequestVisibilityTrace())
+		{
+			++Submitted;
+		}
+	}
+	TraceCursor = Count > 0 ? (TraceCursor + Visited) % Count : 0;
+
+	VisibilityTraces += Submitted;
+	++TraceFrames;
+}
+
+void UNeonAISubsystem::UpdatePathBudget(float DeltaTime)
+{
+	ElapsedSeconds += DeltaTime;
+	PathWindowSeconds += DeltaTime;
+	if (PathWindowSeconds >= 1.0f)
+	{
+		PathQueriesPerSecond = PathQueriesThisSecond;
+		PathQueriesThisSecond = 0;
+		PathWindowSeconds = FMath::Fmod(PathWindowSeconds, 1.0f);
+	}
+
+	PathQueriesThisFrame = 0;
+	const int32 Budget = CVarNeonAIMaxPathQueriesPerFrame.GetValueOnGameThread();
+
+	int32 Flushed = 0;
+	while (Flushed < PendingPathRequests.Num() && PathQueriesThisFrame < Budget)
+	{
+		ANeonEnemyController* Controller = PendingPathRequests[Flushed++].Get();
+		if (Controller && Controller->FlushPendingMove())
+		{
+			CountPathQuery();
+		}
+	}
+	PendingPathRequests.RemoveAt(0, Flushed, EAllowShrinking::No);
+}
+
+bool UNeonAISubsystem::TryConsumePathQuery()
+{
+	if (PathQueriesThisFrame >= CVarNeonAIMaxPathQueriesPerFrame.GetValueOnGameThread())
+	{
+		return false;
+	}
+
+	CountPathQuery();
+	return true;
+}
+
+void UNeonAISubsystem::CountPathQuery()
+{
+	++PathQueriesThisFrame;
+	++PathQueriesThisSecond;
+	++PathQueries;
+}
+
+void UNeonAISubsystem::QueuePathRequest(ANeonEnemyController* Controller)
+{
+	PendingPathRequests.Add(Controller);
+	++PathRequestsDeferred;
+}
+
+void UNeonAISubsystem::UpdateFiring(double Now)
+{
+	// Commands can run gameplay code, so the count is re-read every iteration
+	for (int32 Slot = 0; Slot < Enemies.Num(); ++Slot)
+	{
+		if (Tiers[Slot] == ENeonAITier::Dormant || HealthRatios[Slot] <= 0.0f || DistanceSquared[Slot] >= AttackRangeSquared[Slot])
+		{
+			continue;
+		}
+
+		// Every enemy in range competes for a token, whether or not it could fire this frame
+		ANeonEnemy* Enemy = Enemies[Slot];
+		const float Priority = FNeonAttackTokens::ComputePriority(
+			FMath::Sqrt(DistanceSquared[Slot]),
+			Enemy->AttackRange,
+			Controllers[Slot] && Controllers[Slot]->HasLineOfSight(),
+			Now - Enemy->LastFireTime);
+		if (AttackTokens.Request(Enemy, Targets[Slot], Priority) && Now >= NextFireTimes[Slot])
+		{
+			NextFireTimes[Slot] = Now + FireIntervals[Slot];
+			Enemy->FireAt(FVector(TargetX[Slot], TargetY[Slot], TargetZ[Slot]));
+		}
+	}
+}
+
+void UNeonAISubsystem::UpdateDecisions(double Now)
+{
+	for (int32 Slot = 0; Slot < Enemies.Num(); ++Slot)
+	{
+		if (Now < NextDecisionTimes[Slot])
+		{
+			continue;
+		}
+
+		// Tiers are re-evaluated on the enemy's own schedule, so this is staggered as well
+		SetTier(Slot, ComputeTier(Slot), Now);
+		const double Interval = TierDecisionIntervals[static_cast<int32>(Tiers[Slot])];
+		NextDecisionTimes[Slot] += Interval;
+		if (NextDecisionTimes[Slot] <= Now)
+		{
+			// Fell behind (hitch or promotion); keep the phase from here on
+			NextDecisionTimes[Slot] = Now + Interval;
+		}
+		++Decisions;
+
+		ANeonEnemyController* Controller = Controllers[Slot];
+		if (!Controller)
+		{
+			// Possessed after registering
+			Controller = Enemies[Slot]->GetEnemyController();
+			if (!Controller)
+			{
+				continue;
+			}
+			Controllers[Slot] = Controller;
+			Tunings[Slot] = Controller->GetTuning();
+			DetectionRangeSquared[Slot] = FMath::Square(Tunings[Slot].DetectionRange);
+			Controller->SetActorTickEnabled(false);
+		}
+
+		Controller->RefreshTarget();
+		if (Controller->GetTarget() != Targets[Slot])
+		{
+			Targets[Slot] = Controller->GetTarget();
+			DistanceSquared[Slot] = Targets[Slot] ? FVector::DistSquared(Enemies[Slot]->GetActorLocation(), Targets[Slot]->GetActorLocation()) : UE_BIG_NUMBER;
+		}
+
+		if (HealthRatios[Slot] <= 0.0f || !Targets[Slot])
+		{
+			if (States[Slot] != EEnemyAIState::Dead)
+			{
+				Controller->ApplyDecision(EEnemyAIState::Dead, false);
+			}
+			continue;
+		}
+
+		FEnemyAIPerception Perception;
+		Perception.DistanceToPlayer = FMath::Sqrt(DistanceSquared[Slot]);
+		Perception.bCanSeePlayer = DistanceSquared[Slot] < DetectionRangeSquared[Slot] && Controller->HasLineOfSight();
+		Perception.HealthRatio = HealthRatios[Slot];
+		Perception.TimeInState = static_cast<float>(Now - StateEnterTimes[Slot]);
+
+		Controller->ApplyDecision(ANeonEnemyController::DecideState(States[Slot], Perception, Tunings[Slot]), Perception.bCanSeePlayer);
+	}
+}
+
+ENeonAITier UNeonAISubsystem::ComputeTier(int32 Slot) const
+{
+	const EEnemyAIState State = States[Slot];
+	if (State == EEnemyAIState::Engaged || State == EEnemyAIState::Retreat)
+	{
+		return ENeonAITier::Full;
+	}
+
+	const float FullDistanceSquared = FMath::Square(CVarNeonAIFullTierDistance.GetValueOnGameThread());
+	const float ReducedDistanceSquared = FMath::Square(CVarNeonAIReducedTierDistance.GetValueOnGameThread());
+	const bool bOnScreen = Enemies[Slot]->WasRecentlyRendered(0.25f);
+
+	if (DistanceSquared[Slot] < FullDistanceSquared && (bOnScreen || DistanceSquared[Slot] < AttackRangeSquared[Slot] * 4.0f))
+	{
+		return ENeonAITier::Full;
+	}
+	if (State == EEnemyAIState::Investigate || bOnScreen || DistanceSquared[Slot] < ReducedDistanceSquared)
+	{
+		return ENeonAITier::Reduced;
+	}
+	return ENeonAITier::Dormant;
+}
+
+void UNeonAISubsystem::SetTier(int32 Slot, ENeonAITier Tier, double Now)
+{
+	if (Tiers[Slot] == Tier)
+	{
+		return;
+	}
+
+	// A promotion takes effect within the new interval, at the enemy's phase
+	Tiers[Slot] = Tier;
+	NextDecisionTimes[Slot] = FMath::Min(NextDecisionTimes[Slot], Now + Phases[Slot] * TierDecisionIntervals[static_cast<int32>(Tier)]);
+}
+
+ENeonAITier UNeonAISubsystem::GetTier(const ANeonEnemy* Enemy) const
+{
+	return Enemy && Tiers.IsValidIndex(Enemy->BatchedAISlot) ? Tiers[Enemy->BatchedAISlot] : ENeonAITier::Dormant;
+}
+
+void UNeonAISubsystem::RegisterEnemy(ANeonEnemy* Enemy)
+{
+	if (!Enemy || Enemy->BatchedAISlot != INDEX_NONE)
+	{
+		return;
+	}
+
+	if (Enemies.Num() == 0)
+	{
+		bAppliedBatched = IsBatchedUpdateEnabled();
+	}
+
+	ANeonEnemyController* Controller = Enemy->GetEnemyController();
+
+	Enemy->BatchedAISlot = Enemies.Num();
+	Enemies.Add(Enemy);
+	Controllers.Add(Controller);
+	Targets.Add(Enemy->TargetPlayer);
+	Tunings.Add(Controller ? Controller->GetTuning() : FEnemyAITuning());
+	AttackRangeSquared.Add(FMath::Square(Enemy->AttackRange));
+	DetectionRangeSquared.Add(FMath::Square(Tunings.Last().DetectionRange));
+	States.Add(Controller ? Controller->GetAIState() : EEnemyAIState::Patrol);
+	StateEnterTimes.Add(GetWorld()->GetTimeSeconds());
+	NextFireTimes.Add(0.0);
+	FireIntervals.Add(FMath::CeilToFloat(Enemy->FireInterval / FireCheckInterval - KINDA_SMALL_NUMBER) * FireCheckInterval);
+	HealthRatios.Add(Enemy->MaxHealth > 0.0f ? Enemy->CurrentHealth / Enemy->MaxHealth : 0.0f);
+
+	// New enemies start at full rate and settle into their tier at their first decision
+	const float Phase = FMath::Frac(PhaseCounter++ * 0.618034f);
+	Tiers.Add(ENeonAITier::Full);
+	Phases.Add(Phase);
+	NextDecisionTimes.Add(GetWorld()->GetTimeSeconds() + Phase * TierDecisionIntervals[static_cast<int32>(ENeonAITier::Full)]);
+
+	Enemy->SetActorTickEnabled(!bAppliedBatched);
+	if (Controller)
+	{
+		Controller->SetActorTickEnabled(!bAppliedBatched);
+	}
+}
+
+void UNeonAISubsystem::UnregisterEnemy(ANeonEnemy* Enemy)
+{
+	if (!Enemy || !Enemies.IsValidIndex(Enemy->BatchedAISlot) || Enemies[Enemy->BatchedAISlot] != Enemy)
+	{
+		return;
+	}
+
+	RemoveSlot(Enemy->BatchedAISlot);
+	Enemy->BatchedAISlot = INDEX_NONE;
+	VisibilityCache.Forget(Enemy);
+}
+
+void UNeonAISubsystem::RemoveSlot(int32 Slot)
+{
+	Enemies.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	Controllers.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	Targets.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	Tunings.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	AttackRangeSquared.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	DetectionRangeSquared.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	States.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	StateEnterTimes.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	NextFireTimes.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	FireIntervals.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	HealthRatios.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	Tiers.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	Phases.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+	NextDecisionTimes.RemoveAtSwap(Slot, 1, EAllowShrinking::No);
+
+	// The last enemy moved into the hole
+	if (Enemies.IsValidIndex(Slot) && Enemies[Slot])
+	{
+		Enemies[Slot]->BatchedAISlot = Slot;
+	}
+}
+
+void UNeonAISubsystem::SetHealthRatio(const ANeonEnemy* Enemy, float HealthRatio)
+{
+	if (Enemy && HealthRatios.IsValidIndex(Enemy->BatchedAISlot))
+	{
+		HealthRatios[Enemy->BatchedAISlot] = HealthRatio;
+
+		// Whoever is being shot matters now
+		SetTier(Enemy->BatchedAISlot, ENeonAITier::Full, GetWorld()->GetTimeSeconds());
+	}
+}
+
+void UNeonAISubsystem::OnAIStateChanged(const ANeonEnemy* Enemy, EEnemyAIState NewState, double Time)
+{
+	if (Enemy && States.IsValidIndex(Enemy->BatchedAISlot))
+	{
+		States[Enemy->BatchedAISlot] = NewState;
+		StateEnterTimes[Enemy->BatchedAISlot] = Time;
+
+		if (NewState == EEnemyAIState::Engaged || NewState == EEnemyAIState::Retreat)
+		{
+			SetTier(Enemy->BatchedAISlot, ENeonAITier::Full, Time);
+		}
+	}
+}
+
+void UNeonAISubsystem::ApplyTickMode(bool bBatched)
+{
+	bAppliedBatched = bBatched;
+	for (int32 Slot = 0; Slot < Enemies.Num(); ++Slot)
+	{
+		Enemies[Slot]->SetActorTickEnabled(!bBatched);
+		if (Controllers[Slot])
+		{
+			Controllers[Slot]->SetActorTickEnabled(!bBatched);
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("UNeonAISubsystem - %s AI update for %d enemies"), bBatched ? TEXT("batched") : TEXT("per-actor"), Enemies.Num());
+}
+
+void UNeonAISubsystem::AddLegacyTickCost(bool bController, double Seconds)
+{
+	FCostCounter& Counter = bController ? ControllerTickCost : EnemyTickCost;
+	Counter.Seconds += Seconds;
+	++Counter.Updates;
+}
+
+void UNeonAISubsystem::ReportCost() const
+{
+	// Time inside the AI code per enemy per second of game time, so both paths are compared at
+	// their own cadence. The per-actor figures exclude the tick dispatch itself, which is most of
+	// what batching saves; the game-thread frame times at the end include it.
+	auto PerEnemySecond = [](double Seconds, double EnemySeconds)
+	{
+		return EnemySeconds > 0.0 ? Seconds * 1e6 / EnemySeconds : 0.0;
+	};
+	auto PerUpdate = [](const FCostCounter& Counter)
+	{
+		return Counter.Updates > 0 ? Counter.Seconds * 1e6 / Counter.Updates : 0.0;
+	};
+
+	UE_LOG(LogTemp, Log, TEXT("UNeonAISubsystem - %d enemies, %s update"), Enemies.Num(), bAppliedBatched ? TEXT("batched") : TEXT("per-actor"));
+	UE_LOG(LogTemp, Log, TEXT("  Batched:   %.2f us per enemy-second (%.2f us per enemy per pass, %lld enemy updates)"),
+		PerEnemySecond(BatchedCost.Seconds, BatchedEnemySeconds), PerUpdate(BatchedCost), BatchedCost.Updates);
+	int32 TierCounts[static_cast<int32>(ENeonAITier::Count)] = {};
+	for (const ENeonAITier Tier : Tiers)
+	{
+		++TierCounts[static_cast<int32>(Tier)];
+	}
+	UE_LOG(LogTemp, Log, TEXT("  Tiers: %d full, %d reduced, %d dormant; %.1f decisions per pass, worst pass %.1f us"),
+		TierCounts[0], TierCounts[1], TierCounts[2], TraceFrames > 0 ? static_cast<double>(Decisions) / TraceFrames : 0.0, WorstPassSeconds * 1e6);
+	UE_LOG(LogTemp, Log, TEXT("  Visibility traces: %.1f per frame (cap %d)"),
+		TraceFrames > 0 ? static_cast<double>(VisibilityTraces) / TraceFrames : 0.0, CVarNeonAIMaxTracesPerFrame.GetValueOnGameThread());
+	const int64 CacheLookups = VisibilityCache.GetHits() + VisibilityCache.GetMisses();
+	UE_LOG(LogTemp, Log, TEXT("  Visibility cache: %lld hits, %lld misses (%.0f%% of traces saved)"),
+		VisibilityCache.GetHits(), VisibilityCache.GetMisses(), CacheLookups > 0 ? 100.0 * VisibilityCache.GetHits() / CacheLookups : 0.0);
+	UE_LOG(LogTemp, Log, TEXT("  Path queries: %d in the last second, %.1f per second overall; %lld moves kept their path, %lld waited for budget (cap %d per frame)"),
+		PathQueriesPerSecond, ElapsedSeconds > 0.0 ? PathQueries / ElapsedSeconds : 0.0, PathRequestsReused, PathRequestsDeferred, CVarNeonAIMaxPathQueriesPerFrame.GetValueOnGameThread());
+	UE_LOG(LogTemp, Log, TEXT("  Attack tokens: %d held over %d targets; %lld handovers in %lld reassignments"),
+		AttackTokens.NumHolders(), AttackTokens.NumTargets(), AttackTokens.GetHandovers(), AttackTokens.GetReassignments());
+	if (const UNeonFlowFieldSubsystem* Flow = GetWorld()->GetSubsystem<UNeonFlowFieldSubsystem>())
+	{
+		UE_LOG(LogTemp, Log, TEXT("  Flow fields: %d steering %d enemies; %lld builds, %lld cells expanded"),
+			Flow->NumFields(), Flow->NumFollowers(), Flow->GetBuilds(), Flow->GetCellsExpanded());
+	}
+	UE_LOG(LogTemp, Log, TEXT("  Per-actor: %.2f us per enemy-second (enemy tick %.2f us, controller tick %.2f us)"),
+		PerEnemySecond(EnemyTickCost.Seconds + ControllerTickCost.Seconds, LegacyEnemySeconds), PerUpdate(EnemyTickCost), PerUpdate(ControllerTickCost));
+
+	// Only comparable at the same enemy count and scene, so toggle ai.Neon.BatchedUpdate in place
+	auto LogFrames = [](const TCHAR* Name, const FFrameCost& Frames)
+	{
+		if (Frames.Frames > 0)
+		{
+			UE_LOG(LogTemp, Log, TEXT("  Game thread, %s: %.3f ms per frame at %.1f enemies (%lld frames)"),
+				Name, Frames.Seconds * 1e3 / Frames.Frames, static_cast<double>(Frames.EnemyFrames) / Frames.Frames, Frames.Frames);
+		}
+	};
+	LogFrames(TEXT("batched"), BatchedFrames);
+	LogFrames(TEXT("per-actor"), LegacyFrames);
+	if (BatchedFrames.Frames > 0 && LegacyFrames.Frames > 0)
+	{
+		const double EnemiesPerFrame = 0.5 * (static_cast<double>(BatchedFrames.EnemyFrames) / BatchedFrames.Frames + static_cast<double>(LegacyFrames.EnemyFrames) / LegacyFrames.Frames);
+		const double DeltaSeconds = LegacyFrames.Seconds / LegacyFrames.Frames - BatchedFrames.Seconds / BatchedFrames.Frames;
+		UE_LOG(LogTemp, Log, TEXT("  Game thread saved by batching: %.3f ms per frame, %.2f us per enemy per frame"),
+			DeltaSeconds * 1e3, EnemiesPerFrame > 0.0 ? DeltaSeconds * 1e6 / EnemiesPerFrame : 0.0);
+	}
+}
+
+void UNeonAISubsystem::ResetCost()
+{
+	BatchedCost = FCostCounter();
+	EnemyTickCost = FCostCounter();
+	ControllerTickCost = FCostCounter();
+	BatchedEnemySeconds = 0.0;
+	LegacyEnemySeconds = 0.0;
+	BatchedFrames = FFrameCost();
+	LegacyFrames = FFrameCost();
+	bSkipFrameSample = true;
+	VisibilityTraces = 0;
+	TraceFrames = 0;
+	VisibilityCache.ResetCounters();
+	AttackTokens.ResetCounters();
+	WorstPassSeconds = 0.0;
+	Decisions = 0;
+	PathQueries = 0;
+	PathRequestsReused = 0;
+	PathRequestsDeferred = 0;
+	ElapsedSeconds = 0.0;
+
+	if (UNeonFlowFieldSubsystem* Flow = GetWorld()->GetSubsystem<UNeonFlowFieldSubsystem>())
+	{
+		Flow->ResetCounters();
+	}
+}
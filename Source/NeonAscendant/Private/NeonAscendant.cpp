@@ -1,15 +1,66 @@
 #include "NeonAscendant.h"
+#include "MissionCatalog.h"
 #include "MissionGenerator.h"
 #include "Modules/ModuleManager.h"
+#include "Misc/Paths.h"
+
+#if WITH_EDITOR
+#include "DirectoryWatcherModule.h"
+#include "IDirectoryWatcher.h"
+#endif
 
 IMPLEMENT_PRIMARY_GAME_MODULE(FNeonAscendantModule, NeonAscendant, "NeonAscendant");
 
 void FNeonAscendantModule::StartupModule()
 {
+#if WITH_EDITOR
+	// Hot-reload the mission catalog when its JSON source is edited
+	if (GIsEditor)
+	{
+		FDirectoryWatcherModule& DirectoryWatcher = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+		if (IDirectoryWatcher* Watcher = DirectoryWatcher.Get())
+		{
+			CatalogWatchDirectory = FPaths::GetPath(FMissionCatalog::GetSourcePath());
+			Watcher->RegisterDirectoryChangedCallback_Handle(
+				CatalogWatchDirectory,
+				IDirectoryWatcher::FDirectoryChanged::CreateRaw(this, &FNeonAscendantModule::OnCatalogDirectoryChanged),
+				CatalogWatchHandle);
+		}
+	}
+#endif
 }
 
 void FNeonAscendantModule::ShutdownModule()
 {
+#if WITH_EDITOR
+	if (CatalogWatchHandle.IsValid())
+	{
+		if (FDirectoryWatcherModule* DirectoryWatcher = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")))
+		{
+			if (IDirectoryWatcher* Watcher = DirectoryWatcher->Get())
+			{
+				Watcher->UnregisterDirectoryChangedCallback_Handle(CatalogWatchDirectory, CatalogWatchHandle);
+			}
+		}
+		CatalogWatchHandle.Reset();
+	}
+#endif
+
 	// Clean up singleton instances
 	UMissionGeneratorSingleton::Shutdown();
 }
+
+#if WITH_EDITOR
+void FNeonAscendantModule::OnCatalogDirectoryChanged(const TArray<FFileChangeData>& Changes)
+{
+	const FString SourcePath = FPaths::ConvertRelativePathToFull(FMissionCatalog::GetSourcePath());
+	for (const FFileChangeData& Change : Changes)
+	{
+		if (FPaths::IsSamePath(FPaths::ConvertRelativePathToFull(Change.Filename), SourcePath))
+		{
+			UMissionGeneratorSingleton::ReloadMissionCatalog();
+			return;
+		}
+	}
+}
+#endif
@@ -0,0 +1,150 @@
+#include "NeonAttackTokens.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarNeonAttackTokensPerTarget(
+	TEXT("ai.Neon.AttackTokens.PerTarget"),
+	4,
+	TEXT("Enemies that may fire at one target at a time; 0 lets every enemy in range fire."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarNeonAttackTokensReassignInterval(
+	TEXT("ai.Neon.AttackTokens.ReassignInterval"),
+	0.5f,
+	TEXT("Seconds between handing each target's attack tokens to its highest-priority attackers."),
+	ECVF_Default);
+
+namespace
+{
+	// Priority given up by an attacker without line of sight, i.e. a whole attack range of distance
+	constexpr float NoLineOfSightPenalty = 1.0f;
+
+	// Waiting this long to shoot is worth half an attack range of distance
+	constexpr double WaitForFullBonus = 3.0;
+	constexpr float WaitBonus = 0.5f;
+
+	// Priority a current holder is favoured by
+	constexpr float HolderBonus = 0.25f;
+}
+
+int32 FNeonAttackTokens::GetTokensPerTarget()
+{
+	return FMath::Max(CVarNeonAttackTokensPerTarget.GetValueOnGameThread(), 0);
+}
+
+float FNeonAttackTokens::ComputePriority(float Distance, float AttackRange, bool bHasLineOfSight, double SecondsSinceShot)
+{
+	const float Wait = static_cast<float>(FMath::Min(SecondsSinceShot, WaitForFullBonus) / WaitForFullBonus);
+	return Distance / FMath::Max(AttackRange, 1.0f)
+		+ (bHasLineOfSight ? 0.0f : NoLineOfSightPenalty)
+		- Wait * WaitBonus;
+}
+
+bool FNeonAttackTokens::Request(const AActor* Attacker, const AActor* Target, float Priority)
+{
+	const int32 MaxTokens = CVarNeonAttackTokensPerTarget.GetValueOnGameThread();
+	if (MaxTokens <= 0)
+	{
+		return true;
+	}
+
+	const FObjectKey AttackerKey(Attacker);
+	FPool& Pool = Pools.FindOrAdd(FObjectKey(Target));
+	Pool.Candidates.Add(AttackerKey, Priority);
+
+	if (Pool.Holders.Contains(AttackerKey))
+	{
+		return true;
+	}
+	if (Pool.Holders.Num() < MaxTokens)
+	{
+		Pool.Holders.Add(AttackerKey);
+		++Handovers;
+		return true;
+	}
+	return false;
+}
+
+bool FNeonAttackTokens::HasToken(const AActor* Attacker, const AActor* Target) const
+{
+	if (CVarNeonAttackTokensPerTarget.GetValueOnGameThread() <= 0)
+	{
+		return true;
+	}
+
+	const FPool* Pool = Pools.Find(FObjectKey(Target));
+	return Pool && Pool->Holders.Contains(FObjectKey(Attacker));
+}
+
+void FNeonAttackTokens::Update(double Now)
+{
+	if (Now < NextReassignTime)
+	{
+		return;
+	}
+	NextReassignTime = Now + CVarNeonAttackTokensReassignInterval.GetValueOnGameThread();
+	++Reassignments;
+
+	const int32 MaxTokens = CVarNeonAttackTokensPerTarget.GetValueOnGameThread();
+	TArray<TPair<float, FObjectKey>, TInlineAllocator<32>> Ranked;
+
+	for (auto It = Pools.CreateIterator(); It; ++It)
+	{
+		FPool& Pool = It.Value();
+		if (Pool.Candidates.Num() == 0)
+		{
+			// Nobody in range asked since the last reassignment
+			It.RemoveCurrent();
+			continue;
+		}
+
+		Ranked.Reset();
+		for (const TPair<FObjectKey, float>& Candidate : Pool.Candidates)
+		{
+			const float Bonus = Pool.Holders.Contains(Candidate.Key) ? HolderBonus : 0.0f;
+			Ranked.Add(MakeTuple(Candidate.Value - Bonus, Candidate.Key));
+		}
+		Ranked.Sort([](const TPair<float, FObjectKey>& A, const TPair<float, FObjectKey>& B) { return A.Key < B.Key; });
+
+		const int32 NumHolders = MaxTokens > 0 ? FMath::Min(MaxTokens, Ranked.Num()) : 0;
+		for (int32 Rank = 0; Rank < NumHolders; ++Rank)
+		{
+			if (!Pool.Holders.Contains(Ranked[Rank].Value))
+			{
+				++Handovers;
+			}
+		}
+
+		Pool.Holders.Reset();
+		for (int32 Rank = 0; Rank < NumHolders; ++Rank)
+		{
+			Pool.Holders.Add(Ranked[Rank].Value);
+		}
+		Pool.Candidates.Reset();
+	}
+}
+
+void FNeonAttackTokens::Release(const AActor* Attacker)
+{
+	const FObjectKey AttackerKey(Attacker);
+	for (TPair<FObjectKey, FPool>& Pool : Pools)
+	{
+		Pool.Value.Holders.RemoveSingleSwap(AttackerKey, EAllowShrinking::No);
+		Pool.Value.Candidates.Remove(AttackerKey);
+	}
+}
+
+void FNeonAttackTokens::Reset()
+{
+	Pools.Reset();
+	NextReassignTime = 0.0;
+}
+
+int32 FNeonAttackTokens::NumHolders() const
+{
+	int32 Count = 0;
+	for (const TPair<FObjectKey, FPool>& Pool : Pools)
+	{
+		Count += Pool.Value.Holders.Num();
+	}
+	return Count;
+}
@@ -1,5 +1,7 @@
 #include "NeonCharacter.h"
 #include "NeonWeapon.h"
+#include "NeonSpatialGridSubsystem.h"
+#include "NeonAISubsystem.h"
 #include "Camera/CameraComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
@@ -52,6 +54,13 @@ void ANeonCharacter::BeginPlay()
 	CurrentHealth = MaxHealth;
 
 	UpdateCameraMode();
+	RefreshStatConsumers();
+
+	// Enemies pick their target among the registered players
+	if (UNeonSpatialGridSubsystem* Grid = GetWorld()->GetSubsystem<UNeonSpatialGridSubsystem>())
+	{
+		Grid->Register(this, ENeonSpatialCategory::Player);
+	}
 
 	// Equip starting weapon
 	if (StartingWeaponClass)
@@ -60,6 +69,22 @@ void ANeonCharacter::BeginPlay()
 	}
 }
 
+void ANeonCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UNeonSpatialGridSubsystem* Grid = GetWorld()->GetSubsystem<UNeonSpatialGridSubsystem>())
+	{
+		Grid->Unregister(this);
+	}
+
+	// Results with this player as the target would otherwise outlive it
+	if (UNeonAISubsystem* AI = GetWorld()->GetSubsystem<UNeonAISubsystem>())
+	{
+		AI->GetVisibilityCache().Forget(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void ANeonCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 {
 	Super::SetupPlayerInputComponent(PlayerInputComponent);
@@ -139,13 +164,13 @@ void ANeonCharacter::StopCrouch()
 void ANeonCharacter::StartSprint()
 {
 	bIsSprinting = true;
-	GetCharacterMovement()->MaxWalkSpeed = DefaultWalkSpeed * SprintSpeedMultiplier;
+	UpdateWalkSpeed();
 }
 
 void ANeonCharacter::StopSprint()
 {
 	bIsSprinting = false;
-	GetCharacterMovement()->MaxWalkSpeed = DefaultWalkSpeed;
+	UpdateWalkSpeed();
 }
 
 void ANeonCharacter::Fire()
@@ -198,6 +223,8 @@ void ANeonCharacter::EquipWeapon(TSubclassOf<ANeonWeapon> WeaponClass)
 
 	if (CurrentWeapon)
 	{
+		CurrentWeapon->SetDamageMultiplier(Stats.GetMultiplier(EMissionStat::WeaponDamage));
+
 		// Attach to character mesh
 		FName WeaponSocket = TEXT("hand_rSocket");
 		if (GetMesh()->DoesSocketExist(WeaponSocket))
@@ -213,6 +240,56 @@ void ANeonCharacter::EquipWeapon(TSubclassOf<ANeonWeapon> WeaponClass)
 	}
 }
 
+void ANeonCharacter::EquipImplant(int32 ImplantIndex)
+{
+	static const FName ImplantSource(TEXT("Implant"));
+
+	EquippedImplant = ImplantIndex;
+	if (ImplantIndex == INDEX_NONE)
+	{
+		Stats.RemoveSource(ImplantSource);
+	}
+	else
+	{
+		Stats.SetSource(ImplantSource, FMissionImplantModifiers::Get().GetModifiers(ImplantIndex));
+	}
+	RefreshStatConsumers();
+}
+
+void ANeonCharacter::SetStatModifiers(FName Source, TConstArrayView<FMissionModifier> Modifiers)
+{
+	Stats.SetSource(Source, Modifiers);
+	RefreshStatConsumers();
+}
+
+void ANeonCharacter::RemoveStatModifiers(FName Source)
+{
+	Stats.RemoveSource(Source);
+	RefreshStatConsumers();
+}
+
+void ANeonCharacter::RefreshStatConsumers()
+{
+	if (AppliedStatRevision == Stats.GetRevision())
+	{
+		return;
+	}
+	AppliedStatRevision = Stats.GetRevision();
+
+	UpdateWalkSpeed();
+	if (CurrentWeapon)
+	{
+		CurrentWeapon->SetDamageMultiplier(Stats.GetMultiplier(EMissionStat::WeaponDamage));
+	}
+}
+
+void ANeonCharacter::UpdateWalkSpeed()
+{
+	const float WalkSpeed = Stats.Apply(EMissionStat::MovementSpeed, DefaultWalkSpeed);
+	GetCharacterMovement()->MaxWalkSpeed = bIsSprinting ? WalkSpeed * SprintSpeedMultiplier : WalkSpeed;
+	GetCharacterMovement()->MaxWalkSpeedCrouched = WalkSpeed * CrouchSpeedMultiplier;
+}
+
 void ANeonCharacter::UpdateCameraMode()
 {
 	if (bUseFirstPerson)
@@ -253,6 +330,12 @@ void ANeonCharacter::Die()
 {
 	UE_LOG(LogTemp, Log, TEXT("Player died!"));
 
+	// No longer a target
+	if (UNeonSpatialGridSubsystem* Grid = GetWorld()->GetSubsystem<UNeonSpatialGridSubsystem>())
+	{
+		Grid->Unregister(this);
+	}
+
 	// Disable input
 	if (Controller)
 	{
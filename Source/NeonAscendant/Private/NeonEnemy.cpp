@@ -2,9 +2,12 @@
 #include "NeonCharacter.h"
 #include "NeonWeapon.h"
 #include "NeonEnemyController.h"
+#include "NeonAISubsystem.h"
+#include "NeonSpatialGridSubsystem.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Kismet/GameplayStatics.h"
+#include "Misc/ScopeExit.h"
 
 ANeonEnemy::ANeonEnemy()
 {
@@ -45,10 +48,46 @@ void ANeonEnemy::BeginPlay()
 
 	// Equip weapon
 	EquipWeapon();
+
+	if (UNeonSpatialGridSubsystem* Grid = GetWorld()->GetSubsystem<UNeonSpatialGridSubsystem>())
+	{
+		Grid->Register(this, ENeonSpatialCategory::Enemy);
+	}
+
+	if (UNeonAISubsystem* AI = GetWorld()->GetSubsystem<UNeonAISubsystem>())
+	{
+		AI->RegisterEnemy(this);
+	}
+}
+
+void ANeonEnemy::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UNeonSpatialGridSubsystem* Grid = GetWorld()->GetSubsystem<UNeonSpatialGridSubsystem>())
+	{
+		Grid->Unregister(this);
+	}
+
+	if (UNeonAISubsystem* AI = GetWorld()->GetSubsystem<UNeonAISubsystem>())
+	{
+		AI->UnregisterEnemy(this);
+		AI->GetAttackTokens().Release(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void ANeonEnemy::Tick(float DeltaTime)
 {
+	// Only runs with ai.Neon.BatchedUpdate 0; UNeonAISubsystem does this for every enemy otherwise
+	const double TickStart = FPlatformTime::Seconds();
+	ON_SCOPE_EXIT
+	{
+		if (UNeonAISubsystem* AI = GetWorld()->GetSubsystem<UNeonAISubsystem>())
+		{
+			AI->AddLegacyTickCost(false, FPlatformTime::Seconds() - TickStart);
+		}
+	};
+
 	Super::Tick(DeltaTime);
 
 	if (bIsDead || !TargetPlayer)
@@ -59,17 +98,37 @@ void ANeonEnemy::Tick(float DeltaTime)
 	// Simple proximity-based firing for now
 	// The AI controller will handle movement
 	float DistanceToPlayer = FVector::Dist(GetActorLocation(), TargetPlayer->GetActorLocation());
-	if (DistanceToPlayer < AttackRange && GetWorld()->GetTimeSeconds() - LastFireTime > FireInterval)
+	if (DistanceToPlayer >= AttackRange)
+	{
+		return;
+	}
+
+	// Only token holders fire; see FNeonAttackTokens
+	const double Now = GetWorld()->GetTimeSeconds();
+	bool bHasToken = true;
+	if (UNeonAISubsystem* AI = GetWorld()->GetSubsystem<UNeonAISubsystem>())
 	{
-		// Face the player
-		FVector DirectionToPlayer = (TargetPlayer->GetActorLocation() - GetActorLocation()).GetSafeNormal();
-		FRotator LookRotation = DirectionToPlayer.Rotation();
-		SetActorRotation(FRotator(0.0f, LookRotation.Yaw, 0.0f));
+		const ANeonEnemyController* EnemyController = GetEnemyController();
+		const float Priority = FNeonAttackTokens::ComputePriority(DistanceToPlayer, AttackRange, EnemyController && EnemyController->HasLineOfSight(), Now - LastFireTime);
+		bHasToken = AI->GetAttackTokens().Request(this, TargetPlayer, Priority);
+	}
 
-		FireWeapon();
+	if (bHasToken && Now - LastFireTime > FireInterval)
+	{
+		FireAt(TargetPlayer->GetActorLocation());
 	}
 }
 
+void ANeonEnemy::FireAt(const FVector& TargetLocation)
+{
+	// Face the target
+	FVector DirectionToTarget = (TargetLocation - GetActorLocation()).GetSafeNormal();
+	FRotator LookRotation = DirectionToTarget.Rotation();
+	SetActorRotation(FRotator(0.0f, LookRotation.Yaw, 0.0f));
+
+	FireWeapon();
+}
+
 float ANeonEnemy::TakeDamage(float Damage, const FDamageEvent& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
 {
 	const float ActualDamage = Super::TakeDamage(Damage, DamageEvent, EventInstigator, DamageCauser);
@@ -83,6 +142,12 @@ float ANeonEnemy::TakeDamage(float Damage, const FDamageEvent& DamageEvent, ACon
 	UE_LOG(LogTemp, Log, TEXT("ANeonEnemy took %.0f damage. Health: %.0f/%.0f"),
 		ActualDamage, CurrentHealth, MaxHealth);
 
+	if (UNeonAISubsystem* AI = GetWorld()->GetSubsystem<UNeonAISubsystem>())
+	{
+		AI->SetHealthRatio(this, MaxHealth > 0.0f ? FMath::Max(CurrentHealth, 0.0f) / MaxHealth : 0.0f);
+		AI->GetVisibilityCache().Invalidate(this);
+	}
+
 	// Notify AI controller of damage
 	ANeonEnemyController* EnemyController = GetEnemyController();
 	if (EnemyController && TargetPlayer)
@@ -108,6 +173,17 @@ void ANeonEnemy::Die()
 	bIsDead = true;
 	CurrentHealth = 0.0f;
 
+	if (UNeonAISubsystem* AI = GetWorld()->GetSubsystem<UNeonAISubsystem>())
+	{
+		AI->SetHealthRatio(this, 0.0f);
+		AI->GetAttackTokens().Release(this);
+	}
+
+	if (UNeonSpatialGridSubsystem* Grid = GetWorld()->GetSubsystem<UNeonSpatialGridSubsystem>())
+	{
+		Grid->Unregister(this);
+	}
+
 	UE_LOG(LogTemp, Log, TEXT("ANeonEnemy died"));
 
 	// Drop weapon
@@ -1,14 +1,24 @@
 #include "NeonEnemyController.h"
 #include "NeonEnemy.h"
 #include "NeonCharacter.h"
+#include "NeonAISubsystem.h"
+#include "NeonSpatialGridSubsystem.h"
+#include "NeonFlowFieldSubsystem.h"
 #include "Navigation/CrowdFollowingComponent.h"
+#include "Navigation/PathFollowingComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "Misc/ScopeExit.h"
+
+// How close a chase gets to the player
+static constexpr float EngagedAcceptanceRadius = 100.0f;
 
 ANeonEnemyController::ANeonEnemyController()
 {
 	PrimaryActorTick.TickInterval = 0.2f;
+
+	VisibilityTraceDelegate.BindUObject(this, &ANeonEnemyController::OnVisibilityTraceDone);
 }
 
 void ANeonEnemyController::BeginPlay()
@@ -31,10 +41,22 @@ void ANeonEnemyController::BeginPlay()
 	// Start in patrol state
 	ChangeAIState(EEnemyAIState::Patrol);
 	CurrentPatrolTarget = GetRandomPatrolPoint();
+
+	// UNeonAISubsystem decides for this controller unless ai.Neon.BatchedUpdate is 0
+	SetActorTickEnabled(!UNeonAISubsystem::IsBatchedUpdateEnabled());
 }
 
 void ANeonEnemyController::Tick(float DeltaTime)
 {
+	const double TickStart = FPlatformTime::Seconds();
+	ON_SCOPE_EXIT
+	{
+		if (UNeonAISubsystem* AI = GetWorld()->GetSubsystem<UNeonAISubsystem>())
+		{
+			AI->AddLegacyTickCost(true, FPlatformTime::Seconds() - TickStart);
+		}
+	};
+
 	Super::Tick(DeltaTime);
 
 	if (!EnemyCharacter || !PlayerCharacter || EnemyCharacter->bIsDead)
@@ -48,86 +70,151 @@ void ANeonEnemyController::Tick(float DeltaTime)
 
 void ANeonEnemyController::UpdateAIBehavior()
 {
-	// Check if we can see the target
-	float DistanceToPlayer = FVector::Dist(EnemyCharacter->GetActorLocation(), PlayerCharacter->GetActorLocation());
-	bool bCanSeePlayer = DistanceToPlayer < DetectionRange && CanSeeTarget();
-	bool bPlayerInAttackRange = IsTargetInRange();
+	RefreshTarget();
+	if (!PlayerCharacter)
+	{
+		return;
+	}
 
-	// State transitions
-	switch (CurrentAIState)
+	FEnemyAIPerception Perception;
+	Perception.DistanceToPlayer = FVector::Dist(EnemyCharacter->GetActorLocation(), PlayerCharacter->GetActorLocation());
+	Perception.bCanSeePlayer = Perception.DistanceToPlayer < DetectionRange && HasLineOfSight();
+	Perception.HealthRatio = EnemyCharacter->MaxHealth > 0.0f ? EnemyCharacter->CurrentHealth / EnemyCharacter->MaxHealth : 0.0f;
+	Perception.TimeInState = GetWorld()->GetTimeSeconds() - StateChangeTime;
+
+	// Read by the next decision
+	if (Perception.DistanceToPlayer < DetectionRange)
+	{
+		RequestVisibilityTrace();
+	}
+
+	ApplyDecision(DecideState(CurrentAIState, Perception, GetTuning()), Perception.bCanSeePlayer);
+}
+
+void ANeonEnemyController::RefreshTarget()
+{
+	UNeonSpatialGridSubsystem* Grid = GetWorld()->GetSubsystem<UNeonSpatialGridSubsystem>();
+	if (!EnemyCharacter || !Grid)
+	{
+		return;
+	}
+
+	const FVector Location = EnemyCharacter->GetActorLocation();
+	AActor* Nearest = Grid->FindNearest(Location, LostTargetDistance, ENeonSpatialCategory::Player);
+	if (!Nearest && (!PlayerCharacter || PlayerCharacter->GetHealth() <= 0.0f))
+	{
+		Nearest = Grid->FindNearest(Location, UNeonSpatialGridSubsystem::AnyDistance, ENeonSpatialCategory::Player);
+	}
+
+	ANeonCharacter* NewTarget = Cast<ANeonCharacter>(Nearest);
+	if (NewTarget && NewTarget != PlayerCharacter)
+	{
+		PlayerCharacter = NewTarget;
+		EnemyCharacter->TargetPlayer = NewTarget;
+
+		// Line of sight was to the previous target
+		bHasLineOfSight = false;
+	}
+}
+
+EEnemyAIState ANeonEnemyController::DecideState(EEnemyAIState CurrentState, const FEnemyAIPerception& Perception, const FEnemyAITuning& Tuning)
+{
+	switch (CurrentState)
 	{
 		case EEnemyAIState::Patrol:
 		{
-			if (bCanSeePlayer)
-			{
-				LastKnownPlayerLocation = PlayerCharacter->GetActorLocation();
-				ChangeAIState(EEnemyAIState::Engaged);
-			}
-			UpdatePatrolBehavior();
-			break;
+			return Perception.bCanSeePlayer ? EEnemyAIState::Engaged : EEnemyAIState::Patrol;
 		}
 
 		case EEnemyAIState::Investigate:
 		{
-			if (bCanSeePlayer)
-			{
-				LastKnownPlayerLocation = PlayerCharacter->GetActorLocation();
-				ChangeAIState(EEnemyAIState::Engaged);
-			}
-			else if (GetWorld()->GetTimeSeconds() - StateChangeTime > InvestigationDuration)
+			if (Perception.bCanSeePlayer)
 			{
-				// Investigation timeout - return to patrol
-				ChangeAIState(EEnemyAIState::Patrol);
+				return EEnemyAIState::Engaged;
 			}
-			UpdateInvestigateBehavior();
-			break;
+			// Investigation timeout - return to patrol
+			return Perception.TimeInState > Tuning.InvestigationDuration ? EEnemyAIState::Patrol : EEnemyAIState::Investigate;
 		}
 
 		case EEnemyAIState::Engaged:
 		{
-			if (bCanSeePlayer)
-			{
-				LastKnownPlayerLocation = PlayerCharacter->GetActorLocation();
-
-				// Check if should retreat
-				float HealthPercent = EnemyCharacter->CurrentHealth / EnemyCharacter->MaxHealth;
-				if (HealthPercent < RetreatHealthThreshold)
-				{
-					ChangeAIState(EEnemyAIState::Retreat);
-				}
-			}
-			else if (DistanceToPlayer > LostTargetDistance)
+			if (Perception.bCanSeePlayer)
 			{
-				// Lost target - investigate last known location
-				ChangeAIState(EEnemyAIState::Investigate);
+				return Perception.HealthRatio < Tuning.RetreatHealthThreshold ? EEnemyAIState::Retreat : EEnemyAIState::Engaged;
 			}
-			UpdateEngagedBehavior();
-			break;
+			// Lost target - investigate last known location
+			return Perception.DistanceToPlayer > Tuning.LostTargetDistance ? EEnemyAIState::Investigate : EEnemyAIState::Engaged;
 		}
 
 		case EEnemyAIState::Retreat:
 		{
-			// Check if health recovered enough or player lost
-			float HealthPercent = EnemyCharacter->CurrentHealth / EnemyCharacter->MaxHealth;
-			if (bCanSeePlayer && HealthPercent > RetreatHealthThreshold * 1.5f)
+			// Recovered - re-engage
+			if (Perception.bCanSeePlayer && Perception.HealthRatio > Tuning.RetreatHealthThreshold * 1.5f)
 			{
-				// Recovered - re-engage
-				ChangeAIState(EEnemyAIState::Engaged);
+				return EEnemyAIState::Engaged;
 			}
-			else if (!bCanSeePlayer && DistanceToPlayer > LostTargetDistance)
+			// Lost player while retreating - go back to patrol
+			if (!Perception.bCanSeePlayer && Perception.DistanceToPlayer > Tuning.LostTargetDistance)
 			{
-				// Lost player while retreating - go back to patrol
-				ChangeAIState(EEnemyAIState::Patrol);
+				return EEnemyAIState::Patrol;
 			}
+			return EEnemyAIState::Retreat;
+		}
+
+		default:
+		{
+			return CurrentState;
+		}
+	}
+}
+
+FEnemyAITuning ANeonEnemyController::GetTuning() const
+{
+	FEnemyAITuning Tuning;
+	Tuning.DetectionRange = DetectionRange;
+	Tuning.LostTargetDistance = LostTargetDistance;
+	Tuning.InvestigationDuration = InvestigationDuration;
+	Tuning.AttackRange = AttackRange;
+	Tuning.RetreatHealthThreshold = RetreatHealthThreshold;
+	return Tuning;
+}
+
+void ANeonEnemyController::ApplyDecision(EEnemyAIState NewState, bool bCanSeePlayer)
+{
+	if (bCanSeePlayer && PlayerCharacter)
+	{
+		LastKnownPlayerLocation = PlayerCharacter->GetActorLocation();
+	}
+
+	ChangeAIState(NewState);
+	UpdateStateBehavior();
+}
+
+void ANeonEnemyController::UpdateStateBehavior()
+{
+	switch (CurrentAIState)
+	{
+		case EEnemyAIState::Patrol:
+			UpdatePatrolBehavior();
+			break;
+
+		case EEnemyAIState::Investigate:
+			UpdateInvestigateBehavior();
+			break;
+
+		case EEnemyAIState::Engaged:
+			UpdateEngagedBehavior();
+			break;
+
+		case EEnemyAIState::Retreat:
 			UpdateRetreatBehavior();
 			break;
-		}
 
 		case EEnemyAIState::Dead:
-		{
 			StopMovement();
+			ActiveGoalActor.Reset();
+			bMovePending = false;
 			break;
-		}
 	}
 }
 
@@ -148,7 +235,7 @@ void ANeonEnemyController::UpdatePatrolBehavior()
 	}
 
 	EnemyCharacter->GetCharacterMovement()->MaxWalkSpeed = PatrolSpeed;
-	MoveToLocation(CurrentPatrolTarget, 100.0f);
+	RequestMove(nullptr, CurrentPatrolTarget, 100.0f);
 }
 
 void ANeonEnemyController::UpdateInvestigateBehavior()
@@ -160,7 +247,7 @@ void ANeonEnemyController::UpdateInvestigateBehavior()
 
 	// Move toward last known location
 	EnemyCharacter->GetCharacterMovement()->MaxWalkSpeed = PatrolSpeed * 1.5f;
-	MoveToLocation(LastKnownPlayerLocation, 100.0f);
+	RequestMove(nullptr, LastKnownPlayerLocation, 100.0f);
 }
 
 void ANeonEnemyController::UpdateEngagedBehavior()
@@ -170,14 +257,67 @@ void ANeonEnemyController::UpdateEngagedBehavior()
 		return;
 	}
 
-	// Move at combat speed toward player
 	EnemyCharacter->GetCharacterMovement()->MaxWalkSpeed = 800.0f;
-	MoveToActor(PlayerCharacter, 100.0f);
+
+	// In range without an attack token: take up position instead of crowding in
+	UNeonAISubsystem* AI = GetWorld()->GetSubsystem<UNeonAISubsystem>();
+	if (AI && IsTargetInRange() && !AI->GetAttackTokens().HasToken(EnemyCharacter, PlayerCharacter))
+	{
+		UpdatePositioningBehavior();
+		return;
+	}
+
+	// Move at combat speed toward player, along the player's shared flow field where it reaches
+	UNeonFlowFieldSubsystem* Flow = GetWorld()->GetSubsystem<UNeonFlowFieldSubsystem>();
+	if (Flow && Flow->Follow(this, PlayerCharacter, EngagedAcceptanceRadius))
+	{
+		if (GetMoveStatus() != EPathFollowingStatus::Idle)
+		{
+			StopMovement();
+		}
+		ActiveGoalActor.Reset();
+		bMovePending = false;
+	}
+	else
+	{
+		RequestMove(PlayerCharacter, PlayerCharacter->GetActorLocation(), EngagedAcceptanceRadius);
+	}
 
 	// TODO: Implement shooting behavior when weapon system is integrated
 	// EnemyCharacter->FireWeapon();
 }
 
+void ANeonEnemyController::UpdatePositioningBehavior()
+{
+	if (UNeonFlowFieldSubsystem* Flow = GetWorld()->GetSubsystem<UNeonFlowFieldSubsystem>())
+	{
+		Flow->Unfollow(this);
+	}
+
+	// Circle the player just inside attack range, each enemy to its own side, so enemies waiting
+	// for a token spread around the target and stay in contention
+	const FVector PlayerLocation = PlayerCharacter->GetActorLocation();
+	if (!bHasPositionTarget
+		|| FVector::DistSquared(EnemyCharacter->GetActorLocation(), PositionTarget) < FMath::Square(150.0f)
+		|| FVector::DistSquared(PlayerLocation, PositionTarget) > FMath::Square(AttackRange))
+	{
+		const float Side = (GetUniqueID() & 1) ? 1.0f : -1.0f;
+		const FVector FromPlayer = (EnemyCharacter->GetActorLocation() - PlayerLocation).GetSafeNormal2D();
+		PositionTarget = PlayerLocation + FromPlayer.RotateAngleAxis(Side * 30.0f, FVector::UpVector) * AttackRange * 0.8f;
+		bHasPositionTarget = true;
+	}
+
+	RequestMove(nullptr, PositionTarget, 100.0f);
+}
+
+void ANeonEnemyController::OnFlowFieldLost()
+{
+	if (CurrentAIState == EEnemyAIState::Engaged && PlayerCharacter)
+	{
+		RequestMove(PlayerCharacter, PlayerCharacter->GetActorLocation(), EngagedAcceptanceRadius);
+	}
+}
+
 void ANeonEnemyController::UpdateRetreatBehavior()
 {
 	if (!EnemyCharacter)
@@ -185,12 +325,100 @@ void ANeonEnemyController::UpdateRetreatBehavior()
 		return;
 	}
 
-	// Run away from player's last known location
-	FVector RetreatDirection = (EnemyCharacter->GetActorLocation() - LastKnownPlayerLocation).GetSafeNormal();
-	FVector RetreatTarget = EnemyCharacter->GetActorLocation() + RetreatDirection * 1000.0f;
+	// Run away from player's last known location; a new point only once the last one is reached
+	if (!bHasRetreatTarget || FVector::DistSquared(EnemyCharacter->GetActorLocation(), RetreatTarget) < FMath::Square(300.0f))
+	{
+		FVector RetreatDirection = (EnemyCharacter->GetActorLocation() - LastKnownPlayerLocation).GetSafeNormal();
+		RetreatTarget = EnemyCharacter->GetActorLocation() + RetreatDirection * 1000.0f;
+		bHasRetreatTarget = true;
+	}
 
 	EnemyCharacter->GetCharacterMovement()->MaxWalkSpeed = 1000.0f;
-	MoveToLocation(RetreatTarget, 200.0f);
+	RequestMove(nullptr, RetreatTarget, 200.0f);
+}
+
+void ANeonEnemyController::RequestMove(AActor* GoalActor, const FVector& GoalLocation, float AcceptanceRadius)
+{
+	UNeonAISubsystem* AI = GetWorld()->GetSubsystem<UNeonAISubsystem>();
+	if (IsFollowingPathTo(GoalActor, GoalLocation))
+	{
+		bMovePending = false;
+		if (AI)
+		{
+			AI->OnPathRequestReused();
+		}
+		return;
+	}
+
+	PendingGoalActor = GoalActor;
+	PendingGoalLocation = GoalLocation;
+	PendingAcceptanceRadius = AcceptanceRadius;
+
+	if (!AI || AI->TryConsumePathQuery())
+	{
+		IssueMove();
+	}
+	else if (!bMovePending)
+	{
+		// Keeps following the old path until its turn comes
+		bMovePending = true;
+		AI->QueuePathRequest(this);
+	}
+}
+
+bool ANeonEnemyController::IsFollowingPathTo(const AActor* GoalActor, const FVector& GoalLocation) const
+{
+	const UPathFollowingComponent* PathFollowing = GetPathFollowingComponent();
+	if (!PathFollowing || PathFollowing->GetStatus() != EPathFollowingStatus::Moving)
+	{
+		return false;
+	}
+
+	const FNavPathSharedPtr Path = PathFollowing->GetPath();
+	if (!Path.IsValid() || !Path->IsValid())
+	{
+		return false;
+	}
+
+	// A path to an actor follows it by itself (goal observation)
+	if (GoalActor)
+	{
+		return ActiveGoalActor.Get() == GoalActor;
+	}
+	return !ActiveGoalActor.IsValid() && FVector::DistSquared(ActiveGoalLocation, GoalLocation) <= FMath::Square(RepathTolerance);
+}
+
+void ANeonEnemyController::IssueMove()
+{
+	FAIMoveRequest Request;
+	if (AActor* GoalActor = PendingGoalActor.Get())
+	{
+		Request.SetGoalActor(GoalActor);
+	}
+	else
+	{
+		Request.SetGoalLocation(PendingGoalLocation);
+	}
+	Request.SetAcceptanceRadius(PendingAcceptanceRadius);
+	Request.SetAllowPartialPath(true);
+
+	MoveTo(Request);
+
+	ActiveGoalActor = PendingGoalActor;
+	ActiveGoalLocation = PendingGoalLocation;
+	bMovePending = false;
+}
+
+bool ANeonEnemyController::FlushPendingMove()
+{
+	if (!bMovePending || CurrentAIState == EEnemyAIState::Dead)
+	{
+		bMovePending = false;
+		return false;
+	}
+
+	IssueMove();
+	return true;
 }
 
 void ANeonEnemyController::ChangeAIState(EEnemyAIState NewState)
@@ -203,40 +431,89 @@ void ANeonEnemyController::ChangeAIState(EEnemyAIState NewState)
 	PreviousAIState = CurrentAIState;
 	CurrentAIState = NewState;
 	StateChangeTime = GetWorld()->GetTimeSeconds();
+	bHasRetreatTarget = false;
+	bHasPositionTarget = false;
+
+	if (UNeonAISubsystem* AI = GetWorld()->GetSubsystem<UNeonAISubsystem>())
+	{
+		AI->OnAIStateChanged(EnemyCharacter, CurrentAIState, StateChangeTime);
+	}
+
+	if (PreviousAIState == EEnemyAIState::Engaged)
+	{
+		if (UNeonFlowFieldSubsystem* Flow = GetWorld()->GetSubsystem<UNeonFlowFieldSubsystem>())
+		{
+			Flow->Unfollow(this);
+		}
+	}
 
 	UE_LOG(LogTemp, Log, TEXT("ANeonEnemyController state changed: %s -> %s"),
 		*UEnum::GetValueAsString(PreviousAIState),
 		*UEnum::GetValueAsString(CurrentAIState));
 }
 
-bool ANeonEnemyController::CanSeeTarget() const
+bool ANeonEnemyController::RequestVisibilityTrace()
 {
-	if (!EnemyCharacter || !PlayerCharacter)
+	if (bVisibilityTraceInFlight || !EnemyCharacter || !PlayerCharacter)
 	{
 		return false;
 	}
 
-	FVector TraceStart = GetLineTraceStart();
-	FVector TraceEnd = GetLineTraceEnd();
+	const FVector TraceStart = GetLineTraceStart();
+	const FVector TraceEnd = GetLineTraceEnd();
+	const double Now = GetWorld()->GetTimeSeconds();
 
-	FHitResult HitResult;
-	FCollisionQueryParams QueryParams;
+	UNeonAISubsystem* AI = GetWorld()->GetSubsystem<UNeonAISubsystem>();
+	bool bCachedLineOfSight = false;
+	if (AI && AI->GetVisibilityCache().Find(EnemyCharacter, PlayerCharacter, TraceStart, TraceEnd, Now, bCachedLineOfSight))
+	{
+		bHasLineOfSight = bCachedLineOfSight;
+		return false;
+	}
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(NeonEnemyVisibility));
 	QueryParams.AddIgnoredActor(EnemyCharacter);
 
-	bool bHit = GetWorld()->LineTraceSingleByChannel(
-		HitResult,
+	GetWorld()->AsyncLineTraceByChannel(
+		EAsyncTraceType::Single,
 		TraceStart,
 		TraceEnd,
 		ECC_Visibility,
-		QueryParams
+		QueryParams,
+		FCollisionResponseParams::DefaultResponseParam,
+		&VisibilityTraceDelegate
 	);
 
-	if (bHit && HitResult.GetActor() == PlayerCharacter)
+	bVisibilityTraceInFlight = true;
+	PendingTraceTarget = PlayerCharacter;
+	PendingTraceStart = TraceStart;
+	PendingTraceEnd = TraceEnd;
+	PendingTraceTime = Now;
+	PendingObserverEpoch = AI ? AI->GetVisibilityCache().GetEpoch(EnemyCharacter) : 0;
+	PendingTargetEpoch = AI ? AI->GetVisibilityCache().GetEpoch(PlayerCharacter) : 0;
+	return true;
+}
+
+void ANeonEnemyController::OnVisibilityTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	bVisibilityTraceInFlight = false;
+
+	// The target is visible only if it is the first thing the trace hit
+	AActor* TracedTarget = PendingTraceTarget.Get();
+	const bool bTargetVisible = TracedTarget && Datum.OutHits.Num() > 0 && Datum.OutHits[0].bBlockingHit && Datum.OutHits[0].GetActor() == TracedTarget;
+
+	// A target switched while the trace was in flight keeps its last result until its own trace
+	if (TracedTarget == PlayerCharacter)
 	{
-		return true;
+		bHasLineOfSight = bTargetVisible;
 	}
 
-	return false;
+	UNeonAISubsystem* AI = GetWorld()->GetSubsystem<UNeonAISubsystem>();
+	if (AI && TracedTarget)
+	{
+		AI->GetVisibilityCache().Store(EnemyCharacter, TracedTarget, PendingTraceStart, PendingTraceEnd, PendingTraceTime,
+			PendingObserverEpoch, PendingTargetEpoch, bTargetVisible);
+	}
 }
 
 bool ANeonEnemyController::IsTargetInRange() const
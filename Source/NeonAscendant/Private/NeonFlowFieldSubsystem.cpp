@@ -0,0 +1,347 @@
+#include "NeonFlowFieldSubsystem.h"
+#include "NeonEnemyController.h"
+#include "NavigationSystem.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarNeonFlowField(
+	TEXT("ai.Neon.FlowField"),
+	1,
+	TEXT("1: engaged enemies chase their target along a shared flow field. 0: each one pathfinds to it."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarNeonFlowFieldRadius(
+	TEXT("ai.Neon.FlowField.Radius"),
+	3000.0f,
+	TEXT("Half width (cm) of the square a flow field covers around its target; enemies outside it pathfind."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarNeonFlowFieldCellsPerFrame(
+	TEXT("ai.Neon.FlowField.CellsPerFrame"),
+	4096,
+	TEXT("Flow field cells expanded per frame across all builds; a build that does not fit continues next frame."),
+	ECVF_Default);
+
+namespace
+{
+	constexpr float UnreachableDistance = TNumericLimits<float>::Max();
+	constexpr float UnknownHeight = TNumericLimits<float>::Max();
+	constexpr float UnwalkableHeight = TNumericLimits<float>::Lowest();
+
+	// Vertical reach of a navmesh projection from a cell's reference height
+	constexpr float ProjectionHeight = 500.0f;
+
+	// Seconds a field is kept after its last follower left
+	constexpr double FieldLifetime = 2.0;
+
+	// Orthogonal neighbours first; diagonals are only taken when both orthogonals are walkable
+	const FIntPoint NeighbourOffsets[8] =
+	{
+		FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1),
+		FIntPoint(1, 1), FIntPoint(1, -1), FIntPoint(-1, 1), FIntPoint(-1, -1)
+	};
+
+	bool OpenLess(const TPair<float, int32>& A, const TPair<float, int32>& B)
+	{
+		return A.Key < B.Key;
+	}
+}
+
+bool UNeonFlowFieldSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UNeonFlowFieldSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNeonFlowFieldSubsystem, STATGROUP_Tickables);
+}
+
+void UNeonFlowFieldSubsystem::Deinitialize()
+{
+	Fields.Reset();
+	Followers.Reset();
+	CellHeights.Reset();
+
+	Super::Deinitialize();
+}
+
+FIntPoint UNeonFlowFieldSubsystem::ToCell(const FVector& Location)
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+int32 UNeonFlowFieldSubsystem::FGrid::ToIndex(const FIntPoint& Cell) const
+{
+	const FIntPoint Local = Cell - Origin;
+	if (Local.X < 0 || Local.Y < 0 || Local.X >= Width || Local.Y >= Width)
+	{
+		return INDEX_NONE;
+	}
+	return Local.Y * Width + Local.X;
+}
+
+FVector UNeonFlowFieldSubsystem::FGrid::GetCellCenter(int32 Index) const
+{
+	return FVector(
+		(Origin.X + Index % Width + 0.5) * CellSize,
+		(Origin.Y + Index / Width + 0.5) * CellSize,
+		Heights[Index]);
+}
+
+void UNeonFlowFieldSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	int32 Budget = CVarNeonFlowFieldCellsPerFrame.GetValueOnGameThread();
+
+	for (auto It = Fields.CreateIterator(); It; ++It)
+	{
+		FField& Field = It.Value();
+		const AActor* Target = Field.Target.Get();
+		if (!Target || Now - Field.LastFollowedTime > FieldLifetime)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		// A build in progress finishes before the next starts, so a target that keeps moving
+		// still gets fields, each at most one build behind
+		if (!Field.bBuilding && (!Field.bReady || ToCell(Target->GetActorLocation()) != Field.Ready.Goal))
+		{
+			StartBuild(Field);
+		}
+		if (Field.bBuilding && Budget > 0)
+		{
+			Budget -= ContinueBuild(Field, Budget);
+		}
+	}
+
+	SteerFollowers();
+}
+
+bool UNeonFlowFieldSubsystem::Follow(ANeonEnemyController* Controller, AActor* Target, float AcceptanceRadius)
+{
+	if (!Controller || !Target || CVarNeonFlowField.GetValueOnGameThread() == 0)
+	{
+		Unfollow(Controller);
+		return false;
+	}
+
+	FField& Field = Fields.FindOrAdd(FObjectKey(Target));
+	Field.Target = Target;
+	Field.LastFollowedTime = GetWorld()->GetTimeSeconds();
+
+	const APawn* Pawn = Controller->GetPawn();
+	FVector StepTarget;
+	if (!Pawn || !Field.bReady || !GetStep(Field.Ready, Pawn->GetActorLocation(), StepTarget))
+	{
+		Unfollow(Controller);
+		return false;
+	}
+
+	FFollower* Follower = Followers.FindByPredicate([Controller](const FFollower& Candidate)
+	{
+		return Candidate.Controller.Get() == Controller;
+	});
+	if (!Follower)
+	{
+		Follower = &Followers.AddDefaulted_GetRef();
+		Follower->Controller = Controller;
+	}
+	Follower->Target = FObjectKey(Target);
+	Follower->AcceptanceRadius = AcceptanceRadius;
+	return true;
+}
+
+void UNeonFlowFieldSubsystem::Unfollow(ANeonEnemyController* Controller)
+{
+	Followers.RemoveAllSwap([Controller](const FFollower& Follower)
+	{
+		return Follower.Controller.Get() == Controller;
+	}, EAllowShrinking::No);
+}
+
+bool UNeonFlowFieldSubsystem::StartBuild(FField& Field)
+{
+	const FVector TargetLocation = Field.Target->GetActorLocation();
+	const FIntPoint Goal = ToCell(TargetLocation);
+
+	// Off the navmesh (e.g. mid-jump far above it); tried again next tick, before the grid is touched
+	const float GoalHeight = GetCellHeight(Goal, TargetLocation.Z);
+	if (GoalHeight == UnwalkableHeight)
+	{
+		return false;
+	}
+
+	const int32 HalfWidth = FMath::CeilToInt32(CVarNeonFlowFieldRadius.GetValueOnGameThread() / CellSize);
+
+	FGrid& Grid = Field.Building;
+	Grid.Goal = Goal;
+	Grid.Origin = Grid.Goal - FIntPoint(HalfWidth, HalfWidth);
+	Grid.Width = HalfWidth * 2 + 1;
+
+	const int32 NumCells = Grid.Width * Grid.Width;
+	Grid.Distances.Init(UnreachableDistance, NumCells);
+	Grid.NextCells.Init(INDEX_NONE, NumCells);
+	Grid.Heights.Init(UnknownHeight, NumCells);
+
+	const int32 GoalIndex = Grid.ToIndex(Grid.Goal);
+	Grid.Heights[GoalIndex] = GoalHeight;
+	Grid.Distances[GoalIndex] = 0.0f;
+	Field.Open.Reset();
+	Field.Open.HeapPush(MakeTuple(0.0f, GoalIndex), OpenLess);
+	Field.bBuilding = true;
+	++Builds;
+	return true;
+}
+
+int32 UNeonFlowFieldSubsystem::ContinueBuild(FField& Field, int32 Budget)
+{
+	FGrid& Grid = Field.Building;
+
+	int32 Expanded = 0;
+	while (Field.Open.Num() > 0 && Expanded < Budget)
+	{
+		TPair<float, int32> Top;
+		Field.Open.HeapPop(Top, OpenLess, EAllowShrinking::No);
+		if (Top.Key > Grid.Distances[Top.Value])
+		{
+			// Superseded by a shorter route pushed later
+			continue;
+		}
+		++Expanded;
+
+		const FIntPoint Cell = Grid.Origin + FIntPoint(Top.Value % Grid.Width, Top.Value / Grid.Width);
+		const float Height = Grid.Heights[Top.Value];
+		const FVector Center = Grid.GetCellCenter(Top.Value);
+
+		auto IsWalkable = [this, &Grid, Height](const FIntPoint& Neighbour, int32& OutIndex)
+		{
+			OutIndex = Grid.ToIndex(Neighbour);
+			if (OutIndex == INDEX_NONE)
+			{
+				return false;
+			}
+
+			float& NeighbourHeight = Grid.Heights[OutIndex];
+			if (NeighbourHeight == UnknownHeight)
+			{
+				NeighbourHeight = GetCellHeight(Neighbour, Height);
+			}
+			return NeighbourHeight != UnwalkableHeight && FMath::Abs(NeighbourHeight - Height) <= MaxStepHeight;
+		};
+
+		for (int32 Direction = 0; Direction < UE_ARRAY_COUNT(NeighbourOffsets); ++Direction)
+		{
+			const FIntPoint& Offset = NeighbourOffsets[Direction];
+			int32 NeighbourIndex = INDEX_NONE;
+			int32 CornerIndex = INDEX_NONE;
+			if (!IsWalkable(Cell + Offset, NeighbourIndex)
+				|| (Offset.X != 0 && Offset.Y != 0
+					&& (!IsWalkable(Cell + FIntPoint(Offset.X, 0), CornerIndex) || !IsWalkable(Cell + FIntPoint(0, Offset.Y), CornerIndex))))
+			{
+				continue;
+			}
+
+			const float Distance = Top.Key + FVector::Dist(Center, Grid.GetCellCenter(NeighbourIndex));
+			if (Distance < Grid.Distances[NeighbourIndex])
+			{
+				Grid.Distances[NeighbourIndex] = Distance;
+				Grid.NextCells[NeighbourIndex] = Top.Value;
+				Field.Open.HeapPush(MakeTuple(Distance, NeighbourIndex), OpenLess);
+			}
+		}
+	}
+	CellsExpanded += Expanded;
+
+	if (Field.Open.Num() == 0)
+	{
+		// The old grid's arrays are reused by the next build
+		Swap(Field.Ready, Field.Building);
+		Field.bReady = true;
+		Field.bBuilding = false;
+	}
+	return Expanded;
+}
+
+float UNeonFlowFieldSubsystem::GetCellHeight(const FIntPoint& Cell, float ReferenceZ)
+{
+	if (const float* Cached = CellHeights.Find(Cell))
+	{
+		return *Cached;
+	}
+
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (!NavSys)
+	{
+		return UnwalkableHeight;
+	}
+
+	// A miss depends on the reference height (a cell may be out of reach from one floor and not
+	// another), so only hits are kept; a build still projects each of its cells at most once
+	FNavLocation Projected;
+	const FVector Center((Cell.X + 0.5) * CellSize, (Cell.Y + 0.5) * CellSize, ReferenceZ);
+	if (!NavSys->ProjectPointToNavigation(Center, Projected, FVector(CellSize * 0.5f, CellSize * 0.5f, ProjectionHeight)))
+	{
+		return UnwalkableHeight;
+	}
+
+	const float Height = Projected.Location.Z;
+	CellHeights.Add(Cell, Height);
+	return Height;
+}
+
+bool UNeonFlowFieldSubsystem::GetStep(const FGrid& Grid, const FVector& Location, FVector& OutStepTarget)
+{
+	const int32 Index = Grid.ToIndex(ToCell(Location));
+	if (Index == INDEX_NONE || Grid.Distances[Index] == UnreachableDistance)
+	{
+		return false;
+	}
+
+	const int32 NextIndex = Grid.NextCells[Index];
+	OutStepTarget = Grid.GetCellCenter(NextIndex != INDEX_NONE ? NextIndex : Index);
+	return true;
+}
+
+void UNeonFlowFieldSubsystem::SteerFollowers()
+{
+	const bool bEnabled = CVarNeonFlowField.GetValueOnGameThread() != 0;
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	for (int32 Index = Followers.Num() - 1; Index >= 0; --Index)
+	{
+		ANeonEnemyController* Controller = Followers[Index].Controller.Get();
+		APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+		FField* Field = Fields.Find(Followers[Index].Target);
+		const AActor* Target = Field ? Field->Target.Get() : nullptr;
+
+		FVector StepTarget;
+		if (!bEnabled || !Pawn || !Target || !Field->bReady || !GetStep(Field->Ready, Pawn->GetActorLocation(), StepTarget))
+		{
+			// Back to pathfinding
+			Followers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			if (Controller)
+			{
+				Controller->OnFlowFieldLost();
+			}
+			continue;
+		}
+		Field->LastFollowedTime = Now;
+
+		const FVector Location = Pawn->GetActorLocation();
+		const FVector TargetLocation = Target->GetActorLocation();
+		if (FVector::DistSquared2D(Location, TargetLocation) <= FMath::Square(Followers[Index].AcceptanceRadius))
+		{
+			continue;
+		}
+
+		// In the goal cell the target itself is the next step
+		if (ToCell(Location) == Field->Ready.Goal)
+		{
+			StepTarget = TargetLocation;
+		}
+		Pawn->AddMovementInput((StepTarget - Location).GetSafeNormal2D());
+	}
+}
@@ -1,13 +1,17 @@
 #include "NeonGameMode.h"
 #include "NeonCharacter.h"
 #include "NeonHUD.h"
+#include "MissionCatalog.h"
+#include "MissionData.h"
 #include "MissionGenerator.h"
 #include "MissionTypes.h"
 #include "DistrictHazard.h"
 #include "NeonEnemy.h"
+#include "Async/Async.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
 #include "GameFramework/PlayerStart.h"
+#include "Tasks/Task.h"
 
 ANeonGameMode::ANeonGameMode()
 {
@@ -24,6 +28,19 @@ void ANeonGameMode::BeginPlay()
 
 	// Get mission generator singleton
 	MissionGenerator = UMissionGeneratorSingleton::GetGenerator();
+
+	// Start filling the pre-generated brief ring before the first mission is requested
+	UMissionGeneratorSingleton::WarmUpPreGeneration();
+
+	CatalogReloadedHandle = NeonAscendantData::OnCatalogReloaded().AddUObject(this, &ANeonGameMode::HandleCatalogReloaded);
+}
+
+void ANeonGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	NeonAscendantData::OnCatalogReloaded().Remove(CatalogReloadedHandle);
+	++DifficultyEstimateSerial;
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void ANeonGameMode::StartNewMission()
@@ -33,24 +50,57 @@ void ANeonGameMode::StartNewMission()
 		MissionGenerator = UMissionGeneratorSingleton::GetGenerator();
 	}
 
+	// Without a catalog every brief would be empty; keep the level as it is
+	if (!FMissionCatalog::Get().IsLoaded())
+	{
+		UE_LOG(LogTemp, Error, TEXT("ANeonGameMode::StartNewMission - no mission catalog: %s"), *FMissionCatalog::Get().GetLoadError());
+		return;
+	}
+
 	if (MissionGenerator)
 	{
-		FMissionBrief NewMission = MissionGenerator->GenerateMissionBrief();
+		// Pop a brief pre-rolled in the background. Only the HUD expands it; the game mode keeps the
+		// handle and the entry names a catalog reload needs
+		const FMissionBriefHandle NewMission = UMissionGeneratorSingleton::PopNextMissionBrief();
+		ActiveMissionHandle = NewMission;
+		ActiveMissionNames = NeonAscendantData::GetBriefNames(NewMission);
 
 		// Log mission info
 		UE_LOG(LogTemp, Log, TEXT("New Mission Generated:"));
-		UE_LOG(LogTemp, Log, TEXT("  District: %s"), *NewMission.District.Name);
-		UE_LOG(LogTemp, Log, TEXT("  Opposition: %s"), *NewMission.Opposition.Name);
-		UE_LOG(LogTemp, Log, TEXT("  Archetype: %s"), *NewMission.Archetype.Name);
-		UE_LOG(LogTemp, Log, TEXT("  Weapon: %s"), *NewMission.PrimaryWeapon.Name);
-		UE_LOG(LogTemp, Log, TEXT("  Complication: %s"), *NewMission.Complication);
-		UE_LOG(LogTemp, Log, TEXT("  Extraction: %s"), *NewMission.ExtractionCondition);
+		UE_LOG(LogTemp, Log, TEXT("  District: %s"), *ActiveMissionNames.District.ToString());
+		UE_LOG(LogTemp, Log, TEXT("  Opposition: %s"), *ActiveMissionNames.Opposition.ToString());
+		UE_LOG(LogTemp, Log, TEXT("  Archetype: %s"), *ActiveMissionNames.Archetype.ToString());
+		UE_LOG(LogTemp, Log, TEXT("  Weapon: %s"), *ActiveMissionNames.PrimaryWeapon.ToString());
+		UE_LOG(LogTemp, Log, TEXT("  Complication: %s"), *ActiveMissionNames.Complication.ToString());
+		UE_LOG(LogTemp, Log, TEXT("  Extraction: %s"), *ActiveMissionNames.ExtractionCondition.ToString());
+
+		// Tags and the backup implant's stat modifiers
+		ApplyActiveMissionHandle();
+
+		// Thousands of simulated fights; they run on workers while the mission spawns
+		StartDifficultyEstimate(NewMission);
+
+		// Map layout for this brief, for levels built from it; the player start slot is anchored on the player
+		ActiveLayout = FMissionLayout();
+		if (bPlaceOnMissionLayout)
+		{
+			const double LayoutStart = FPlatformTime::Seconds();
+			ActiveLayout = MissionLayout::Generate(NewMission);
+			if (ActiveLayout.IsValid())
+			{
+				const FMissionLayoutSlot& PlayerStart = ActiveLayout.GetSlots(EMissionLayoutSlot::PlayerStart)[0];
+				LayoutOrigin = GetPlayerSpawnOrigin() - FVector((PlayerStart.X + 0.5f) * LayoutTileSize, (PlayerStart.Y + 0.5f) * LayoutTileSize, 0.0f);
+				LayoutOrigin.Z = 0.0f;
+			}
+			UE_LOG(LogTemp, Log, TEXT("  Layout: %dx%d tiles, %d slots (%.2f ms)"),
+				ActiveLayout.Width, ActiveLayout.Height, ActiveLayout.Slots.Num(), (FPlatformTime::Seconds() - LayoutStart) * 1000.0);
+		}
 
 		// Spawn enemies based on the generated mission
-		SpawnEnemiesForMission(NewMission);
+		SpawnEnemiesForOpposition(ActiveMissionNames.Opposition, DefaultEnemyCount);
 
 		// Spawn district hazards
-		SpawnHazardsForMission(NewMission);
+		SpawnHazardsForDistrict(ActiveMissionNames.District);
 
 		// Update HUD with mission briefing
 		APlayerController* PC = GetWorld()->GetFirstPlayerController();
@@ -59,7 +109,7 @@ void ANeonGameMode::StartNewMission()
 			ANeonHUD* GameHUD = Cast<ANeonHUD>(PC->GetHUD());
 			if (GameHUD)
 			{
-				GameHUD->SetMissionBrief(NewMission);
+				GameHUD->SetMissionBriefHandle(NewMission);
 
 				if (APawn* PlayerPawn = PC->GetPawn())
 				{
@@ -73,7 +123,47 @@ void ANeonGameMode::StartNewMission()
 	}
 }
 
+void ANeonGameMode::StartDifficultyEstimate(const FMissionBriefHandle& Mission)
+{
+	ActiveMissionDifficulty = FMissionDifficulty();
+	const uint32 Serial = ++DifficultyEstimateSerial;
+
+	// Class defaults and catalog entries are read here on the game thread; the task only simulates
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis = TWeakObjectPtr<ANeonGameMode>(this), Serial, Mission,
+		Weapon = NeonAscendantData::GetPrimaryWeapon(Mission), Ability = NeonAscendantData::GetFeaturedAbility(Mission),
+		Settings = FMissionCombatSettings::FromClassDefaults(DefaultPawnClass, EnemyClass)]()
+	{
+		const FMissionDifficulty Difficulty = MissionDifficulty::Estimate(Mission, Weapon, Ability, Settings);
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Serial, Difficulty]()
+		{
+			ANeonGameMode* GameMode = WeakThis.Get();
+			if (GameMode && GameMode->DifficultyEstimateSerial == Serial)
+			{
+				GameMode->ApplyMissionDifficulty(Difficulty);
+			}
+		});
+	});
+}
+
+void ANeonGameMode::ApplyMissionDifficulty(const FMissionDifficulty& Difficulty)
+{
+	ActiveMissionDifficulty = Difficulty;
+	UE_LOG(LogTemp, Log, TEXT("Mission difficulty: %.0f (survival %.0f%%, time to clear %.1f s)"),
+		Difficulty.Score, Difficulty.SurvivalChance * 100.0f, Difficulty.MeanTimeToClear);
+
+	APlayerController* PC = GetWorld()->GetFirstPlayerController();
+	if (ANeonHUD* GameHUD = PC ? Cast<ANeonHUD>(PC->GetHUD()) : nullptr)
+	{
+		GameHUD->SetMissionDifficulty(Difficulty);
+	}
+}
+
 void ANeonGameMode::SpawnEnemiesForMission(const FMissionBrief& Mission, int32 EnemyCount)
+{
+	SpawnEnemiesForOpposition(FName(*Mission.Opposition.Name), EnemyCount);
+}
+
+void ANeonGameMode::SpawnEnemiesForOpposition(FName Opposition, int32 EnemyCount)
 {
 	// Validate enemy class is set
 	if (!EnemyClass)
@@ -88,37 +178,21 @@ void ANeonGameMode::SpawnEnemiesForMission(const FMissionBrief& Mission, int32 E
 		return;
 	}
 
-	// Get spawn origin from player start or level center
-	FVector SpawnOrigin = FVector::ZeroVector;
+	const FVector SpawnOrigin = GetPlayerSpawnOrigin();
+	const TConstArrayView<FMissionLayoutSlot> SpawnSlots = ActiveLayout.GetSlots(EMissionLayoutSlot::EnemySpawn);
 
-	APlayerController* PC = World->GetFirstPlayerController();
-	if (PC && PC->GetPawn())
-	{
-		SpawnOrigin = PC->GetPawn()->GetActorLocation();
-	}
-	else
-	{
-		// Find player start as fallback
-		APlayerStart* PlayerStart = Cast<APlayerStart>(
-			UGameplayStatics::GetActorOfClass(World, APlayerStart::StaticClass())
-		);
-		if (PlayerStart)
-		{
-			SpawnOrigin = PlayerStart->GetActorLocation();
-		}
-	}
-
-	UE_LOG(LogTemp, Log, TEXT("Spawning %d enemies for mission vs %s"), EnemyCount, *Mission.Opposition.Name);
+	UE_LOG(LogTemp, Log, TEXT("Spawning %d enemies for mission vs %s"), EnemyCount, *Opposition.ToString());
 
 	for (int32 i = 0; i < EnemyCount; ++i)
 	{
-		// Calculate spawn position: random location around the spawn origin
-		// In a real implementation, use designated spawn points
-		FVector SpawnLocation = SpawnOrigin + FVector(
-			FMath::RandRange(EnemySpawnMinDistance, EnemySpawnMaxDistance),
-			FMath::RandRange(EnemySpawnMinDistance, EnemySpawnMaxDistance),
-			EnemySpawnHeightOffset
-		);
+		// Use the layout's spawn slots; without a layout, a random location around the spawn origin
+		FVector SpawnLocation = SpawnSlots.Num() > 0
+			? GetLayoutSlotLocation(SpawnSlots[i % SpawnSlots.Num()], SpawnOrigin.Z + EnemySpawnHeightOffset)
+			: SpawnOrigin + FVector(
+				FMath::RandRange(EnemySpawnMinDistance, EnemySpawnMaxDistance),
+				FMath::RandRange(EnemySpawnMinDistance, EnemySpawnMaxDistance),
+				EnemySpawnHeightOffset
+			);
 
 		FActorSpawnParameters SpawnParams;
 		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButDontSpawnIfColliding;
@@ -135,6 +209,11 @@ void ANeonGameMode::SpawnEnemiesForMission(const FMissionBrief& Mission, int32 E
 }
 
 void ANeonGameMode::SpawnHazardsForMission(const FMissionBrief& Mission)
+{
+	SpawnHazardsForDistrict(FName(*Mission.District.Name));
+}
+
+void ANeonGameMode::SpawnHazardsForDistrict(FName District)
 {
 	// Validate hazard class is set
 	if (!HazardClass)
@@ -162,16 +241,20 @@ void ANeonGameMode::SpawnHazardsForMission(const FMissionBrief& Mission)
 	// Spawn hazards based on the mission's complication (which relates to district)
 	int32 HazardCount = FMath::RandRange(MinHazardCount, MaxHazardCount);
 
-	UE_LOG(LogTemp, Log, TEXT("Spawning %d hazards for district %s"), HazardCount, *Mission.District.Name);
+	UE_LOG(LogTemp, Log, TEXT("Spawning %d hazards for district %s"), HazardCount, *District.ToString());
+
+	const TConstArrayView<FMissionLayoutSlot> HazardSlots = ActiveLayout.GetSlots(EMissionLayoutSlot::Hazard);
 
 	for (int32 i = 0; i < HazardCount; ++i)
 	{
-		// Calculate spawn position: random location around the level
-		FVector SpawnLocation = FVector(
-			FMath::RandRange(HazardSpawnMinDistance, HazardSpawnMaxDistance),
-			FMath::RandRange(HazardSpawnMinDistance, HazardSpawnMaxDistance),
-			HazardSpawnHeight
-		);
+		// Use the layout's hazard slots; without a layout, a random location around the level
+		FVector SpawnLocation = HazardSlots.Num() > 0
+			? GetLayoutSlotLocation(HazardSlots[i % HazardSlots.Num()], HazardSpawnHeight)
+			: FVector(
+				FMath::RandRange(HazardSpawnMinDistance, HazardSpawnMaxDistance),
+				FMath::RandRange(HazardSpawnMinDistance, HazardSpawnMaxDistance),
+				HazardSpawnHeight
+			);
 
 		FActorSpawnParameters SpawnParams;
 		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButDontSpawnIfColliding;
@@ -183,7 +266,7 @@ void ANeonGameMode::SpawnHazardsForMission(const FMissionBrief& Mission)
 			// Randomize hazard type
 			int32 HazardTypeIndex = FMath::RandRange(0, 4);
 			NewHazard->HazardType = static_cast<EHazardType>(HazardTypeIndex);
-			NewHazard->DamagePerSecond = FMath::RandRange(5.0f, 15.0f);
+			NewHazard->DamagePerSecond = FMath::RandRange(MinHazardDamagePerSecond, MaxHazardDamagePerSecond);
 			NewHazard->EffectRadius = FMath::RandRange(300.0f, 600.0f);
 
 			ActiveHazards.Add(NewHazard);
@@ -193,3 +276,76 @@ void ANeonGameMode::SpawnHazardsForMission(const FMissionBrief& Mission)
 		}
 	}
 }
+
+void ANeonGameMode::ApplyActiveMissionHandle()
+{
+	// Tags come from the mission data tables, so gameplay code can react to them without string compares
+	ActiveMissionTags.Reset();
+	if (ActiveMissionHandle.IsSet())
+	{
+		const FMissionBriefHandle& Handle = ActiveMissionHandle.GetValue();
+		for (const FGameplayTag& Tag : { NeonAscendantData::GetDistrictTag(Handle), NeonAscendantData::GetOppositionTag(Handle), NeonAscendantData::GetComplicationTag(Handle) })
+		{
+			if (Tag.IsValid())
+			{
+				ActiveMissionTags.AddTag(Tag);
+			}
+		}
+	}
+
+	// The brief's backup implant drives the player's stat modifiers
+	APlayerController* PC = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr;
+	if (ANeonCharacter* PlayerCharacter = PC ? Cast<ANeonCharacter>(PC->GetPawn()) : nullptr)
+	{
+		PlayerCharacter->EquipImplant(ActiveMissionHandle.IsSet() ? ActiveMissionHandle->ImplantIndex : INDEX_NONE);
+	}
+}
+
+void ANeonGameMode::HandleCatalogReloaded()
+{
+	if (!ActiveMissionHandle.IsSet())
+	{
+		return;
+	}
+
+	FMissionBriefHandle Handle;
+	if (NeonAscendantData::FindBriefHandle(ActiveMissionNames, Handle))
+	{
+		ActiveMissionHandle = Handle;
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ANeonGameMode - the reloaded mission catalog no longer contains the current mission; dropping its tags and implant"));
+		ActiveMissionHandle.Reset();
+	}
+
+	ApplyActiveMissionHandle();
+}
+
+FVector ANeonGameMode::GetLayoutSlotLocation(const FMissionLayoutSlot& Slot, float Height) const
+{
+	return LayoutOrigin + FVector((Slot.X + 0.5f) * LayoutTileSize, (Slot.Y + 0.5f) * LayoutTileSize, Height);
+}
+
+FVector ANeonGameMode::GetPlayerSpawnOrigin() const
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return FVector::ZeroVector;
+	}
+
+	APlayerController* PC = World->GetFirstPlayerController();
+	if (PC && PC->GetPawn())
+	{
+		return PC->GetPawn()->GetActorLocation();
+	}
+
+	// Find player start as fallback
+	if (APlayerStart* PlayerStart = Cast<APlayerStart>(UGameplayStatics::GetActorOfClass(World, APlayerStart::StaticClass())))
+	{
+		return PlayerStart->GetActorLocation();
+	}
+
+	return FVector::ZeroVector;
+}
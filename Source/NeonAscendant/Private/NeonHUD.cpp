@@ -1,4 +1,5 @@
 #include "NeonHUD.h"
+#include "MissionData.h"
 #include "NeonCharacter.h"
 #include "NeonWeapon.h"
 #include "Engine/Canvas.h"
@@ -51,12 +52,31 @@ void ANeonHUD::DrawHUD()
 
 void ANeonHUD::SetMissionBrief(const FMissionBrief& NewMission)
 {
+	// Briefs authored in Blueprint need not come from the catalog; they are shown as they are
 	CurrentMission = NewMission;
+	OnMissionBriefChanged();
+}
+
+void ANeonHUD::SetMissionBriefHandle(const FMissionBriefHandle& NewMission)
+{
+	// Expanded straight into CurrentMission; this is the only copy of the live mission's strings
+	CurrentMission = NeonAscendantData::ExpandBrief(NewMission);
+	OnMissionBriefChanged();
+}
+
+void ANeonHUD::OnMissionBriefChanged()
+{
+	MissionDifficulty = FMissionDifficulty();
 	bShowMissionBriefing = true;
 
 	UE_LOG(LogTemp, Log, TEXT("HUD updated with mission: %s vs %s"),
-		*NewMission.District.Name,
-		*NewMission.Opposition.Name);
+		*CurrentMission.District.Name,
+		*CurrentMission.Opposition.Name);
+}
+
+void ANeonHUD::SetMissionDifficulty(const FMissionDifficulty& NewDifficulty)
+{
+	MissionDifficulty = NewDifficulty;
 }
 
 void ANeonHUD::SetPlayerCharacter(ANeonCharacter* NewPlayer)
@@ -154,6 +174,15 @@ void ANeonHUD::DrawMissionBriefing()
 	FString ExtractionText = FString::Printf(TEXT("Extraction: %s"), *CurrentMission.ExtractionCondition);
 	FCanvasTextItem ExtractionItem(Position, FText::FromString(ExtractionText), GEngine->GetSmallFont(), FLinearColor(TextColor));
 	Canvas->DrawItem(ExtractionItem);
+
+	if (MissionDifficulty.Trials > 0)
+	{
+		Position.Y += LineHeight;
+
+		FString DifficultyText = FString::Printf(TEXT("Threat: %.0f / 100 (est. survival %.0f%%)"), MissionDifficulty.Score, MissionDifficulty.SurvivalChance * 100.0f);
+		FCanvasTextItem DifficultyItem(Position, FText::FromString(DifficultyText), GEngine->GetSmallFont(), FLinearColor(TextColor));
+		Canvas->DrawItem(DifficultyItem);
+	}
 }
 
 void ANeonHUD::DrawObjectiveTracker()
@@ -0,0 +1,304 @@
+#include "NeonSpatialGridSubsystem.h"
+#include "GameFramework/Actor.h"
+
+namespace
+{
+	int32 CategoryBit(ENeonSpatialCategory Category)
+	{
+		return FMath::CountTrailingZeros(static_cast<uint32>(Category));
+	}
+}
+
+bool UNeonSpatialGridSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UNeonSpatialGridSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UNeonSpatialGridSubsystem, STATGROUP_Tickables);
+}
+
+void UNeonSpatialGridSubsystem::Deinitialize()
+{
+	Actors.Reset();
+	Entries.Reset();
+	EntryIndices.Reset();
+	Cells.Reset();
+	FMemory::Memzero(CategoryCounts);
+
+	Super::Deinitialize();
+}
+
+FIntPoint UNeonSpatialGridSubsystem::ToCell(const FVector& Location)
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+void UNeonSpatialGridSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+	{
+		if (!Entries[EntryIndex].bStatic && Actors[EntryIndex])
+		{
+			MoveEntry(EntryIndex, Actors[EntryIndex]->GetActorLocation());
+		}
+	}
+}
+
+void UNeonSpatialGridSubsystem::Register(AActor* Actor, ENeonSpatialCategory Category, bool bStatic)
+{
+	if (!Actor || EntryIndices.Contains(FObjectKey(Actor)) || !FMath::IsPowerOfTwo(static_cast<uint32>(Category)))
+	{
+		return;
+	}
+
+	const int32 EntryIndex = Entries.Num();
+	FEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Location = Actor->GetActorLocation();
+	Entry.Cell = ToCell(Entry.Location);
+	Entry.Category = Category;
+	Entry.bStatic = bStatic;
+	Actors.Add(Actor);
+	EntryIndices.Add(FObjectKey(Actor), EntryIndex);
+	++CategoryCounts[CategoryBit(Category)];
+
+	AddToCell(EntryIndex);
+}
+
+void UNeonSpatialGridSubsystem::Unregister(AActor* Actor)
+{
+	int32 EntryIndex = INDEX_NONE;
+	if (!EntryIndices.RemoveAndCopyValue(FObjectKey(Actor), EntryIndex))
+	{
+		return;
+	}
+
+	RemoveFromCell(EntryIndex);
+	--CategoryCounts[CategoryBit(Entries[EntryIndex].Category)];
+
+	const int32 LastIndex = Entries.Num() - 1;
+	if (EntryIndex != LastIndex)
+	{
+		// The last entry moves into the hole; point its cell and lookup at the new index
+		Cells[Entries[LastIndex].Cell][Entries[LastIndex].IndexInCell] = EntryIndex;
+		EntryIndices[FObjectKey(Actors[LastIndex])] = EntryIndex;
+	}
+	Entries.RemoveAtSwap(EntryIndex, 1, EAllowShrinking::No);
+	Actors.RemoveAtSwap(EntryIndex, 1, EAllowShrinking::No);
+}
+
+void UNeonSpatialGridSubsystem::UpdateActor(AActor* Actor)
+{
+	if (const int32* EntryIndex = EntryIndices.Find(FObjectKey(Actor)))
+	{
+		MoveEntry(*EntryIndex, Actor->GetActorLocation());
+	}
+}
+
+void UNeonSpatialGridSubsystem::AddToCell(int32 EntryIndex)
+{
+	TArray<int32>& Cell = Cells.FindOrAdd(Entries[EntryIndex].Cell);
+	Entries[EntryIndex].IndexInCell = Cell.Add(EntryIndex);
+}
+
+void UNeonSpatialGridSubsystem::RemoveFromCell(int32 EntryIndex)
+{
+	FEntry& Entry = Entries[EntryIndex];
+	TArray<int32>& Cell = Cells.FindChecked(Entry.Cell);
+
+	Cell.RemoveAtSwap(Entry.IndexInCell, 1, EAllowShrinking::No);
+	if (Cell.IsValidIndex(Entry.IndexInCell))
+	{
+		Entries[Cell[Entry.IndexInCell]].IndexInCell = Entry.IndexInCell;
+	}
+	if (Cell.Num() == 0)
+	{
+		Cells.Remove(Entry.Cell);
+	}
+	Entry.IndexInCell = INDEX_NONE;
+}
+
+void UNeonSpatialGridSubsystem::MoveEntry(int32 EntryIndex, const FVector& NewLocation)
+{
+	FEntry& Entry = Entries[EntryIndex];
+	Entry.Location = NewLocation;
+
+	const FIntPoint NewCell = ToCell(NewLocation);
+	if (NewCell != Entry.Cell)
+	{
+		RemoveFromCell(EntryIndex);
+		Entry.Cell = NewCell;
+		AddToCell(EntryIndex);
+	}
+}
+
+int32 UNeonSpatialGridSubsystem::NumInCategories(ENeonSpatialCategory Categories) const
+{
+	int32 Count = 0;
+	for (int32 Bit = 0; Bit < UE_ARRAY_COUNT(CategoryCounts); ++Bit)
+	{
+		if (static_cast<uint32>(Categories) & (1u << Bit))
+		{
+			Count += CategoryCounts[Bit];
+		}
+	}
+	return Count;
+}
+
+bool UNeonSpatialGridSubsystem::ScansAllEntries(const FVector& Center, float Radius) const
+{
+	// A radius covering more cells than there are entries (say, the nearest player anywhere on
+	// the map) is cheaper as a scan
+	const FIntPoint MinCell = ToCell(Center - FVector(Radius, Radius, 0.0));
+	const FIntPoint MaxCell = ToCell(Center + FVector(Radius, Radius, 0.0));
+	return int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1) > Entries.Num();
+}
+
+template <typename VisitorType>
+void UNeonSpatialGridSubsystem::ForEachInRadius(const FVector& Center, float Radius, ENeonSpatialCategory Categories, VisitorType&& Visitor) const
+{
+	const double RadiusSquared = FMath::Square(static_cast<double>(Radius));
+
+	auto VisitEntry = [&](int32 EntryIndex)
+	{
+		const FEntry& Entry = Entries[EntryIndex];
+		if (EnumHasAnyFlags(Entry.Category, Categories))
+		{
+			const double DistanceSquared = FVector::DistSquared(Entry.Location, Center);
+			if (DistanceSquared <= RadiusSquared)
+			{
+				Visitor(EntryIndex, DistanceSquared);
+			}
+		}
+	};
+
+	if (NumInCategories(Categories) == 0)
+	{
+		return;
+	}
+
+	if (ScansAllEntries(Center, Radius))
+	{
+		for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+		{
+			VisitEntry(EntryIndex);
+		}
+		return;
+	}
+
+	const FIntPoint MinCell = ToCell(Center - FVector(Radius, Radius, 0.0));
+	const FIntPoint MaxCell = ToCell(Center + FVector(Radius, Radius, 0.0));
+	for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+	{
+		for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+		{
+			if (const TArray<int32>* Cell = Cells.Find(FIntPoint(CellX, CellY)))
+			{
+				for (const int32 EntryIndex : *Cell)
+				{
+					VisitEntry(EntryIndex);
+				}
+			}
+		}
+	}
+}
+
+void UNeonSpatialGridSubsystem::QueryRadius(const FVector& Center, float Radius, ENeonSpatialCategory Categories, TArray<AActor*>& OutActors) const
+{
+	ForEachInRadius(Center, Radius, Categories, [this, &OutActors](int32 EntryIndex, double)
+	{
+		OutActors.Add(Actors[EntryIndex]);
+	});
+}
+
+void UNeonSpatialGridSubsystem::FindNearest(const FVector& Center, int32 Count, float MaxRadius, ENeonSpatialCategory Categories, TArray<AActor*>& OutActors) const
+{
+	OutActors.Reset();
+	if (Count <= 0)
+	{
+		return;
+	}
+
+	struct FCandidate
+	{
+		double DistanceSquared;
+		int32 EntryIndex;
+	};
+	TArray<FCandidate, TInlineAllocator<16>> Candidates;
+
+	// Double the search radius until it holds Count candidates; anything outside radius R is
+	// farther than everything found within it, so those are the nearest
+	for (float Radius = FMath::Min(CellSize, MaxRadius); ; Radius = FMath::Min(Radius * 2.0f, MaxRadius))
+	{
+		// A step that scans every entry anyway is the last: searching it at MaxRadius costs the
+		// same, where each further doubling would scan them all again
+		if (ScansAllEntries(Center, Radius))
+		{
+			Radius = MaxRadius;
+		}
+
+		Candidates.Reset();
+		ForEachInRadius(Center, Radius, Categories, [&Candidates](int32 EntryIndex, double DistanceSquared)
+		{
+			Candidates.Add({ DistanceSquared, EntryIndex });
+		});
+
+		if (Candidates.Num() >= Count || Radius >= MaxRadius)
+		{
+			break;
+		}
+	}
+
+	Candidates.Sort([](const FCandidate& A, const FCandidate& B) { return A.DistanceSquared < B.DistanceSquared; });
+	for (int32 Index = 0; Index < FMath::Min(Count, Candidates.Num()); ++Index)
+	{
+		OutActors.Add(Actors[Candidates[Index].EntryIndex]);
+	}
+}
+
+AActor* UNeonSpatialGridSubsystem::FindNearest(const FVector& Center, float MaxRadius, ENeonSpatialCategory Categories, const AActor* Ignore) const
+{
+	for (float Radius = FMath::Min(CellSize, MaxRadius); ; Radius = FMath::Min(Radius * 2.0f, MaxRadius))
+	{
+		// Same early exit as above, so a miss costs one scan rather than one per doubling
+		if (ScansAllEntries(Center, Radius))
+		{
+			Radius = MaxRadius;
+		}
+
+		AActor* Nearest = nullptr;
+		double NearestDistanceSquared = TNumericLimits<double>::Max();
+		ForEachInRadius(Center, Radius, Categories, [&](int32 EntryIndex, double DistanceSquared)
+		{
+			if (DistanceSquared < NearestDistanceSquared && Actors[EntryIndex] != Ignore)
+			{
+				Nearest = Actors[EntryIndex];
+				NearestDistanceSquared = DistanceSquared;
+			}
+		});
+
+		if (Nearest || Radius >= MaxRadius)
+		{
+			return Nearest;
+		}
+	}
+}
+
+void UNeonSpatialGridSubsystem::QueryCone(const FVector& Origin, const FVector& Direction, float HalfAngleDegrees, float Range, ENeonSpatialCategory Categories, TArray<AActor*>& OutActors) const
+{
+	const FVector Forward = Direction.GetSafeNormal();
+	const double CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(static_cast<double>(HalfAngleDegrees)));
+
+	ForEachInRadius(Origin, Range, Categories, [&](int32 EntryIndex, double DistanceSquared)
+	{
+		// The origin itself counts as inside
+		const double Dot = FVector::DotProduct(Forward, Entries[EntryIndex].Location - Origin);
+		if (DistanceSquared <= UE_SMALL_NUMBER || Dot >= CosHalfAngle * FMath::Sqrt(DistanceSquared))
+		{
+			OutActors.Add(Actors[EntryIndex]);
+		}
+	});
+}
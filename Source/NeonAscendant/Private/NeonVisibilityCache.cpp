@@ -0,0 +1,89 @@
+#include "NeonVisibilityCache.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarNeonVisibilityCacheMoveThreshold(
+	TEXT("ai.Neon.VisibilityCache.MoveThreshold"),
+	50.0f,
+	TEXT("Distance (cm) either end of a cached line-of-sight result may move before it is traced again."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarNeonVisibilityCacheMaxAge(
+	TEXT("ai.Neon.VisibilityCache.MaxAge"),
+	1.0f,
+	TEXT("Seconds a cached line-of-sight result is trusted; 0 disables the cache."),
+	ECVF_Default);
+
+bool FNeonVisibilityCache::Find(const AActor* Observer, const AActor* Target, const FVector& ObserverPoint, const FVector& TargetPoint, double Now, bool& bOutVisible)
+{
+	const FEntry* Entry = Entries.Find(MakeTuple(FObjectKey(Observer), FObjectKey(Target)));
+	const double MaxAge = CVarNeonVisibilityCacheMaxAge.GetValueOnGameThread();
+	const double MoveThresholdSquared = FMath::Square(CVarNeonVisibilityCacheMoveThreshold.GetValueOnGameThread());
+
+	if (!Entry
+		|| Now - Entry->Time > MaxAge
+		|| Entry->ObserverEpoch != GetEpoch(Observer)
+		|| Entry->TargetEpoch != GetEpoch(Target)
+		|| FVector::DistSquared(Entry->ObserverPoint, ObserverPoint) > MoveThresholdSquared
+		|| FVector::DistSquared(Entry->TargetPoint, TargetPoint) > MoveThresholdSquared)
+	{
+		++Misses;
+		return false;
+	}
+
+	++Hits;
+	bOutVisible = Entry->bVisible;
+	return true;
+}
+
+void FNeonVisibilityCache::Store(const AActor* Observer, const AActor* Target, const FVector& ObserverPoint, const FVector& TargetPoint, double Time,
+	uint32 ObserverEpoch, uint32 TargetEpoch, bool bVisible)
+{
+	// Find would reject it anyway, and after a Forget it would bring back an entry nothing removes
+	if (!IsValid(Observer) || !IsValid(Target) || ObserverEpoch != GetEpoch(Observer) || TargetEpoch != GetEpoch(Target))
+	{
+		return;
+	}
+
+	FEntry& Entry = Entries.FindOrAdd(MakeTuple(FObjectKey(Observer), FObjectKey(Target)));
+	Entry.ObserverPoint = ObserverPoint;
+	Entry.TargetPoint = TargetPoint;
+	Entry.Time = Time;
+	Entry.ObserverEpoch = ObserverEpoch;
+	Entry.TargetEpoch = TargetEpoch;
+	Entry.bVisible = bVisible;
+}
+
+void FNeonVisibilityCache::Invalidate(const AActor* Actor)
+{
+	++Epochs.FindOrAdd(FObjectKey(Actor));
+}
+
+void FNeonVisibilityCache::Forget(const AActor* Actor)
+{
+	const FObjectKey Key(Actor);
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		if (It.Key().Get<0>() == Key || It.Key().Get<1>() == Key)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// Kept rather than removed, so the bumped epoch outlasts traces in flight. Actors that are gone
+	// can no longer store a result, so their epochs are pruned here.
+	++Epochs.FindOrAdd(Key);
+	for (auto It = Epochs.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().ResolveObjectPtr())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FNeonVisibilityCache::Reset()
+{
+	Entries.Reset();
+	Epochs.Reset();
+}
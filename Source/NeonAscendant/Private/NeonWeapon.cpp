@@ -1,4 +1,5 @@
 #include "NeonWeapon.h"
+#include "NeonAISubsystem.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Components/ArrowComponent.h"
 #include "Kismet/GameplayStatics.h"
@@ -61,6 +62,12 @@ void ANeonWeapon::Fire()
 
 	CurrentAmmo--;
 
+	// Gunfire gives the shooter away: cached line-of-sight results involving it are re-traced
+	if (UNeonAISubsystem* AI = GetWorld()->GetSubsystem<UNeonAISubsystem>())
+	{
+		AI->GetVisibilityCache().Invalidate(GetOwner());
+	}
+
 	// Get camera viewpoint for accurate shooting
 	APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
 	if (!PlayerController)
@@ -98,7 +105,7 @@ void ANeonWeapon::Fire()
 		{
 			UGameplayStatics::ApplyPointDamage(
 				HitActor,
-				Damage,
+				Damage * DamageMultiplier,
 				ShotDirection,
 				HitResult,
 				PlayerController,
@@ -0,0 +1,235 @@
+#include "MissionCatalog.h"
+#include "MissionData.h"
+#include "MissionGenerator.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryWriter.h"
+#include "Tasks/Task.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    constexpr int32 TestSeed = 1337;
+    constexpr int32 TestBriefCount = 16384;
+    constexpr int32 TestDrawsPerStream = 4096;
+
+    // Every brief serialized back to back, strings included, so batches compare byte for byte
+    TArray<uint8> SerializeBriefs(TArrayView<const FMissionBrief> Briefs)
+    {
+        TArray<uint8> Bytes;
+        FMemoryWriter Writer(Bytes);
+        for (const FMissionBrief& Brief : Briefs)
+        {
+            FMissionBrief::StaticStruct()->SerializeBin(Writer, const_cast<FMissionBrief*>(&Brief));
+        }
+        return Bytes;
+    }
+
+    // One caller of the stream stress test: the stream it got and everything it drew.
+    struct FStreamDraws
+    {
+        uint32 StreamId = 0;
+        TArray<FMissionBriefHandle> Handles;
+    };
+
+    void DrawFromNewStream(FStreamDraws& Draws, int32 Count)
+    {
+        FMissionBriefStream Stream;
+        if (!UMissionGeneratorSingleton::AcquireBriefStream(Stream))
+        {
+            return;
+        }
+
+        Draws.StreamId = Stream.GetStreamId();
+        Draws.Handles.Reset(Count);
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            Draws.Handles.Add(Stream.Next());
+        }
+    }
+
+    // Dedicated OS thread standing in for a matchmaking thread, next to the task-based callers.
+    class FStreamDrawThread : public FRunnable
+    {
+    public:
+        FStreamDrawThread(FStreamDraws& InDraws, int32 InCount)
+            : Draws(InDraws)
+            , Count(InCount)
+        {
+        }
+
+        virtual uint32 Run() override
+        {
+            DrawFromNewStream(Draws, Count);
+            return 0;
+        }
+
+    private:
+        FStreamDraws& Draws;
+        int32 Count;
+    };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMissionCounterBasedDeterminismTest, "NeonAscendant.Mission.CounterBasedDeterminism",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// Counter-based batches must be bit-identical whatever the thread count and however the work is
+// split: the default workers at several batch sizes, balanced or not, and GenerateMissionBriefs
+// called in uneven chunks are all compared against one thread.
+bool FMissionCounterBasedDeterminismTest::RunTest(const FString& Parameters)
+{
+    if (!FMissionCatalog::Get().IsLoaded())
+    {
+        AddError(FMissionCatalog::Get().GetLoadError());
+        return false;
+    }
+
+    TArray<FMissionBrief> Briefs;
+    Briefs.SetNum(TestBriefCount);
+    UMissionGenerator::ExpandMissionBriefsAt(TestSeed, 0, Briefs, EParallelForFlags::ForceSingleThread);
+    const TArray<uint8> Expected = SerializeBriefs(Briefs);
+
+    for (const int32 MinBatchSize : { 1, 17, 256, 4096 })
+    {
+        for (const EParallelForFlags Flags : { EParallelForFlags::None, EParallelForFlags::Unbalanced })
+        {
+            Briefs.Reset();
+            Briefs.SetNum(TestBriefCount);
+            UMissionGenerator::ExpandMissionBriefsAt(TestSeed, 0, Briefs, Flags, MinBatchSize);
+            TestTrue(FString::Printf(TEXT("%s ParallelFor with min batch %d matches one thread"),
+                Flags == EParallelForFlags::Unbalanced ? TEXT("Unbalanced") : TEXT("Balanced"), MinBatchSize),
+                SerializeBriefs(Briefs) == Expected);
+        }
+    }
+
+    // Uneven slices of the index range, each expanded on its own
+    Briefs.Reset();
+    Briefs.SetNum(TestBriefCount);
+    for (int32 First = 0, Size = 1; First < TestBriefCount; First += Size, Size = Size * 3 + 1)
+    {
+        const int32 SliceSize = FMath::Min(Size, TestBriefCount - First);
+        UMissionGenerator::ExpandMissionBriefsAt(TestSeed, First, TArrayView<FMissionBrief>(Briefs).Slice(First, SliceSize));
+    }
+    TestTrue(TEXT("Uneven slices match one thread"), SerializeBriefs(Briefs) == Expected);
+
+    // Through the generator, in chunks that straddle every worker split
+    UMissionGenerator* Generator = NewObject<UMissionGenerator>();
+    Generator->SeedGenerator(TestSeed);
+    Generator->SetRandomMode(EMissionRandomMode::CounterBased);
+
+    Briefs.Reset();
+    TArray<FMissionBrief> Chunk;
+    for (int32 ChunkSize = 1; Briefs.Num() < TestBriefCount; ChunkSize = ChunkSize * 3 + 1)
+    {
+        Generator->GenerateMissionBriefs(FMath::Min(ChunkSize, TestBriefCount - Briefs.Num()), Chunk);
+        Briefs.Append(Chunk);
+    }
+    TestTrue(TEXT("GenerateMissionBriefs in uneven chunks matches one thread"), SerializeBriefs(Briefs) == Expected);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMissionBriefStreamConcurrencyTest, "NeonAscendant.Mission.BriefStreamConcurrency",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// Many tasks plus a few raw threads acquire brief streams at the same time and draw from them.
+// Every stream id must be unique and every draw must match a serial replay of the same stream, so
+// neither the scheduling nor the other callers leaked into a sequence.
+bool FMissionBriefStreamConcurrencyTest::RunTest(const FString& Parameters)
+{
+    if (!FMissionCatalog::Get().IsLoaded())
+    {
+        AddError(FMissionCatalog::Get().GetLoadError());
+        return false;
+    }
+
+    const int32 NumTasks = FMath::Max(8, FTaskGraphInterface::Get().GetNumWorkerThreads() * 4);
+    const int32 NumThreads = 4;
+
+    UMissionGeneratorSingleton::SeedBriefStreams(TestSeed);
+
+    TArray<FStreamDraws> Draws;
+    Draws.SetNum(NumTasks + NumThreads);
+
+    TArray<TUniquePtr<FStreamDrawThread>> Runnables;
+    TArray<TUniquePtr<FRunnableThread>> Threads;
+    for (int32 Thread = 0; Thread < NumThreads; ++Thread)
+    {
+        Runnables.Add(MakeUnique<FStreamDrawThread>(Draws[NumTasks + Thread], TestDrawsPerStream));
+        Threads.Add(TUniquePtr<FRunnableThread>(FRunnableThread::Create(Runnables.Last().Get(), *FString::Printf(TEXT("MissionStreamTest%d"), Thread))));
+    }
+
+    TArray<UE::Tasks::FTask> Tasks;
+    for (int32 Task = 0; Task < NumTasks; ++Task)
+    {
+        Tasks.Add(UE::Tasks::Launch(TEXT("MissionStreamTest"), [&Caller = Draws[Task]]()
+        {
+            DrawFromNewStream(Caller, TestDrawsPerStream);
+        }));
+    }
+
+    UE::Tasks::Wait(Tasks);
+    for (TUniquePtr<FRunnableThread>& Thread : Threads)
+    {
+        Thread->WaitForCompletion();
+    }
+
+    TSet<uint32> StreamIds;
+    for (const FStreamDraws& Caller : Draws)
+    {
+        bool bAlreadySeen = false;
+        StreamIds.Add(Caller.StreamId, &bAlreadySeen);
+        if (!TestTrue(TEXT("Every caller got a stream"), Caller.StreamId != 0)
+            || !TestFalse(FString::Printf(TEXT("Stream %u handed out once"), Caller.StreamId), bAlreadySeen))
+        {
+            return false;
+        }
+
+        const FMissionBriefStream Replay = UMissionGeneratorSingleton::GetBriefStream(Caller.StreamId);
+        for (int32 Index = 0; Index < Caller.Handles.Num(); ++Index)
+        {
+            if (!Caller.Handles[Index].IsValid() || Caller.Handles[Index] != Replay.At(Index))
+            {
+                AddError(FString::Printf(TEXT("Brief %d of stream %u differs from its serial replay"), Index, Caller.StreamId));
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMissionBriefStreamExhaustionTest, "NeonAscendant.Mission.BriefStreamExhaustion",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+// Every id in 1..MaxStreamId is handed out once, then acquisition fails until the streams are
+// reseeded instead of running into the seed bits.
+bool FMissionBriefStreamExhaustionTest::RunTest(const FString& Parameters)
+{
+    // Once for the acquisition that ran out, once for the retry
+    AddExpectedError(TEXT("mission brief stream ids"), EAutomationExpectedErrorFlags::Contains, 2);
+    UMissionGeneratorSingleton::SeedBriefStreams(TestSeed);
+
+    FMissionBriefStream Stream;
+    uint32 LastStreamId = 0;
+    bool bInOrder = true;
+    while (UMissionGeneratorSingleton::AcquireBriefStream(Stream))
+    {
+        bInOrder &= Stream.GetStreamId() == LastStreamId + 1;
+        LastStreamId = Stream.GetStreamId();
+    }
+
+    TestTrue(TEXT("Stream ids are handed out in order"), bInOrder);
+    TestEqual(TEXT("Last stream id"), LastStreamId, FMissionBriefStream::MaxStreamId);
+    TestFalse(TEXT("Acquisition keeps failing once exhausted"), UMissionGeneratorSingleton::AcquireBriefStream(Stream));
+
+    UMissionGeneratorSingleton::SeedBriefStreams(TestSeed);
+    TestTrue(TEXT("Reseeding starts the ids over"), UMissionGeneratorSingleton::AcquireBriefStream(Stream) && Stream.GetStreamId() == 1);
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AnalyzeMissionCoverageCommandlet.generated.h"
+
+// Samples the counter-based mission sequence across worker threads and compares what came out
+// with what the catalog weights and compatibility rules say should come out: marginal and
+// pairwise district/faction/complication frequencies, chi-square against the configured weights,
+// and combinations that were never (or should never have been) seen.
+// Usage: UnrealEditor-Cmd NeonAscendant.uproject -run=AnalyzeMissionCoverage -nullrhi -unattended
+//        [-Seed=<n>] [-Count=<n>] [-Output=<json>]
+UCLASS()
+class NEONASCENDANT_API UAnalyzeMissionCoverageCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UAnalyzeMissionCoverageCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
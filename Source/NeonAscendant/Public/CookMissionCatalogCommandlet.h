@@ -0,0 +1,18 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CookMissionCatalogCommandlet.generated.h"
+
+// Cooks Data/MissionCatalog.json into the memory-mapped binary catalog.
+// Usage: UnrealEditor-Cmd NeonAscendant.uproject -run=CookMissionCatalog [-Source=<json>] [-Output=<ncat>]
+UCLASS()
+class NEONASCENDANT_API UCookMissionCatalogCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UCookMissionCatalogCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
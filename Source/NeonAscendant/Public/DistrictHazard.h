@@ -26,6 +26,7 @@ public:
 	ADistrictHazard();
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaTime) override;
 
 	// Hazard configuration
@@ -55,26 +56,16 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	class UParticleSystemComponent* HazardEffect = nullptr;
 
-	// Damage tracking to prevent spam
+	// Damage tracking to prevent spam; also the set of actors currently inside
 	UPROPERTY(BlueprintReadOnly, Category = "Hazard")
 	TMap<AActor*, double> LastDamageTime;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hazard")
 	float DamageTickRate = 1.0f; // Damage every X seconds
 
-	virtual void OnHazardBeginOverlap(
-		class UPrimitiveComponent* OverlappedComponent,
-		AActor* OtherActor,
-		class UPrimitiveComponent* OtherComp,
-		int32 OtherBodyIndex,
-		bool bFromSweep,
-		const FHitResult& SweepResult);
-
-	virtual void OnHazardEndOverlap(
-		class UPrimitiveComponent* OverlappedComponent,
-		AActor* OtherActor,
-		class UPrimitiveComponent* OtherComp,
-		int32 OtherBodyIndex);
+	// Actors inside are found through UNeonSpatialGridSubsystem rather than overlap events
+	void OnActorEntered(AActor* Actor);
+	void OnActorLeft(AActor* Actor);
 
 	void ApplyHazardDamage(AActor* HitActor);
 	void CreateHazardEffects();
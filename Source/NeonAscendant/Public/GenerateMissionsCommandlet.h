@@ -0,0 +1,21 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GenerateMissionsCommandlet.generated.h"
+
+// Pre-rolls mission briefs headless and streams them to disk in fixed-size chunks, so memory use
+// does not grow with -Count. Brief k is UMissionGenerator::GenerateMissionBriefHandleAt(Seed, k),
+// or brief k of the seeded no-repeat rotation with -Rotation.
+// Usage: UnrealEditor-Cmd NeonAscendant.uproject -run=GenerateMissions -Seed=<n> -Count=<n> -Output=<path>
+//        [-Format=ndjson|csv] [-StartIndex=<n>] [-ChunkSize=<n>] [-Rotation]
+UCLASS()
+class NEONASCENDANT_API UGenerateMissionsCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UGenerateMissionsCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
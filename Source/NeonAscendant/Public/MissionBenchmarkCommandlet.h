@@ -0,0 +1,28 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MissionBenchmarkCommandlet.generated.h"
+
+// Headless micro-benchmarks for the mission pipeline. Each benchmark runs one warm-up iteration
+// followed by -Iterations= steady-state iterations; both are reported separately, on the console
+// and as JSON (-Output=, default Saved/Benchmarks/MissionBenchmark.json). The Streams group times
+// tasks and raw threads drawing from per-caller brief streams concurrently against one serial
+// caller. The Layouts group times MissionLayout::Generate
+// with parallel and serial sector filling and checks both agree and every layout is connected.
+// The Loot group rolls a simulated season of squad rewards in one batch and against a serial replay.
+// The Difficulty group times MissionDifficulty::Estimate per brief, i.e. per mission start.
+// Determinism of counter-based batches and independence of concurrent streams are covered by the
+// NeonAscendant.Mission automation tests.
+// Usage: UnrealEditor-Cmd NeonAscendant.uproject -run=MissionBenchmark -nullrhi -unattended
+//        [-Groups=Catalog,Generate,Batches,Codes,Streams,Layouts,Loot,Difficulty] [-Count=<n>] [-Iterations=<n>] [-Output=<path>]
+UCLASS()
+class NEONASCENDANT_API UMissionBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UMissionBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
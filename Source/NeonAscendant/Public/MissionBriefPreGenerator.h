@@ -0,0 +1,116 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MissionBriefHandle.h"
+#include "Tasks/Task.h"
+
+#include <atomic>
+
+// Bounded single-producer/single-consumer ring of brief handles, each tagged with its index in the
+// seed's sequence. Head and Tail are free-running counters; the producer only writes Head and the
+// consumer only writes Tail, so neither side locks.
+class FMissionBriefRingBuffer
+{
+public:
+    struct FSlot
+    {
+        FMissionBriefHandle Handle;
+        int64 Index = 0;
+    };
+
+    explicit FMissionBriefRingBuffer(int32 MinCapacity)
+    {
+        const uint32 Capacity = FMath::RoundUpToPowerOfTwo(static_cast<uint32>(FMath::Max(MinCapacity, 2)));
+        Slots.SetNumZeroed(Capacity);
+        Mask = Capacity - 1;
+    }
+
+    // Producer side.
+    bool TryPush(const FSlot& Slot)
+    {
+        const uint32 CurrentHead = Head.load(std::memory_order_relaxed);
+        if (CurrentHead - Tail.load(std::memory_order_acquire) > Mask)
+        {
+            return false;
+        }
+
+        Slots[CurrentHead & Mask] = Slot;
+        Head.store(CurrentHead + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side.
+    bool TryPop(FSlot& OutSlot)
+    {
+        const uint32 CurrentTail = Tail.load(std::memory_order_relaxed);
+        if (CurrentTail == Head.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        OutSlot = Slots[CurrentTail & Mask];
+        Tail.store(CurrentTail + 1, std::memory_order_release);
+        return true;
+    }
+
+    int32 Num() const
+    {
+        return static_cast<int32>(Head.load(std::memory_order_acquire) - Tail.load(std::memory_order_acquire));
+    }
+
+    int32 Capacity() const
+    {
+        return static_cast<int32>(Mask + 1);
+    }
+
+private:
+    TArray<FSlot> Slots;
+    uint32 Mask = 0;
+
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> Head{0};
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> Tail{0};
+};
+
+// Keeps a ring of ready briefs topped up by one background task. The k-th brief produced is
+// UMissionGenerator::GenerateMissionBriefHandleAt(Seed, k), so the pre-rolled sequence is
+// reproducible from the seed. Pop and RequestRefill must be called from the game thread.
+class NEONASCENDANT_API FMissionBriefPreGenerator
+{
+public:
+    FMissionBriefPreGenerator(int32 InSeed, int32 Capacity, int32 InRefillThreshold);
+    ~FMissionBriefPreGenerator();
+
+    // Returns the next brief of the sequence. When the ring is empty it counts a stall and
+    // generates that brief synchronously; the producer then skips past it.
+    FMissionBriefHandle Pop();
+
+    // Launches the producer task unless one is already running.
+    void RequestRefill();
+
+    // Blocks until the in-flight producer task (if any) has finished.
+    void WaitForRefill();
+
+    int32 GetSeed() const { return Seed; }
+    int32 GetDepth() const { return Buffer.Num(); }
+    int32 GetCapacity() const { return Buffer.Capacity(); }
+    int64 GetStallCount() const { return StallCount.load(std::memory_order_relaxed); }
+
+private:
+    // Runs on the producer task only.
+    void Refill();
+
+    FMissionBriefRingBuffer Buffer;
+    const int32 Seed;
+    const int32 RefillThreshold;
+
+    // Owned by whichever producer task currently holds bRefillInFlight.
+    int64 NextProducerIndex = 0;
+
+    // Written by the consumer only; read by the producer to skip briefs generated on a stall.
+    std::atomic<int64> NextConsumerIndex{0};
+
+    std::atomic<bool> bRefillInFlight{false};
+    std::atomic<int64> StallCount{0};
+
+    UE::Tasks::FTask RefillTask;
+};
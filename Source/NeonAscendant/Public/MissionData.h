@@ -1,15 +1,81 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "MissionBriefHandle.h"
 #include "MissionTypes.h"
 
+// Entry names of a brief; enough for FindBriefHandle to find it again in a reloaded catalog
+// without keeping an expanded copy of its strings.
+struct FMissionBriefNames
+{
+    FName District;
+    FName Opposition;
+    FName Archetype;
+    FName FeaturedAbility;
+    FName PrimaryWeapon;
+    FName BackupImplant;
+    FName Complication;
+    FName ExtractionCondition;
+};
+
 namespace NeonAscendantData
 {
+    // Whole catalog sections, each copied out the first time it is asked for (tools and
+    // commandlets). Game thread only; references stay valid until the next reload.
     const TArray<FAscendantArchetype>& GetArchetypes();
     const TArray<FAscendantWeapon>& GetWeapons();
     const TArray<FAscendantImplant>& GetImplants();
     const TArray<FAscendantDistrict>& GetDistricts();
     const TArray<FAscendantFaction>& GetFactions();
-    const TArray<FString>& GetComplications();
+    const TArray<FAscendantComplication>& GetComplications();
     const TArray<FString>& GetExtractionConditions();
+
+    // Entries referenced by a handle, copied straight from the cooked records; safe on any thread
+    // while the catalog is not being reloaded. An index outside the loaded catalog (e.g. a handle
+    // kept across a reload that removed its entry) gives an empty entry.
+    FAscendantDistrict GetDistrict(const FMissionBriefHandle& Handle);
+    FAscendantFaction GetOpposition(const FMissionBriefHandle& Handle);
+    FAscendantArchetype GetArchetype(const FMissionBriefHandle& Handle);
+    FAscendantAbility GetFeaturedAbility(const FMissionBriefHandle& Handle);
+    FAscendantWeapon GetPrimaryWeapon(const FMissionBriefHandle& Handle);
+    FAscendantImplant GetBackupImplant(const FMissionBriefHandle& Handle);
+    FString GetComplication(const FMissionBriefHandle& Handle);
+    FString GetExtractionCondition(const FMissionBriefHandle& Handle);
+
+    // Copies the referenced entries into the Blueprint-facing brief, same rules as above.
+    FMissionBrief ExpandBrief(const FMissionBriefHandle& Handle);
+
+    // Resolves an expanded brief back to catalog indices through the name index. Returns false if any
+    // entry is not part of the catalog (e.g. a brief authored by hand in Blueprint).
+    bool FindBriefHandle(const FMissionBrief& Brief, FMissionBriefHandle& OutHandle);
+    bool FindBriefHandle(const FMissionBriefNames& Names, FMissionBriefHandle& OutHandle);
+
+    // Names of the referenced entries, same rules as the getters above (NAME_None out of range).
+    FMissionBriefNames GetBriefNames(const FMissionBriefHandle& Handle);
+
+    // Mission.* gameplay tags mapped to the referenced entries; invalid when an entry has none.
+    // Game thread only.
+    FGameplayTag GetDistrictTag(const FMissionBriefHandle& Handle);
+    FGameplayTag GetOppositionTag(const FMissionBriefHandle& Handle);
+    FGameplayTag GetComplicationTag(const FMissionBriefHandle& Handle);
+
+    // Entry index carrying the tag, or INDEX_NONE.
+    int32 FindDistrictByTag(const FGameplayTag& Tag);
+    int32 FindFactionByTag(const FGameplayTag& Tag);
+    int32 FindComplicationByTag(const FGameplayTag& Tag);
+
+    // Drops the cached tables and tag lookups and rebuilds the NeonMissionCore derived data (name
+    // index, sampler, mission-space layout) from the loaded catalog. Same threading rules as
+    // ReloadCatalog.
+    void RebuildDerivedTables();
+
+    // Re-cooks Data/MissionCatalog.json and rebuilds every table derived from it. Game thread only;
+    // callers must stop background brief generation first (see UMissionGeneratorSingleton).
+    bool ReloadCatalog(FString& OutError);
+
+    // Broadcast on the game thread after ReloadCatalog swapped in a new catalog. Indices held from
+    // the old one (handles, loot rules, equipped implants) must be re-resolved by name through
+    // FindBriefHandle, or dropped.
+    FSimpleMulticastDelegate& OnCatalogReloaded();
 }
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MissionBriefHandle.h"
+#include "MissionTypes.h"
+#include "MissionDifficulty.generated.h"
+
+// Result of MissionDifficulty::Estimate.
+USTRUCT(BlueprintType)
+struct FMissionDifficulty
+{
+    GENERATED_BODY()
+
+    // 0 (trivial) to 100 (near-certain death); weighs survival chance against time to clear.
+    UPROPERTY(BlueprintReadOnly, Category="Difficulty")
+    float Score = 0.0f;
+
+    // Fraction of trials in which every enemy died before the player did.
+    UPROPERTY(BlueprintReadOnly, Category="Difficulty")
+    float SurvivalChance = 0.0f;
+
+    // Seconds until the last enemy died, over the surviving trials.
+    UPROPERTY(BlueprintReadOnly, Category="Difficulty")
+    float MeanTimeToClear = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category="Difficulty")
+    float P90TimeToClear = 0.0f;
+
+    // Zero when no estimate was made.
+    UPROPERTY(BlueprintReadOnly, Category="Difficulty")
+    int32 Trials = 0;
+};
+
+// Inputs of the abstract combat model. Spawn counts and hazard ranges default to what
+// ANeonGameMode spawns for a mission; the combatant stats are zero until FromClassDefaults reads
+// them from the player, enemy and enemy weapon classes, so they follow the gameplay tuning.
+USTRUCT(BlueprintType)
+struct FMissionCombatSettings
+{
+    GENERATED_BODY()
+
+    FMissionCombatSettings();
+
+    // Settings with the combatant stats of PlayerClass (an ANeonCharacter) and EnemyClass (an
+    // ANeonEnemy) and its weapon; the native classes stand in for null or unrelated classes, and
+    // the firing cap comes from ai.Neon.AttackTokens.PerTarget. Game thread.
+    static FMissionCombatSettings FromClassDefaults(const UClass* PlayerClass = nullptr, const UClass* EnemyClass = nullptr);
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Difficulty")
+    int32 Trials = 4096;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Difficulty")
+    float TimeStepSeconds = 0.25f;
+
+    // Trials still running after this long count as failures.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Difficulty")
+    float MaxSeconds = 180.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Difficulty")
+    float PlayerHealth = 0.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Difficulty")
+    int32 EnemyCount = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Difficulty")
+    float EnemyHealth = 0.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Difficulty")
+    float EnemyDamagePerShot = 0.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Difficulty")
+    float EnemyFireInterval = 0.0f;
+
+    // Enemies firing at the player at once (attack tokens); 0 lets every living enemy fire.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Difficulty")
+    int32 MaxEnemiesFiring = 0;
+
+    // Fraction of enemy shots that land, cover and range included. Gameplay has no accuracy stat
+    // (enemies fire whenever they hold a token), so this is the model's calibration against
+    // playtest survival rather than a copy of a tuning value.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Difficulty")
+    float EnemyAccuracy = 0.03f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Difficulty")
+    int32 MinHazardCount = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Difficulty")
+    int32 MaxHazardCount = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Difficulty")
+    float MinHazardDamagePerSecond = 0.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Difficulty")
+    float MaxHazardDamagePerSecond = 0.0f;
+
+    // Chance per time step that the player stands inside a given hazard.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Difficulty")
+    float HazardExposure = 0.1f;
+};
+
+// Monte Carlo encounter estimate for a brief, without spawning anything: the featured weapon's
+// category and DamageProfile, the featured ability's cooldown and damage type, the spawned enemy
+// count and the district hazard DPS ranges drive a simple time-stepped duel. Trials run in blocks
+// of structure-of-arrays lanes spread across worker threads; each trial draws from a counter-based
+// stream keyed by the brief, so the estimate is deterministic. Any thread; reads the catalog.
+namespace MissionDifficulty
+{
+    // No estimate (Trials 0) when the settings have no player or enemy health.
+    FMissionDifficulty Estimate(const FMissionBriefHandle& Handle, const FMissionCombatSettings& Settings);
+
+    // Same with the brief's weapon and featured ability already resolved; reads nothing from the
+    // catalog, so a task can run it while the catalog is reloaded.
+    FMissionDifficulty Estimate(const FMissionBriefHandle& Handle, const FAscendantWeapon& PrimaryWeapon,
+        const FAscendantAbility& FeaturedAbility, const FMissionCombatSettings& Settings);
+}
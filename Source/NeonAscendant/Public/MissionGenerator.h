@@ -2,8 +2,23 @@
 
 #include "CoreMinimal.h"
 #include "MissionTypes.h"
+#include "MissionBriefGenerator.h"
+#include "MissionBriefHandle.h"
+#include "MissionBriefStream.h"
+#include "Async/ParallelFor.h"
 #include "MissionGenerator.generated.h"
 
+class FMissionBriefPreGenerator;
+
+UENUM(BlueprintType)
+enum class EMissionRandomMode : uint8
+{
+    // One FRandomStream shared by every draw; brief k depends on all briefs before it.
+    Sequential = 0 UMETA(DisplayName = "Sequential"),
+    // Brief k depends only on (seed, k); batches are generated in parallel.
+    CounterBased = 1 UMETA(DisplayName = "Counter Based")
+};
+
 UCLASS(BlueprintType)
 class NEONASCENDANT_API UMissionGenerator : public UObject
 {
@@ -15,17 +30,66 @@ public:
     UFUNCTION(BlueprintCallable, Category="Mission")
     void SeedGenerator(int32 Seed);
 
+    // Current seed; seeds from the clock first if SeedGenerator was never called.
+    UFUNCTION(BlueprintCallable, Category="Mission")
+    int32 GetSeed();
+
+    UFUNCTION(BlueprintCallable, Category="Mission")
+    void SetRandomMode(EMissionRandomMode NewMode);
+
+    UFUNCTION(BlueprintPure, Category="Mission")
+    EMissionRandomMode GetRandomMode() const { return RandomMode; }
+
     UFUNCTION(BlueprintCallable, Category="Mission")
     FMissionBrief GenerateMissionBrief();
 
     UFUNCTION(BlueprintCallable, Category="Mission")
     void GenerateMissionBriefs(int32 Count, TArray<FMissionBrief>& OutBriefs);
 
-private:
-    FRandomStream RandomStream;
-    bool bHasSeed;
+    // Brief number BriefIndex of the current seed's counter-based sequence, regardless of mode.
+    UFUNCTION(BlueprintCallable, Category="Mission")
+    FMissionBrief GenerateMissionBriefAtIndex(int64 BriefIndex);
+
+    // Number of distinct briefs the catalog can produce.
+    UFUNCTION(BlueprintPure, Category="Mission")
+    static int64 GetTotalMissionCombinations();
+
+    // Brief number RotationIndex of the current seed's rotation: a seeded permutation of every
+    // distinct brief, so indices 0..GetTotalMissionCombinations()-1 never repeat a brief.
+    UFUNCTION(BlueprintCallable, Category="Mission")
+    FMissionBrief GetRotationMissionBrief(int64 RotationIndex);
+
+    // Next Count briefs of the current seed's rotation; no duplicates until the rotation wraps.
+    UFUNCTION(BlueprintCallable, Category="Mission")
+    void GenerateUniqueMissionBriefs(int32 Count, TArray<FMissionBrief>& OutBriefs);
+
+    // Share code for a catalog brief (see MissionBriefCode); false if the brief is not in the catalog.
+    UFUNCTION(BlueprintCallable, Category="Mission")
+    static bool EncodeMissionShareCode(const FMissionBrief& Brief, FString& OutShareCode);
+
+    // False for malformed codes and codes from another catalog version.
+    UFUNCTION(BlueprintCallable, Category="Mission")
+    static bool DecodeMissionShareCode(const FString& ShareCode, FMissionBrief& OutBrief);
+
+    // Allocation-free variants for C++ callers; draw the same sequence as the expanded versions.
+    // District, faction and complication draws honour catalog weights and compatibility rules.
+    FMissionBriefHandle GenerateMissionBriefHandle();
+    void GenerateMissionBriefHandles(int32 Count, TArray<FMissionBriefHandle>& OutHandles);
+    void GenerateUniqueMissionBriefHandles(int32 Count, TArray<FMissionBriefHandle>& OutHandles);
 
-    void EnsureRandomStream();
+    // Pure function of (Seed, BriefIndex); safe to call from any thread.
+    static FMissionBriefHandle GenerateMissionBriefHandleAt(int32 Seed, int64 BriefIndex);
+
+    // Expands briefs FirstIndex.. of Seed's counter-based sequence into OutBriefs, split across
+    // workers by ParallelFor; the counter-based GenerateMissionBriefs is this with default flags.
+    // The result does not depend on Flags or MinBatchSize.
+    static void ExpandMissionBriefsAt(int32 Seed, int64 FirstIndex, TArrayView<FMissionBrief> OutBriefs,
+        EParallelForFlags Flags = EParallelForFlags::None, int32 MinBatchSize = 256);
+
+private:
+    // Sequence state lives in NeonMissionCore so tools outside the engine generate the same briefs
+    FMissionBriefGenerator Generator;
+    EMissionRandomMode RandomMode;
 };
 
 UCLASS(Config=Game)
@@ -34,12 +98,74 @@ class NEONASCENDANT_API UMissionGeneratorSingleton : public UObject
     GENERATED_BODY()
 
 public:
+    // Shared generator for game-thread callers. Its stream is mutated on every draw, so other
+    // threads must use AcquireBriefStream instead.
     UFUNCTION(BlueprintPure, Category="Mission")
     static UMissionGenerator* GetGenerator();
 
+    // Independent brief stream for one caller (async loading tasks, matchmaking threads, ...).
+    // Any thread; costs one atomic compare-exchange. Ids are handed out in call order, so use
+    // GetBriefStream with a fixed id when the sequence has to be reproducible. False once all
+    // FMissionBriefStream::MaxStreamId ids of the current stream seed are taken; SeedBriefStreams
+    // starts over.
+    static bool AcquireBriefStream(FMissionBriefStream& OutStream);
+
+    // Stream StreamId (1..FMissionBriefStream::MaxStreamId) of the current stream seed. Any thread.
+    static FMissionBriefStream GetBriefStream(uint32 StreamId);
+
+    // Re-roots every stream acquired afterwards and restarts id assignment. Game thread only;
+    // nothing may be acquiring streams meanwhile.
+    static void SeedBriefStreams(int32 Seed);
+
+    // Next mission from the pre-generated ring, i.e. brief k of GetGenerator()'s seed for the k-th
+    // call; generates that same brief synchronously (and counts a stall) when the background
+    // producer has not caught up. Game thread only.
+    static FMissionBriefHandle PopNextMissionBrief();
+
+    UFUNCTION(BlueprintCallable, Category="Mission")
+    static FMissionBrief GetNextMissionBrief();
+
+    // Starts the background producer (seeded from GetGenerator()) if it is not running yet.
+    UFUNCTION(BlueprintCallable, Category="Mission")
+    static void WarmUpPreGeneration();
+
+    // Restarts pre-generation with a new seed, discarding any buffered briefs. Seeding the shared
+    // generator through SeedGenerator does this too.
+    UFUNCTION(BlueprintCallable, Category="Mission")
+    static void SeedPreGeneration(int32 Seed);
+
+    // Briefs currently ready in the ring.
+    UFUNCTION(BlueprintPure, Category="Mission")
+    static int32 GetBufferedBriefCount();
+
+    // Requests that found the ring empty since pre-generation started.
+    UFUNCTION(BlueprintPure, Category="Mission")
+    static int64 GetBufferStallCount();
+
+    // Re-cooks and reloads the mission catalog. Buffered briefs are discarded because their
+    // indices refer to the old tables; pre-generation restarts with the same seed. Callers
+    // drawing from brief streams on other threads must be stopped first.
+    UFUNCTION(BlueprintCallable, Category="Mission")
+    static bool ReloadMissionCatalog();
+
     // Cleanup singleton instance (called during module shutdown)
     static void Shutdown();
 
+    // Ring size for pre-generated briefs (rounded up to a power of two)
+    UPROPERTY(Config)
+    int32 PreGeneratedBriefCapacity = 64;
+
+    // Producer task is relaunched when the ring drops to this many briefs
+    UPROPERTY(Config)
+    int32 PreGeneratedBriefRefillThreshold = 16;
+
 private:
+    // SeedGenerator restarts the ring when the shared generator is re-seeded
+    friend class UMissionGenerator;
+
     static TObjectPtr<UMissionGenerator> GeneratorInstance;
+    static TUniquePtr<FMissionBriefPreGenerator> PreGenerator;
+
+    static FMissionBriefPreGenerator& GetPreGenerator();
+    static void StartPreGeneration(int32 Seed);
 };
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "MissionBriefHandle.h"
+#include "MissionLootTables.h"
+#include "MissionLootSubsystem.generated.h"
+
+struct FMissionBrief;
+
+UENUM(BlueprintType)
+enum class EExtractionOutcome : uint8
+{
+    Failed = 0 UMETA(DisplayName = "Failed"),
+    Standard = 1 UMETA(DisplayName = "Standard"),
+    // The extraction condition's bonus objective was met
+    Premium = 2 UMETA(DisplayName = "Premium")
+};
+
+USTRUCT(BlueprintType)
+struct FMissionLootReward
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category="Loot")
+    FName Item;
+
+    UPROPERTY(BlueprintReadOnly, Category="Loot")
+    int32 Quantity = 0;
+
+    // Squad slot the drop belongs to
+    UPROPERTY(BlueprintReadOnly, Category="Loot")
+    int32 SquadSlot = 0;
+};
+
+// Rolls extraction rewards from Data/LootTables.json (see FMissionLootTables). Rolls use the
+// counter-based seeding of the mission generator: reward k of a seed is a pure function of
+// (seed, mission index, squad slot), so any payout can be re-rolled and audited later.
+UCLASS()
+class NEONASCENDANT_API UMissionLootSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // Re-reads the loot tables; keeps the current ones if the file is invalid. Runs by itself
+    // after a mission catalog reload, since rules are resolved against the catalog.
+    UFUNCTION(BlueprintCallable, Category="Loot")
+    bool ReloadLootTables();
+
+    // Seed of every roll. Until set, the shared mission generator's seed, so a run's briefs and
+    // rewards are reproduced from one number.
+    UFUNCTION(BlueprintCallable, Category="Loot")
+    void SetLootSeed(int32 Seed);
+
+    UFUNCTION(BlueprintCallable, Category="Loot")
+    int32 GetLootSeed() const;
+
+    // Rewards for every squad member (at most FMissionLootTables::MaxSquadSize) extracting from
+    // mission number MissionIndex. Replaces OutRewards.
+    UFUNCTION(BlueprintCallable, Category="Loot")
+    void RollSquadRewards(const FMissionBrief& Brief, EExtractionOutcome Outcome, int64 MissionIndex, int32 SquadSize, TArray<FMissionLootReward>& OutRewards) const;
+
+    // Allocation-light variant for C++ callers; same rolls as RollSquadRewards.
+    void RollSquadRewardsForHandle(const FMissionBriefHandle& Brief, EExtractionOutcome Outcome, int64 MissionIndex, int32 SquadSize, TArray<FMissionLootReward>& OutRewards) const;
+
+    // Any number of rolls in one parallel call, e.g. a simulated season. See FMissionLootTables::RollBatch.
+    void RollBatch(TConstArrayView<FMissionLootRequest> Requests, TArray<FMissionLootDrop>& OutDrops, TArray<int32>& OutOffsets) const;
+
+    const FMissionLootTables& GetTables() const { return Tables; }
+
+    static FMissionLootRequest MakeRequest(const FMissionBriefHandle& Brief, EExtractionOutcome Outcome, int64 MissionIndex, int32 SquadSlot);
+
+private:
+    void HandleCatalogReloaded();
+
+    FMissionLootTables Tables;
+    FDelegateHandle CatalogReloadedHandle;
+    int32 LootSeed = 0;
+    bool bHasLootSeed = false;
+};
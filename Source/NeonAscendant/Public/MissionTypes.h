@@ -91,6 +91,10 @@ struct FAscendantDistrict
 
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="District")
     TArray<FString> EnemyProfiles;
+
+    // Relative selection weight when rolling a district
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="District")
+    float Weight = 1.0f;
 };
 
 USTRUCT(BlueprintType)
@@ -106,6 +110,35 @@ struct FAscendantFaction
 
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Faction")
     TArray<FString> SignatureTactics;
+
+    // Relative selection weight among the factions operating in the rolled district
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Faction")
+    float Weight = 1.0f;
+
+    // Districts this faction can oppose the player in; empty means every district
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Faction")
+    TArray<FString> OperatingDistricts;
+};
+
+USTRUCT(BlueprintType)
+struct FAscendantComplication
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Complication")
+    FString Description;
+
+    // Relative selection weight among the complications compatible with the district and faction
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Complication")
+    float Weight = 1.0f;
+
+    // Districts where this complication can occur; empty means every district
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Complication")
+    TArray<FString> Districts;
+
+    // Opposing factions that can cause this complication; empty means every faction
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Complication")
+    TArray<FString> Factions;
 };
 
 USTRUCT(BlueprintType)
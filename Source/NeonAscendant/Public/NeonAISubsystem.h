@@ -0,0 +1,194 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NeonEnemyController.h"
+#include "NeonVisibilityCache.h"
+#include "NeonAttackTokens.h"
+#include "NeonAISubsystem.generated.h"
+
+class ANeonEnemy;
+class ANeonCharacter;
+
+// How often the batched pass attends to an enemy
+enum class ENeonAITier : uint8
+{
+	// Engaged or retreating, or close and either on screen or near attack range: decides every
+	// 0.2 s like the per-actor tick
+	Full,
+	// Investigating, mid-range or on screen: decides every 0.5 s
+	Reduced,
+	// Far and off screen: decides every 1.5 s, no traces or fire checks
+	Dormant,
+	Count
+};
+
+// Runs every enemy's AI in one batched pass per frame instead of one tick per enemy and one per
+// controller. The hot per-enemy data (positions, distances, states, timers, health ratios) lives
+// in parallel arrays indexed by a slot stored on the enemy; distances to each enemy's target
+// player for the whole crowd are computed four at a time, then state transitions and fire
+// commands are issued per enemy.
+// Line of sight comes from async traces started here each frame, at most
+// ai.Neon.MaxTracesPerFrame of them, and delivered to the controllers a frame later.
+// Each enemy sits in a significance tier (distance, on-screen, AI state) that sets how often it
+// decides, and decides at its own phase within that interval, so the work of a crowd spawned in
+// one frame is spread evenly over the following frames instead of landing in the same ones.
+// ai.Neon.BatchedUpdate 0 falls back to the per-actor ticks, and ai.Neon.ReportCost prints the
+// measured per-enemy cost of both paths, and the game-thread frame time under each, which also
+// counts the tick dispatch the per-actor path pays.
+UCLASS()
+class NEONASCENDANT_API UNeonAISubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Value of ai.Neon.BatchedUpdate
+	static bool IsBatchedUpdateEnabled();
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual void Deinitialize() override;
+
+	void RegisterEnemy(ANeonEnemy* Enemy);
+	void UnregisterEnemy(ANeonEnemy* Enemy);
+
+	// Pushed by the enemy on damage and death, so the pass never reads health from actors
+	void SetHealthRatio(const ANeonEnemy* Enemy, float HealthRatio);
+
+	// Pushed by the controller on every state change, whichever path made it
+	void OnAIStateChanged(const ANeonEnemy* Enemy, EEnemyAIState NewState, double Time);
+
+	int32 NumEnemies() const { return Enemies.Num(); }
+
+	ENeonAITier GetTier(const ANeonEnemy* Enemy) const;
+
+	// Path query budget (ai.Neon.MaxPathQueriesPerFrame) shared by every controller. A controller
+	// that finds it spent queues itself and is flushed first thing next frame.
+	bool TryConsumePathQuery();
+	void QueuePathRequest(ANeonEnemyController* Controller);
+	void OnPathRequestReused() { ++PathRequestsReused; }
+
+	// Path queries issued over the last full second
+	int32 GetPathQueriesPerSecond() const { return PathQueriesPerSecond; }
+
+	// Consulted before every visibility trace, whichever path requests it
+	FNeonVisibilityCache& GetVisibilityCache() { return VisibilityCache; }
+
+	// Consulted before every shot, whichever path fires it
+	FNeonAttackTokens& GetAttackTokens() { return AttackTokens; }
+
+	// Cost accounting for the comparison; per-actor ticks report their own time
+	void AddLegacyTickCost(bool bController, double Seconds);
+	void ReportCost() const;
+	void ResetCost();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void ApplyTickMode(bool bBatched);
+	void GatherPositions();
+	void SubmitVisibilityTraces();
+	void UpdateDecisions(double Now);
+	ENeonAITier ComputeTier(int32 Slot) const;
+	void SetTier(int32 Slot, ENeonAITier Tier, double Now);
+	void UpdateFiring(double Now);
+	void RemoveSlot(int32 Slot);
+	void UpdatePathBudget(float DeltaTime);
+	void CountPathQuery();
+
+	// Cold, per enemy
+	UPROPERTY()
+	TArray<TObjectPtr<ANeonEnemy>> Enemies;
+
+	UPROPERTY()
+	TArray<TObjectPtr<ANeonEnemyController>> Controllers;
+
+	// Player each enemy is after; picked by the controller at each decision
+	UPROPERTY()
+	TArray<TObjectPtr<ANeonCharacter>> Targets;
+
+	TArray<FEnemyAITuning> Tunings;
+
+	// Hot, per enemy. Position and distance arrays are padded to a multiple of four for the
+	// vectorized distance pass.
+	TArray<float> PositionX;
+	TArray<float> PositionY;
+	TArray<float> PositionZ;
+	TArray<float> TargetX;
+	TArray<float> TargetY;
+	TArray<float> TargetZ;
+	TArray<float> DistanceSquared;
+	TArray<float> AttackRangeSquared;
+	TArray<float> DetectionRangeSquared;
+	TArray<EEnemyAIState> States;
+	TArray<double> StateEnterTimes;
+	TArray<double> NextFireTimes;
+	TArray<float> FireIntervals;
+	TArray<float> HealthRatios;
+	TArray<ENeonAITier> Tiers;
+	// Fraction of the tier interval each enemy's decisions are offset by
+	TArray<float> Phases;
+	TArray<double> NextDecisionTimes;
+
+	FNeonVisibilityCache VisibilityCache;
+	FNeonAttackTokens AttackTokens;
+
+	// Controllers waiting for path budget, oldest first
+	TArray<TWeakObjectPtr<ANeonEnemyController>> PendingPathRequests;
+	int32 PathQueriesThisFrame = 0;
+	int32 PathQueriesThisSecond = 0;
+	int32 PathQueriesPerSecond = 0;
+	float PathWindowSeconds = 0.0f;
+
+	// Per-actor enemy tick interval, which fire timing is rounded up to
+	static constexpr float FireCheckInterval = 0.1f;
+	static constexpr float TierDecisionIntervals[static_cast<int32>(ENeonAITier::Count)] = { 0.2f, 0.5f, 1.5f };
+
+	// Phases follow the golden-ratio sequence, which stays evenly spread however many enemies come and go
+	uint32 PhaseCounter = 0;
+
+	// First slot offered a trace next frame
+	int32 TraceCursor = 0;
+
+	bool bAppliedBatched = true;
+
+	struct FCostCounter
+	{
+		double Seconds = 0.0;
+		int64 Updates = 0;
+	};
+
+	// Batched pass: one update is one enemy handled by one pass
+	FCostCounter BatchedCost;
+	FCostCounter EnemyTickCost;
+	FCostCounter ControllerTickCost;
+
+	// Game-thread time of whole frames (stat unit's Game) run with each path
+	struct FFrameCost
+	{
+		double Seconds = 0.0;
+		int64 Frames = 0;
+		int64 EnemyFrames = 0;
+	};
+
+	FFrameCost BatchedFrames;
+	FFrameCost LegacyFrames;
+
+	// The frame a mode switch lands in runs both paths, so it is not sampled
+	bool bSkipFrameSample = true;
+
+	// Game time covered by each path, summed over enemies
+	double BatchedEnemySeconds = 0.0;
+	double LegacyEnemySeconds = 0.0;
+
+	int64 VisibilityTraces = 0;
+	int64 TraceFrames = 0;
+	double WorstPassSeconds = 0.0;
+	int64 Decisions = 0;
+
+	int64 PathQueries = 0;
+	int64 PathRequestsReused = 0;
+	int64 PathRequestsDeferred = 0;
+	double ElapsedSeconds = 0.0;
+};
@@ -3,9 +3,19 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 
+struct FFileChangeData;
+
 class FNeonAscendantModule final : public IModuleInterface
 {
 public:
     virtual void StartupModule() override;
     virtual void ShutdownModule() override;
+
+private:
+#if WITH_EDITOR
+    void OnCatalogDirectoryChanged(const TArray<FFileChangeData>& Changes);
+
+    FString CatalogWatchDirectory;
+    FDelegateHandle CatalogWatchHandle;
+#endif
 };
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+// Per-target pools of attack tokens: only enemies holding one of a target's
+// ai.Neon.AttackTokens.PerTarget tokens fire at it, so weapon traces per target are bounded
+// however many enemies are in range. Enemies in range ask for a token at every fire check with a
+// priority (nearer, in sight and longer since their last shot come first); every
+// ai.Neon.AttackTokens.ReassignInterval the tokens go to the best of those that asked since the
+// last reassignment, current holders being favoured a little so tokens do not flap. A free token
+// is granted as soon as someone asks.
+class NEONASCENDANT_API FNeonAttackTokens
+{
+public:
+	// ai.Neon.AttackTokens.PerTarget; 0 when tokens are disabled
+	static int32 GetTokensPerTarget();
+
+	// Lower goes first
+	static float ComputePriority(float Distance, float AttackRange, bool bHasLineOfSight, double SecondsSinceShot);
+
+	// Enters Attacker for Target's next reassignment; returns whether it holds a token now
+	bool Request(const AActor* Attacker, const AActor* Target, float Priority);
+
+	// Always true when tokens are disabled (ai.Neon.AttackTokens.PerTarget 0)
+	bool HasToken(const AActor* Attacker, const AActor* Target) const;
+
+	void Update(double Now);
+
+	// Frees Attacker's tokens at once, e.g. when it dies
+	void Release(const AActor* Attacker);
+
+	void Reset();
+
+	int32 NumHolders() const;
+	int32 NumTargets() const { return Pools.Num(); }
+	int64 GetReassignments() const { return Reassignments; }
+	int64 GetHandovers() const { return Handovers; }
+	void ResetCounters() { Reassignments = Handovers = 0; }
+
+private:
+	struct FPool
+	{
+		TArray<FObjectKey, TInlineAllocator<8>> Holders;
+		TMap<FObjectKey, float> Candidates;
+	};
+
+	TMap<FObjectKey, FPool> Pools;
+	double NextReassignTime = 0.0;
+
+	int64 Reassignments = 0;
+	int64 Handovers = 0;
+};
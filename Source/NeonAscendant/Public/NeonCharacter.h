@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
+#include "MissionModifiers.h"
 #include "NeonCharacter.generated.h"
 
 class UCameraComponent;
@@ -18,6 +19,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
@@ -60,6 +62,19 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Health")
 	float GetHealthPercent() const { return MaxHealth > 0.0f ? CurrentHealth / MaxHealth : 0.0f; }
 
+	// Implant stats: the implant's compiled modifiers replace those of the previous one; -1 unequips
+	UFUNCTION(BlueprintCallable, Category = "Implant")
+	void EquipImplant(int32 ImplantIndex);
+
+	UFUNCTION(BlueprintPure, Category = "Implant")
+	int32 GetEquippedImplant() const { return EquippedImplant; }
+
+	// Buffs, debuffs and statuses; Source replaces any modifiers it added before
+	void SetStatModifiers(FName Source, TConstArrayView<FMissionModifier> Modifiers);
+	void RemoveStatModifiers(FName Source);
+
+	const FMissionStatCache& GetStats() const { return Stats; }
+
 protected:
 	void Die();
 
@@ -98,6 +113,14 @@ private:
 	// Movement configuration
 	float DefaultWalkSpeed = 600.0f;
 
+	// Aggregated stat modifiers; derived values are pushed out only when they change
+	FMissionStatCache Stats;
+	uint32 AppliedStatRevision = MAX_uint32;
+	int32 EquippedImplant = INDEX_NONE;
+
+	void RefreshStatConsumers();
+	void UpdateWalkSpeed();
+
 	// Camera configuration constants
 	static constexpr float FirstPersonCameraHeight = 64.0f;
 	static constexpr float ThirdPersonArmLength = 300.0f;
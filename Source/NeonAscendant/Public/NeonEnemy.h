@@ -17,6 +17,7 @@ public:
 	ANeonEnemy();
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaTime) override;
 
 	// Health system
@@ -40,6 +41,11 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Combat")
 	void FireWeapon();
 
+	// Turns toward TargetLocation and fires
+	void FireAt(const FVector& TargetLocation);
+
+	float GetFireInterval() const { return FireInterval; }
+
 	// Targeting and detection
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
 	float DetectionRange = 2000.0f;
@@ -67,4 +73,10 @@ protected:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
 	float FireInterval = 0.15f; // Time between shots
+
+private:
+	friend class UNeonAISubsystem;
+
+	// Slot in UNeonAISubsystem's arrays
+	int32 BatchedAISlot = INDEX_NONE;
 };
@@ -18,6 +18,26 @@ enum class EEnemyAIState : uint8
 	Dead = 4 UMETA(DisplayName = "Dead")
 };
 
+// Tuning of one enemy's state machine, copied out of the controller so batched updates need not
+// touch it every pass
+struct FEnemyAITuning
+{
+	float DetectionRange = 2000.0f;
+	float LostTargetDistance = 3000.0f;
+	float InvestigationDuration = 5.0f;
+	float AttackRange = 500.0f;
+	float RetreatHealthThreshold = 0.25f;
+};
+
+// What one AI decision sees
+struct FEnemyAIPerception
+{
+	float DistanceToPlayer = 0.0f;
+	bool bCanSeePlayer = false;
+	float HealthRatio = 1.0f;
+	float TimeInState = 0.0f;
+};
+
 UCLASS()
 class NEONASCENDANT_API ANeonEnemyController : public AAIController
 {
@@ -36,6 +56,36 @@ public:
 	// Perception - receive information about damage location
 	void OnEnemyDamaged(FVector DamageLocation);
 
+	// State transitions of the AI; shared by the per-actor tick and UNeonAISubsystem's batched pass
+	static EEnemyAIState DecideState(EEnemyAIState CurrentState, const FEnemyAIPerception& Perception, const FEnemyAITuning& Tuning);
+
+	FEnemyAITuning GetTuning() const;
+
+	// Applies a decision made by the batched pass: records the sighting, switches state and
+	// issues the state's movement
+	void ApplyDecision(EEnemyAIState NewState, bool bCanSeePlayer);
+
+	// Targets the nearest living player within LostTargetDistance (anywhere, if the current
+	// target is gone), via UNeonSpatialGridSubsystem
+	void RefreshTarget();
+
+	ANeonCharacter* GetTarget() const { return PlayerCharacter; }
+
+	// Issues a move that was deferred by the path query budget; false if it is no longer wanted.
+	// Called by UNeonAISubsystem.
+	bool FlushPendingMove();
+
+	// Called by UNeonFlowFieldSubsystem when it stops steering this enemy; chases by pathfinding
+	void OnFlowFieldLost();
+
+	// Perception - line of sight to the player as of the last completed async trace. Traces land
+	// one frame after they were requested, so decisions run on perception up to a frame old.
+	bool HasLineOfSight() const { return bHasLineOfSight; }
+
+	// Starts an async visibility trace to the player; false if one is still in flight or the
+	// visibility cache still holds a valid result (which is applied right away)
+	bool RequestVisibilityTrace();
+
 protected:
 	UPROPERTY(BlueprintReadOnly, Category = "AI")
 	ANeonEnemy* EnemyCharacter = nullptr;
@@ -74,6 +124,10 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI|Retreat")
 	float RetreatHealthThreshold = 0.25f; // Retreat when below 25% health
 
+	// A new path is only requested once the goal location moved more than this
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI|Movement")
+	float RepathTolerance = 150.0f;
+
 	UPROPERTY(BlueprintReadOnly, Category = "AI")
 	FVector LastKnownPlayerLocation = FVector::ZeroVector;
 
@@ -81,18 +135,56 @@ protected:
 	double StateChangeTime = 0.0;
 
 	void UpdateAIBehavior();
+	void UpdateStateBehavior();
 	void UpdatePatrolBehavior();
 	void UpdateInvestigateBehavior();
 	void UpdateEngagedBehavior();
+	void UpdatePositioningBehavior();
 	void UpdateRetreatBehavior();
 
+	// Movement goes through here rather than MoveTo*: the current path is kept while it still
+	// leads to the goal (the same goal actor, or a goal location within RepathTolerance), and new
+	// queries spend the shared per-frame budget of UNeonAISubsystem, waiting in its queue when it
+	// is spent. Paths may be partial, so an invalidated or unreachable goal still gets a path.
+	void RequestMove(AActor* GoalActor, const FVector& GoalLocation, float AcceptanceRadius);
+	bool IsFollowingPathTo(const AActor* GoalActor, const FVector& GoalLocation) const;
+	void IssueMove();
+
 	void ChangeAIState(EEnemyAIState NewState);
-	bool CanSeeTarget() const;
 	bool IsTargetInRange() const;
 
 	// Perception - line trace to check if we can see the player
 	FVector GetLineTraceStart() const;
 	FVector GetLineTraceEnd() const;
+	void OnVisibilityTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+	FTraceDelegate VisibilityTraceDelegate;
+	bool bVisibilityTraceInFlight = false;
+	bool bHasLineOfSight = false;
+
+	// Target, trace points, time and cache epochs of the trace in flight, all as of submission
+	TWeakObjectPtr<AActor> PendingTraceTarget;
+	FVector PendingTraceStart = FVector::ZeroVector;
+	FVector PendingTraceEnd = FVector::ZeroVector;
+	double PendingTraceTime = 0.0;
+	uint32 PendingObserverEpoch = 0;
+	uint32 PendingTargetEpoch = 0;
+
+	// Goal of the path being followed, and of the move waiting for budget
+	TWeakObjectPtr<AActor> ActiveGoalActor;
+	FVector ActiveGoalLocation = FVector::ZeroVector;
+	TWeakObjectPtr<AActor> PendingGoalActor;
+	FVector PendingGoalLocation = FVector::ZeroVector;
+	float PendingAcceptanceRadius = 0.0f;
+	bool bMovePending = false;
+
+	// Kept until reached, so retreating does not re-path every decision
+	FVector RetreatTarget = FVector::ZeroVector;
+	bool bHasRetreatTarget = false;
+
+	// Spot held while waiting for an attack token; kept until reached or out of range
+	FVector PositionTarget = FVector::ZeroVector;
+	bool bHasPositionTarget = false;
 
 	// Patrol point generation
 	FVector GetRandomPatrolPoint();
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "NeonFlowFieldSubsystem.generated.h"
+
+class ANeonEnemyController;
+
+// One flow field per chased target: the grid distance along the navmesh from every cell within
+// ai.Neon.FlowField.Radius of the target to the target's cell, with each cell pointing at its
+// downhill neighbour. Enemies following a field are steered from it every frame by a cell lookup,
+// so a crowd chasing one player costs one field build rather than a path query per enemy.
+// A field is rebuilt around the target's new cell when the target crosses a cell. Builds are
+// spread over frames within ai.Neon.FlowField.CellsPerFrame, followers reading the last finished
+// field meanwhile, and navmesh heights are projected once per cell and kept for later builds.
+// Each cell holds one walkable height, so stacked floors are not told apart, and the navmesh is
+// assumed static.
+UCLASS()
+class NEONASCENDANT_API UNeonFlowFieldSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual void Deinitialize() override;
+
+	// Steers Controller's pawn toward Target from the target's field until it is within
+	// AcceptanceRadius. False, leaving the pawn to pathfinding, if the field is disabled, not yet
+	// built or does not reach the pawn; a field is started for Target either way.
+	bool Follow(ANeonEnemyController* Controller, AActor* Target, float AcceptanceRadius);
+	void Unfollow(ANeonEnemyController* Controller);
+
+	int32 NumFields() const { return Fields.Num(); }
+	int32 NumFollowers() const { return Followers.Num(); }
+	int64 GetBuilds() const { return Builds; }
+	int64 GetCellsExpanded() const { return CellsExpanded; }
+	void ResetCounters() { Builds = CellsExpanded = 0; }
+
+	static constexpr float CellSize = 100.0f;
+
+	// Largest height change between neighbouring cells that counts as walkable
+	static constexpr float MaxStepHeight = 60.0f;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FGrid
+	{
+		// World cell of index 0, and the cell everything flows toward
+		FIntPoint Origin = FIntPoint::ZeroValue;
+		FIntPoint Goal = FIntPoint::ZeroValue;
+		int32 Width = 0;
+
+		TArray<float> Distances;
+		TArray<int32> NextCells;
+		TArray<float> Heights;
+
+		int32 ToIndex(const FIntPoint& Cell) const;
+		FVector GetCellCenter(int32 Index) const;
+	};
+
+	struct FField
+	{
+		TWeakObjectPtr<AActor> Target;
+
+		// Read by followers; replaced when a build finishes
+		FGrid Ready;
+		bool bReady = false;
+
+		FGrid Building;
+		TArray<TPair<float, int32>> Open;
+		bool bBuilding = false;
+
+		double LastFollowedTime = 0.0;
+	};
+
+	struct FFollower
+	{
+		TWeakObjectPtr<ANeonEnemyController> Controller;
+		FObjectKey Target;
+		float AcceptanceRadius = 0.0f;
+	};
+
+	static FIntPoint ToCell(const FVector& Location);
+
+	bool StartBuild(FField& Field);
+
+	// Expands up to Budget cells of Field's build; returns the number expanded
+	int32 ContinueBuild(FField& Field, int32 Budget);
+
+	// Navmesh height of a world cell, projected on first use; a failed projection is not cached
+	float GetCellHeight(const FIntPoint& Cell, float ReferenceZ);
+
+	// False if Location is outside Grid or cannot reach its goal
+	static bool GetStep(const FGrid& Grid, const FVector& Location, FVector& OutStepTarget);
+
+	void SteerFollowers();
+
+	TMap<FObjectKey, FField> Fields;
+	TArray<FFollower> Followers;
+
+	// Projected navmesh heights of every walkable cell any field has visited
+	TMap<FIntPoint, float> CellHeights;
+
+	int64 Builds = 0;
+	int64 CellsExpanded = 0;
+};
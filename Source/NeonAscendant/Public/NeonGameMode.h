@@ -2,12 +2,16 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
+#include "GameplayTagContainer.h"
+#include "MissionDifficulty.h"
+#include "MissionData.h"
+#include "MissionLayout.h"
+#include "MissionTypes.h"
 #include "NeonGameMode.generated.h"
 
 class UMissionGenerator;
 class ANeonEnemy;
 class ADistrictHazard;
-struct FMissionBrief;
 
 UCLASS()
 class NEONASCENDANT_API ANeonGameMode : public AGameModeBase
@@ -19,6 +23,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
 	// Generate a new mission
@@ -36,10 +41,41 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Mission")
 	UMissionGenerator* GetMissionGenerator() const { return MissionGenerator; }
 
+	// Tile layout of the current mission (see MissionLayout); empty before the first mission and
+	// while bPlaceOnMissionLayout is off
+	const FMissionLayout& GetActiveLayout() const { return ActiveLayout; }
+
+	// World location of a layout slot's tile centre
+	FVector GetLayoutSlotLocation(const FMissionLayoutSlot& Slot, float Height) const;
+
 protected:
 	UPROPERTY(BlueprintReadOnly, Category = "Mission")
 	TObjectPtr<UMissionGenerator> MissionGenerator;
 
+	// Shared by the Blueprint entry points and the handle-based StartNewMission path; the names are
+	// only logged
+	void SpawnEnemiesForOpposition(FName Opposition, int32 EnemyCount);
+	void SpawnHazardsForDistrict(FName District);
+
+	// Player pawn location, or the level's player start before the pawn exists
+	FVector GetPlayerSpawnOrigin() const;
+
+	// Points the tags and the player's implant at ActiveMissionHandle, or clears them when unset
+	void ApplyActiveMissionHandle();
+
+	// Re-resolves ActiveMissionNames against the reloaded catalog, dropping the handle if it is gone
+	void HandleCatalogReloaded();
+
+	// Estimates Mission's difficulty on a task; the result reaches ActiveMissionDifficulty and the
+	// HUD on the game thread unless another mission started meanwhile
+	void StartDifficultyEstimate(const FMissionBriefHandle& Mission);
+	void ApplyMissionDifficulty(const FMissionDifficulty& Difficulty);
+
+	// Bumped per estimate, so a late result for an earlier mission is dropped
+	uint32 DifficultyEstimateSerial = 0;
+
+	FDelegateHandle CatalogReloadedHandle;
+
 	// Blueprint-assignable enemy class for spawning
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Mission")
 	TSubclassOf<class ANeonEnemy> EnemyClass;
@@ -56,17 +92,53 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category = "Mission")
 	TArray<TObjectPtr<ADistrictHazard>> ActiveHazards;
 
+	// Catalog indices of the current mission; unset before the first mission and after a catalog
+	// reload that removed one of its entries. The HUD holds the only expanded copy.
+	TOptional<FMissionBriefHandle> ActiveMissionHandle;
+
+	// Entry names of the current mission, so it can be found again in a reloaded catalog
+	FMissionBriefNames ActiveMissionNames;
+
+	// Mission.* tags of the current mission's district, opposition and complication
+	UPROPERTY(BlueprintReadOnly, Category = "Mission")
+	FGameplayTagContainer ActiveMissionTags;
+
+	// Estimated difficulty of the current mission (see MissionDifficulty); Trials is 0 until the
+	// estimate finishes, a few frames after the mission starts
+	UPROPERTY(BlueprintReadOnly, Category = "Mission")
+	FMissionDifficulty ActiveMissionDifficulty;
+
+	// Generate a MissionLayout per mission and spawn enemies and hazards on its slots. Only for
+	// levels built from the layout: the layout spans far beyond the default spawn radius, and
+	// slots in a level without matching geometry land off the navmesh
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Mission")
+	bool bPlaceOnMissionLayout = false;
+
+	// Enemies and hazards spawn on its slots while it is valid
+	FMissionLayout ActiveLayout;
+
+	// World position of tile (0, 0), chosen so the layout's player start lands on the player
+	FVector LayoutOrigin = FVector::ZeroVector;
+
+public:
+	// Spawn rules, shared with the difficulty estimator so its model matches what is spawned
+	static constexpr int32 DefaultEnemyCount = 3;
+	static constexpr int32 MinHazardCount = 2;
+	static constexpr int32 MaxHazardCount = 3;
+	static constexpr float MinHazardDamagePerSecond = 5.0f;
+	static constexpr float MaxHazardDamagePerSecond = 15.0f;
+
 private:
 	// Enemy spawn configuration
 	static constexpr float EnemySpawnMinDistance = -2000.0f;
 	static constexpr float EnemySpawnMaxDistance = 2000.0f;
 	static constexpr float EnemySpawnHeightOffset = 100.0f;
-	static constexpr int32 DefaultEnemyCount = 3;
+
+	// World size of one layout tile
+	static constexpr float LayoutTileSize = 200.0f;
 
 	// Hazard spawn configuration
 	static constexpr float HazardSpawnMinDistance = -3000.0f;
 	static constexpr float HazardSpawnMaxDistance = 3000.0f;
 	static constexpr float HazardSpawnHeight = 100.0f;
-	static constexpr int32 MinHazardCount = 2;
-	static constexpr int32 MaxHazardCount = 3;
 };
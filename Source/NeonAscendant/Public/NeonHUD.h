@@ -4,6 +4,8 @@
 #include "GameFramework/HUD.h"
 #include "Engine/Canvas.h"
 #include "MissionTypes.h"
+#include "MissionBriefHandle.h"
+#include "MissionDifficulty.h"
 #include "NeonHUD.generated.h"
 
 class ANeonCharacter;
@@ -24,14 +26,29 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "HUD")
 	void SetMissionBrief(const FMissionBrief& NewMission);
 
+	// Set mission brief by catalog handle (the game mode's path); expands it once, into CurrentMission
+	void SetMissionBriefHandle(const FMissionBriefHandle& NewMission);
+
+	// Estimated difficulty shown under the briefing; cleared whenever the mission changes
+	UFUNCTION(BlueprintCallable, Category = "HUD")
+	void SetMissionDifficulty(const FMissionDifficulty& NewDifficulty);
+
+	UFUNCTION(BlueprintPure, Category = "HUD")
+	FMissionBrief GetCurrentMission() const { return CurrentMission; }
+
 	// Update player reference
 	UFUNCTION(BlueprintCallable, Category = "HUD")
 	void SetPlayerCharacter(ANeonCharacter* NewPlayer);
 
 protected:
+	// Displayed mission. Owns its strings, so it stays drawable across catalog reloads and for
+	// briefs authored outside the catalog.
 	UPROPERTY(BlueprintReadOnly, Category = "HUD")
 	FMissionBrief CurrentMission;
 
+	UPROPERTY(BlueprintReadOnly, Category = "HUD")
+	FMissionDifficulty MissionDifficulty;
+
 	UPROPERTY(BlueprintReadOnly, Category = "HUD")
 	ANeonCharacter* PlayerCharacter = nullptr;
 
@@ -66,6 +83,9 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HUD|Layout")
 	FVector2D AmmoCounterPosition = FVector2D(20.0f, 100.0f);
 
+	// Resets the per-mission state after CurrentMission was replaced
+	void OnMissionBriefChanged();
+
 	// Draw functions
 	void DrawHealthBar();
 	void DrawMissionBriefing();
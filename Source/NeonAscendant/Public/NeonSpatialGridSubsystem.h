@@ -0,0 +1,93 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "NeonSpatialGridSubsystem.generated.h"
+
+enum class ENeonSpatialCategory : uint8
+{
+	None = 0,
+	Player = 1 << 0,
+	Enemy = 1 << 1,
+	Hazard = 1 << 2,
+	Characters = Player | Enemy
+};
+ENUM_CLASS_FLAGS(ENeonSpatialCategory)
+
+// Uniform spatial hash over the XY plane of every registered player, enemy and hazard. Moving
+// actors are re-bucketed once per frame, and only when they cross a cell boundary; queries visit
+// just the cells their shape overlaps, so their cost follows local density rather than how many
+// actors the world holds. Distances in queries are full 3D.
+UCLASS()
+class NEONASCENDANT_API UNeonSpatialGridSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual void Deinitialize() override;
+
+	// Static actors are never re-bucketed by the tick
+	void Register(AActor* Actor, ENeonSpatialCategory Category, bool bStatic = false);
+	void Unregister(AActor* Actor);
+
+	// Re-buckets one actor now rather than at the next tick, e.g. after a teleport
+	void UpdateActor(AActor* Actor);
+
+	// Every actor of Categories within Radius of Center. Appends to OutActors.
+	void QueryRadius(const FVector& Center, float Radius, ENeonSpatialCategory Categories, TArray<AActor*>& OutActors) const;
+
+	// Up to Count actors of Categories within MaxRadius, nearest first. Replaces OutActors.
+	void FindNearest(const FVector& Center, int32 Count, float MaxRadius, ENeonSpatialCategory Categories, TArray<AActor*>& OutActors) const;
+	AActor* FindNearest(const FVector& Center, float MaxRadius, ENeonSpatialCategory Categories, const AActor* Ignore = nullptr) const;
+
+	// Actors of Categories within Range of Origin and HalfAngleDegrees of Direction. Appends to OutActors.
+	void QueryCone(const FVector& Origin, const FVector& Direction, float HalfAngleDegrees, float Range, ENeonSpatialCategory Categories, TArray<AActor*>& OutActors) const;
+
+	int32 Num() const { return Actors.Num(); }
+
+	static constexpr float CellSize = 1000.0f;
+
+	// Search radius meaning "anywhere"; still small enough for cell math
+	static constexpr float AnyDistance = 1.0e7f;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FEntry
+	{
+		FVector Location = FVector::ZeroVector;
+		FIntPoint Cell = FIntPoint::ZeroValue;
+		int32 IndexInCell = INDEX_NONE;
+		ENeonSpatialCategory Category = ENeonSpatialCategory::None;
+		bool bStatic = false;
+	};
+
+	static FIntPoint ToCell(const FVector& Location);
+
+	void AddToCell(int32 EntryIndex);
+	void RemoveFromCell(int32 EntryIndex);
+	void MoveEntry(int32 EntryIndex, const FVector& NewLocation);
+
+	// Calls Visitor(EntryIndex, DistanceSquared) for entries of Categories in the cells overlapping the circle
+	template <typename VisitorType>
+	void ForEachInRadius(const FVector& Center, float Radius, ENeonSpatialCategory Categories, VisitorType&& Visitor) const;
+
+	int32 NumInCategories(ENeonSpatialCategory Categories) const;
+
+	// True when ForEachInRadius would scan every entry instead of visiting cells
+	bool ScansAllEntries(const FVector& Center, float Radius) const;
+
+	// Parallel arrays; entries are swap-removed
+	UPROPERTY()
+	TArray<TObjectPtr<AActor>> Actors;
+	TArray<FEntry> Entries;
+
+	TMap<FObjectKey, int32> EntryIndices;
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	// Registered actors per category bit, so queries for an empty category return at once
+	int32 CategoryCounts[3] = {};
+};
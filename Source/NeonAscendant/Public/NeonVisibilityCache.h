@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+// Last line-of-sight result per (observer, target) pair, with the trace points it was computed
+// from. A cached result stands until either end moves more than ai.Neon.VisibilityCache.MoveThreshold,
+// it is older than ai.Neon.VisibilityCache.MaxAge, or an event (damage, gunfire) invalidates an
+// actor involved. Invalidation bumps a per-actor epoch, so it is O(1) however many pairs the actor
+// is part of.
+class NEONASCENDANT_API FNeonVisibilityCache
+{
+public:
+	// True and bOutVisible set if a cached result is still valid for these trace points
+	bool Find(const AActor* Observer, const AActor* Target, const FVector& ObserverPoint, const FVector& TargetPoint, double Now, bool& bOutVisible);
+
+	// Time and epochs are those read when the trace was submitted. A result whose epochs are no
+	// longer current (an Invalidate or Forget while the trace was in flight) is dropped.
+	void Store(const AActor* Observer, const AActor* Target, const FVector& ObserverPoint, const FVector& TargetPoint, double Time,
+		uint32 ObserverEpoch, uint32 TargetEpoch, bool bVisible);
+
+	// Every cached result involving Actor is re-traced on next use
+	void Invalidate(const AActor* Actor);
+
+	uint32 GetEpoch(const AActor* Actor) const { return Epochs.FindRef(FObjectKey(Actor)); }
+
+	// Drops every result Actor is part of, as observer or target, e.g. when it leaves play. Bumps
+	// Actor's epoch too, so a trace still in flight cannot store a new result for it.
+	void Forget(const AActor* Actor);
+
+	void Reset();
+
+	int64 GetHits() const { return Hits; }
+	int64 GetMisses() const { return Misses; }
+	void ResetCounters() { Hits = Misses = 0; }
+
+private:
+	struct FEntry
+	{
+		FVector ObserverPoint = FVector::ZeroVector;
+		FVector TargetPoint = FVector::ZeroVector;
+		double Time = 0.0;
+		uint32 ObserverEpoch = 0;
+		uint32 TargetEpoch = 0;
+		bool bVisible = false;
+	};
+
+	TMap<TTuple<FObjectKey, FObjectKey>, FEntry> Entries;
+	TMap<FObjectKey, uint32> Epochs;
+
+	int64 Hits = 0;
+	int64 Misses = 0;
+};
@@ -39,8 +39,14 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Weapon")
 	bool IsReloading() const { return bIsReloading; }
 
+	// Per hit, before the owner's multiplier
+	float GetDamage() const { return Damage; }
+
 	void Fire();
 
+	// Scales Damage; set by the owner from its stat modifiers
+	void SetDamageMultiplier(float Multiplier) { DamageMultiplier = Multiplier; }
+
 protected:
 	void FinishReload();
 
@@ -81,6 +87,8 @@ protected:
 	bool bIsReloading = false;
 
 private:
+	float DamageMultiplier = 1.0f;
+
 	FTimerHandle FireTimerHandle;
 	FTimerHandle ReloadTimerHandle;
 };
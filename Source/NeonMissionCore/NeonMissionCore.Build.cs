@@ -0,0 +1,21 @@
+using UnrealBuildTool;
+
+// Mission catalog, sampling, mission space and brief codes. Depends on Core and Json only, so it
+// links into the game, the editor and the NeonMissionTool program alike.
+public class NeonMissionCore : ModuleRules
+{
+    public NeonMissionCore(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PublicDependencyModuleNames.AddRange(new string[]
+        {
+            "Core"
+        });
+
+        PrivateDependencyModuleNames.AddRange(new string[]
+        {
+            "Json"
+        });
+    }
+}
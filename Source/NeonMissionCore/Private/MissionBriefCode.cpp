@@ -0,0 +1,167 @@
+#include "MissionBriefCode.h"
+
+#include "MissionCatalog.h"
+#include "MissionSpace.h"
+#include "Serialization/Archive.h"
+
+namespace
+{
+    constexpr uint64 RankMask = (uint64(1) << MissionBriefCode::RankBits) - 1;
+    constexpr uint64 CatalogTagMask = (uint64(1) << MissionBriefCode::CatalogTagBits) - 1;
+    constexpr uint32 CatalogTagShift = MissionBriefCode::RankBits;
+    constexpr uint32 VersionShift = MissionBriefCode::RankBits + MissionBriefCode::CatalogTagBits;
+
+    static_assert(MissionBriefCode::RankBits + MissionBriefCode::CatalogTagBits + MissionBriefCode::VersionBits == 64, "Mission brief code fields must fill 64 bits");
+
+    constexpr int32 ShareStringLength = 13; // ceil(64 / 5)
+    const TCHAR ShareAlphabet[] = TEXT("0123456789ABCDEFGHJKMNPQRSTVWXYZ");
+
+    int32 DecodeShareDigit(TCHAR Character)
+    {
+        const TCHAR Upper = FChar::ToUpper(Character);
+
+        // Crockford aliases for characters that are easy to misread
+        if (Upper == TEXT('O'))
+        {
+            return 0;
+        }
+        if (Upper == TEXT('I') || Upper == TEXT('L'))
+        {
+            return 1;
+        }
+
+        for (int32 Digit = 0; Digit < 32; ++Digit)
+        {
+            if (ShareAlphabet[Digit] == Upper)
+            {
+                return Digit;
+            }
+        }
+
+        return INDEX_NONE;
+    }
+}
+
+namespace MissionBriefCode
+{
+    uint32 GetCatalogTag()
+    {
+        const uint32 Hash = FMissionCatalog::Get().GetContentHash();
+        return static_cast<uint32>((Hash ^ (Hash >> CatalogTagBits)) & CatalogTagMask);
+    }
+
+    bool Encode(const FMissionBriefHandle& Handle, uint64& OutCode)
+    {
+        // Cooking rejects such catalogs, but a catalog cooked by an older tool may still be loaded
+        if (static_cast<uint64>(MissionSpace::GetTotalCombinations()) > RankMask + 1)
+        {
+            UE_LOG(LogTemp, Error, TEXT("MissionBriefCode - Mission space (%lld briefs) does not fit the %u-bit rank field"),
+                MissionSpace::GetTotalCombinations(), RankBits);
+            return false;
+        }
+
+        const int64 Rank = MissionSpace::RankBrief(Handle);
+        if (Rank == INDEX_NONE)
+        {
+            return false;
+        }
+
+        OutCode = (static_cast<uint64>(FormatVersion) << VersionShift)
+            | (static_cast<uint64>(GetCatalogTag()) << CatalogTagShift)
+            | static_cast<uint64>(Rank);
+
+        return true;
+    }
+
+    EMissionBriefCodeResult Decode(uint64 Code, FMissionBriefHandle& OutHandle)
+    {
+        if ((Code >> VersionShift) != FormatVersion)
+        {
+            return EMissionBriefCodeResult::UnknownVersion;
+        }
+
+        if (((Code >> CatalogTagShift) & CatalogTagMask) != GetCatalogTag())
+        {
+            return EMissionBriefCodeResult::StaleCatalog;
+        }
+
+        const int64 Rank = static_cast<int64>(Code & RankMask);
+        if (Rank >= MissionSpace::GetTotalCombinations())
+        {
+            return EMissionBriefCodeResult::InvalidRank;
+        }
+
+        OutHandle = MissionSpace::UnrankBrief(Rank);
+        return EMissionBriefCodeResult::Ok;
+    }
+
+    FString ToShareString(uint64 Code)
+    {
+        FString Result;
+        Result.Reserve(ShareStringLength);
+
+        for (int32 Digit = ShareStringLength - 1; Digit >= 0; --Digit)
+        {
+            Result.AppendChar(ShareAlphabet[(Code >> (Digit * 5)) & 31]);
+        }
+
+        return Result;
+    }
+
+    bool ParseShareString(const FString& ShareString, uint64& OutCode)
+    {
+        uint64 Code = 0;
+        int32 NumDigits = 0;
+
+        for (const TCHAR Character : ShareString)
+        {
+            if (Character == TEXT('-'))
+            {
+                continue;
+            }
+
+            const int32 Digit = DecodeShareDigit(Character);
+            if (Digit == INDEX_NONE || NumDigits == ShareStringLength)
+            {
+                return false;
+            }
+
+            // The leading digit only carries the top four bits
+            if (NumDigits == 0 && Digit > 15)
+            {
+                return false;
+            }
+
+            Code = (Code << 5) | static_cast<uint64>(Digit);
+            ++NumDigits;
+        }
+
+        if (NumDigits != ShareStringLength)
+        {
+            return false;
+        }
+
+        OutCode = Code;
+        return true;
+    }
+
+    bool Serialize(FArchive& Ar, FMissionBriefHandle& Handle)
+    {
+        uint64 Code = 0;
+        if (Ar.IsSaving() && !Encode(Handle, Code))
+        {
+            // Written as a code that never decodes, so loading reports it instead of guessing
+            Code = 0;
+        }
+
+        Ar << Code;
+
+        if (Ar.IsLoading())
+        {
+            Handle = FMissionBriefHandle();
+            return Decode(Code, Handle) == EMissionBriefCodeResult::Ok;
+        }
+
+        return Code != 0;
+    }
+}
@@ -0,0 +1,141 @@
+#include "MissionBriefGenerator.h"
+
+#include "MissionCatalog.h"
+#include "MissionRandom.h"
+#include "MissionSampler.h"
+#include "MissionSpace.h"
+#include "Async/ParallelFor.h"
+#include "Misc/DateTime.h"
+
+using namespace MissionCatalogFormat;
+
+namespace
+{
+    // Smallest slice handed to a worker by the counter-based batch path.
+    constexpr int32 MinBriefsPerParallelBatch = 256;
+
+    template <typename RandomType>
+    FMissionBriefHandle DrawMissionBriefHandle(RandomType& Random)
+    {
+        // Empty or unloaded catalog (see FMissionCatalog::GetLoadError): nothing to draw from
+        if (MissionSpace::GetTotalCombinations() <= 0)
+        {
+            return FMissionBriefHandle();
+        }
+
+        const FMissionCatalog& Catalog = FMissionCatalog::Get();
+        const FMissionSampler& Sampler = FMissionSampler::Get();
+
+        // District, faction and complication are weighted and constrained by the catalog; the
+        // remaining draws are uniform.
+        FMissionBriefHandle Handle;
+        Handle.DistrictIndex = Sampler.SampleDistrict(Random);
+        Handle.FactionIndex = Sampler.SampleFaction(Handle.DistrictIndex, Random);
+        Handle.ArchetypeIndex = static_cast<uint16>(Random.RandRange(0, Catalog.Num(ESection::Archetypes) - 1));
+        Handle.WeaponIndex = static_cast<uint16>(Random.RandRange(0, Catalog.Num(ESection::Weapons) - 1));
+        Handle.ImplantIndex = static_cast<uint16>(Random.RandRange(0, Catalog.Num(ESection::Implants) - 1));
+        Handle.AbilityIndex = static_cast<uint16>(Random.RandRange(0, Catalog.GetArchetype(Handle.ArchetypeIndex).Abilities.Count - 1));
+        Handle.ComplicationIndex = Sampler.SampleComplication(Handle.DistrictIndex, Handle.FactionIndex, Random);
+        Handle.ExtractionIndex = static_cast<uint16>(Random.RandRange(0, Catalog.Num(ESection::ExtractionConditions) - 1));
+
+        return Handle;
+    }
+}
+
+void FMissionBriefGenerator::Seed(int32 InSeed)
+{
+    RandomStream.Initialize(InSeed);
+    CurrentSeed = InSeed;
+    NextBriefIndex = 0;
+    NextRotationIndex = 0;
+    bHasSeed = true;
+}
+
+void FMissionBriefGenerator::EnsureSeeded()
+{
+    if (!bHasSeed)
+    {
+        Seed(static_cast<int32>(FDateTime::UtcNow().GetTicks() & 0xFFFFFFFF));
+    }
+}
+
+FMissionBriefHandle FMissionBriefGenerator::Next()
+{
+    EnsureSeeded();
+
+    if (Mode == EMissionSequenceMode::CounterBased)
+    {
+        return GenerateAt(CurrentSeed, NextBriefIndex++);
+    }
+
+    return DrawMissionBriefHandle(RandomStream);
+}
+
+void FMissionBriefGenerator::NextBatch(int32 Count, TArray<FMissionBriefHandle>& OutHandles)
+{
+    if (Count <= 0)
+    {
+        return;
+    }
+
+    if (Mode == EMissionSequenceMode::CounterBased)
+    {
+        const int32 Seed = CurrentSeed;
+        const int64 FirstIndex = ReserveIndices(Count);
+        const int32 FirstSlot = OutHandles.Num();
+
+        OutHandles.AddUninitialized(Count);
+        FMissionBriefHandle* Slots = OutHandles.GetData() + FirstSlot;
+        ParallelFor(TEXT("FMissionBriefGenerator::NextBatch"), Count, MinBriefsPerParallelBatch, [Slots, Seed, FirstIndex](int32 Index)
+        {
+            Slots[Index] = GenerateAt(Seed, FirstIndex + Index);
+        });
+        return;
+    }
+
+    OutHandles.Reserve(OutHandles.Num() + Count);
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        OutHandles.Add(Next());
+    }
+}
+
+int64 FMissionBriefGenerator::ReserveIndices(int32 Count)
+{
+    EnsureSeeded();
+
+    const int64 FirstIndex = NextBriefIndex;
+    NextBriefIndex += FMath::Max(Count, 0);
+    return FirstIndex;
+}
+
+FMissionBriefHandle FMissionBriefGenerator::Rotation(int64 RotationIndex)
+{
+    EnsureSeeded();
+
+    return MissionSpace::GetRotationBrief(CurrentSeed, RotationIndex);
+}
+
+void FMissionBriefGenerator::NextUnique(int32 Count, TArray<FMissionBriefHandle>& OutHandles)
+{
+    EnsureSeeded();
+
+    const int32 ClampedCount = static_cast<int32>(FMath::Clamp<int64>(Count, 0, MissionSpace::GetTotalCombinations()));
+    OutHandles.Reserve(OutHandles.Num() + ClampedCount);
+
+    for (int32 Index = 0; Index < ClampedCount; ++Index)
+    {
+        OutHandles.Add(MissionSpace::GetRotationBrief(CurrentSeed, NextRotationIndex++));
+    }
+}
+
+FMissionBriefHandle FMissionBriefGenerator::GenerateAt(int32 Seed, int64 BriefIndex)
+{
+    FMissionCounterRandom Random(Seed, static_cast<uint64>(BriefIndex));
+    return DrawMissionBriefHandle(Random);
+}
+
+int64 FMissionBriefGenerator::GetTotalCombinations()
+{
+    return MissionSpace::GetTotalCombinations();
+}
@@ -0,0 +1,19 @@
+#include "MissionBriefHandle.h"
+
+#include "MissionCatalog.h"
+
+using namespace MissionCatalogFormat;
+
+bool FMissionBriefHandle::IsValid() const
+{
+    const FMissionCatalog& Catalog = FMissionCatalog::Get();
+
+    return DistrictIndex < Catalog.Num(ESection::Districts)
+        && FactionIndex < Catalog.Num(ESection::Factions)
+        && ArchetypeIndex < Catalog.Num(ESection::Archetypes)
+        && AbilityIndex < Catalog.GetList(Catalog.GetArchetype(ArchetypeIndex).Abilities).Num()
+        && WeaponIndex < Catalog.Num(ESection::Weapons)
+        && ImplantIndex < Catalog.Num(ESection::Implants)
+        && ComplicationIndex < Catalog.Num(ESection::Complications)
+        && ExtractionIndex < Catalog.Num(ESection::ExtractionConditions);
+}
@@ -0,0 +1,30 @@
+#include "MissionBriefStream.h"
+
+#include "MissionBriefGenerator.h"
+
+FMissionBriefStream::FMissionBriefStream(int32 InSeed, uint32 InStreamId)
+    : Seed(InSeed)
+    , StreamId(InStreamId)
+{
+    checkf(StreamId <= MaxStreamId, TEXT("Mission brief stream id %u exceeds %u"), StreamId, MaxStreamId);
+}
+
+FMissionBriefHandle FMissionBriefStream::Next()
+{
+    return At(NextLocalIndex++);
+}
+
+void FMissionBriefStream::NextBatch(int32 Count, TArray<FMissionBriefHandle>& OutHandles)
+{
+    OutHandles.Reserve(OutHandles.Num() + FMath::Max(Count, 0));
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        OutHandles.Add(Next());
+    }
+}
+
+FMissionBriefHandle FMissionBriefStream::At(int64 LocalIndex) const
+{
+    checkf(LocalIndex >= 0 && LocalIndex < (int64(1) << LocalIndexBits), TEXT("Mission brief stream position %lld out of range"), LocalIndex);
+    return FMissionBriefGenerator::GenerateAt(Seed, (static_cast<int64>(StreamId) << LocalIndexBits) | LocalIndex);
+}
@@ -0,0 +1,578 @@
+#include "MissionCatalog.h"
+
+#include "MissionBriefCode.h"
+#include "Async/MappedFileHandle.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+using namespace MissionCatalogFormat;
+
+namespace
+{
+    constexpr uint32 SectionAlignment = 4;
+
+    // Size of one element of each section, used to bounds-check the mapped file
+    uint32 GetElementSize(ESection Section)
+    {
+        switch (Section)
+        {
+            case ESection::Strings: return 1;
+            case ESection::Lists: return sizeof(uint32);
+            case ESection::Abilities: return sizeof(FAbilityRecord);
+            case ESection::Archetypes: return sizeof(FArchetypeRecord);
+            case ESection::Weapons: return sizeof(FWeaponRecord);
+            case ESection::Implants: return sizeof(FImplantRecord);
+            case ESection::Districts: return sizeof(FDistrictRecord);
+            case ESection::Factions: return sizeof(FFactionRecord);
+            case ESection::Complications: return sizeof(FComplicationRecord);
+            case ESection::ExtractionConditions: return sizeof(uint32);
+            default: return 0;
+        }
+    }
+
+    // Accumulates the string pool and list section while records are cooked
+    class FCatalogWriter
+    {
+    public:
+        FCatalogWriter()
+        {
+            // Offset 0 is the empty string
+            Strings.Add(0);
+            StringOffsets.Add(FString(), 0);
+        }
+
+        uint32 AddString(const FString& Value)
+        {
+            if (const uint32* Existing = StringOffsets.Find(Value))
+            {
+                return *Existing;
+            }
+
+            const uint32 Offset = static_cast<uint32>(Strings.Num());
+            FTCHARToUTF8 Utf8(*Value);
+            Strings.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+            Strings.Add(0);
+
+            StringOffsets.Add(Value, Offset);
+            return Offset;
+        }
+
+        FRange AddStringList(const TArray<FString>& Values)
+        {
+            FRange Range;
+            Range.First = static_cast<uint32>(Lists.Num());
+            Range.Count = static_cast<uint32>(Values.Num());
+            for (const FString& Value : Values)
+            {
+                Lists.Add(AddString(Value));
+            }
+            return Range;
+        }
+
+        FRange AddIndexList(const TArray<uint32>& Values)
+        {
+            FRange Range;
+            Range.First = static_cast<uint32>(Lists.Num());
+            Range.Count = static_cast<uint32>(Values.Num());
+            Lists.Append(Values);
+            return Range;
+        }
+
+        TArray<uint8> Strings;
+        TArray<uint32> Lists;
+
+    private:
+        TMap<FString, uint32> StringOffsets;
+    };
+
+    template <typename ElementType>
+    void AppendSection(TArray<uint8>& Out, FHeader& Header, ESection Section, const TArray<ElementType>& Elements)
+    {
+        Out.AddZeroed(Align(Out.Num(), SectionAlignment) - Out.Num());
+
+        FSection& Info = Header.Sections[static_cast<uint32>(Section)];
+        Info.Offset = static_cast<uint32>(Out.Num());
+        Info.Count = static_cast<uint32>(Elements.Num());
+        Out.Append(reinterpret_cast<const uint8*>(Elements.GetData()), Elements.Num() * sizeof(ElementType));
+    }
+
+    FString GetString(const TSharedPtr<FJsonObject>& Object, const TCHAR* Field)
+    {
+        FString Value;
+        Object->TryGetStringField(Field, Value);
+        return Value;
+    }
+
+    TArray<FString> GetStringArray(const TSharedPtr<FJsonObject>& Object, const TCHAR* Field)
+    {
+        TArray<FString> Values;
+        Object->TryGetStringArrayField(Field, Values);
+        return Values;
+    }
+
+    float GetWeight(const TSharedPtr<FJsonObject>& Object)
+    {
+        double Weight = 1.0;
+        Object->TryGetNumberField(TEXT("Weight"), Weight);
+        return static_cast<float>(Weight);
+    }
+
+    // Calls Visitor for every object in the named array; fails if any entry lacks RequiredField.
+    template <typename VisitorType>
+    bool ForEachEntry(const TSharedPtr<FJsonObject>& Root, const TCHAR* ArrayName, const TCHAR* RequiredField, FString& OutError, VisitorType&& Visitor)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Entries = nullptr;
+        if (!Root->TryGetArrayField(ArrayName, Entries))
+        {
+            OutError = FString::Printf(TEXT("Missing array '%s'"), ArrayName);
+            return false;
+        }
+
+        for (int32 Index = 0; Index < Entries->Num(); ++Index)
+        {
+            const TSharedPtr<FJsonObject>* Entry = nullptr;
+            if (!(*Entries)[Index]->TryGetObject(Entry) || GetString(*Entry, RequiredField).IsEmpty())
+            {
+                OutError = FString::Printf(TEXT("%s[%d] must be an object with a non-empty '%s'"), ArrayName, Index, RequiredField);
+                return false;
+            }
+
+            if (!Visitor(*Entry, OutError))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Set by hosts without a project layout (NeonMissionTool) before the catalog is first mapped
+    FString SourcePathOverride;
+    FString CookedPathOverride;
+}
+
+FMissionCatalog& FMissionCatalog::Get()
+{
+    static TUniquePtr<FMissionCatalog> Catalog = []()
+    {
+        TUniquePtr<FMissionCatalog> NewCatalog(new FMissionCatalog());
+
+        const FString SourcePath = GetSourcePath();
+        const FString CookedPath = GetCookedPath();
+
+        // Why the cooked file could not be produced, if cooking was attempted
+        FString CookError;
+
+#if !UE_BUILD_SHIPPING
+        // Keep the cooked file in step with the editable source during development
+        const FDateTime SourceTime = IFileManager::Get().GetTimeStamp(*SourcePath);
+        const FDateTime CookedTime = IFileManager::Get().GetTimeStamp(*CookedPath);
+        const bool bSourceAvailable = SourceTime != FDateTime::MinValue();
+        if (bSourceAvailable && (CookedTime == FDateTime::MinValue() || SourceTime > CookedTime))
+        {
+            if (!CookFile(SourcePath, CookedPath, CookError))
+            {
+                UE_LOG(LogTemp, Error, TEXT("FMissionCatalog - Failed to cook %s: %s"), *SourcePath, *CookError);
+            }
+        }
+
+        // A cooked file from an older format version is re-cooked once before giving up
+        bool bMapped = NewCatalog->MapCookedFile(CookedPath);
+        if (!bMapped && bSourceAvailable)
+        {
+            bMapped = CookFile(SourcePath, CookedPath, CookError) && NewCatalog->MapCookedFile(CookedPath);
+        }
+#else
+        const bool bMapped = NewCatalog->MapCookedFile(CookedPath);
+#endif
+
+        // Callers check IsLoaded and report GetLoadError; an unloaded catalog is empty, not fatal
+        if (!bMapped)
+        {
+            NewCatalog->LoadError = CookError.IsEmpty()
+                ? FString::Printf(TEXT("Could not load cooked mission catalog %s"), *CookedPath)
+                : FString::Printf(TEXT("Could not load cooked mission catalog %s (%s)"), *CookedPath, *CookError);
+            UE_LOG(LogTemp, Error, TEXT("FMissionCatalog - %s"), *NewCatalog->LoadError);
+        }
+
+        return NewCatalog;
+    }();
+
+    return *Catalog;
+}
+
+void FMissionCatalog::SetPaths(const FString& SourcePath, const FString& CookedPath)
+{
+    SourcePathOverride = SourcePath;
+    CookedPathOverride = CookedPath;
+}
+
+FString FMissionCatalog::GetSourcePath()
+{
+    return SourcePathOverride.IsEmpty() ? FPaths::ProjectDir() / TEXT("Data/MissionCatalog.json") : SourcePathOverride;
+}
+
+FString FMissionCatalog::GetCookedPath()
+{
+    return CookedPathOverride.IsEmpty() ? FPaths::ProjectContentDir() / TEXT("Data/MissionCatalog.ncat") : CookedPathOverride;
+}
+
+bool FMissionCatalog::CookFromJson(const FString& JsonText, TArray<uint8>& OutBytes, FString& OutError)
+{
+    TSharedPtr<FJsonObject> Root;
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+    if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+    {
+        OutError = FString::Printf(TEXT("Invalid JSON: %s"), *Reader->GetErrorMessage());
+        return false;
+    }
+
+    FCatalogWriter Writer;
+
+    TArray<FAbilityRecord> Abilities;
+    TMap<FString, uint32> AbilityIndices;
+    bool bOk = ForEachEntry(Root, TEXT("Abilities"), TEXT("Name"), OutError, [&](const TSharedPtr<FJsonObject>& Entry, FString& Error)
+    {
+        int32 Cooldown = 0;
+        bool bHasCooldown = false;
+        Entry->TryGetNumberField(TEXT("CooldownSeconds"), Cooldown);
+        Entry->TryGetBoolField(TEXT("HasCooldown"), bHasCooldown);
+
+        FAbilityRecord& Record = Abilities.AddDefaulted_GetRef();
+        Record.Name = Writer.AddString(GetString(Entry, TEXT("Name")));
+        Record.Description = Writer.AddString(GetString(Entry, TEXT("Description")));
+        Record.DamageType = Writer.AddString(GetString(Entry, TEXT("DamageType")));
+        Record.CooldownSeconds = Cooldown;
+        Record.bHasCooldown = bHasCooldown ? 1 : 0;
+
+        AbilityIndices.Add(GetString(Entry, TEXT("Name")), static_cast<uint32>(Abilities.Num() - 1));
+        return true;
+    });
+
+    TArray<FArchetypeRecord> Archetypes;
+    uint64 NumArchetypeAbilities = 0;
+    bOk = bOk && ForEachEntry(Root, TEXT("Archetypes"), TEXT("Name"), OutError, [&](const TSharedPtr<FJsonObject>& Entry, FString& Error)
+    {
+        TArray<uint32> AbilityList;
+        for (const FString& AbilityName : GetStringArray(Entry, TEXT("Abilities")))
+        {
+            const uint32* AbilityIndex = AbilityIndices.Find(AbilityName);
+            if (!AbilityIndex)
+            {
+                Error = FString::Printf(TEXT("Archetype '%s' references unknown ability '%s'"), *GetString(Entry, TEXT("Name")), *AbilityName);
+                return false;
+            }
+            AbilityList.Add(*AbilityIndex);
+        }
+
+        if (AbilityList.Num() == 0)
+        {
+            Error = FString::Printf(TEXT("Archetype '%s' needs at least one ability"), *GetString(Entry, TEXT("Name")));
+            return false;
+        }
+
+        FArchetypeRecord& Record = Archetypes.AddDefaulted_GetRef();
+        Record.Name = Writer.AddString(GetString(Entry, TEXT("Name")));
+        Record.Role = Writer.AddString(GetString(Entry, TEXT("Role")));
+        Record.Signature = Writer.AddString(GetString(Entry, TEXT("Signature")));
+        Record.Abilities = Writer.AddIndexList(AbilityList);
+        NumArchetypeAbilities += AbilityList.Num();
+        return true;
+    });
+
+    TArray<FWeaponRecord> Weapons;
+    bOk = bOk && ForEachEntry(Root, TEXT("Weapons"), TEXT("Name"), OutError, [&](const TSharedPtr<FJsonObject>& Entry, FString& Error)
+    {
+        FWeaponRecord& Record = Weapons.AddDefaulted_GetRef();
+        Record.Name = Writer.AddString(GetString(Entry, TEXT("Name")));
+        Record.Category = Writer.AddString(GetString(Entry, TEXT("Category")));
+        Record.Description = Writer.AddString(GetString(Entry, TEXT("Description")));
+        Record.DamageProfile = Writer.AddString(GetString(Entry, TEXT("DamageProfile")));
+        return true;
+    });
+
+    TArray<FImplantRecord> Implants;
+    bOk = bOk && ForEachEntry(Root, TEXT("Implants"), TEXT("Name"), OutError, [&](const TSharedPtr<FJsonObject>& Entry, FString& Error)
+    {
+        FImplantRecord& Record = Implants.AddDefaulted_GetRef();
+        Record.Name = Writer.AddString(GetString(Entry, TEXT("Name")));
+        Record.Slot = Writer.AddString(GetString(Entry, TEXT("Slot")));
+        Record.Effects = Writer.AddStringList(GetStringArray(Entry, TEXT("Effects")));
+        return true;
+    });
+
+    TArray<FDistrictRecord> Districts;
+    bOk = bOk && ForEachEntry(Root, TEXT("Districts"), TEXT("Name"), OutError, [&](const TSharedPtr<FJsonObject>& Entry, FString& Error)
+    {
+        FDistrictRecord& Record = Districts.AddDefaulted_GetRef();
+        Record.Name = Writer.AddString(GetString(Entry, TEXT("Name")));
+        Record.Description = Writer.AddString(GetString(Entry, TEXT("Description")));
+        Record.Hazards = Writer.AddStringList(GetStringArray(Entry, TEXT("Hazards")));
+        Record.EnemyProfiles = Writer.AddStringList(GetStringArray(Entry, TEXT("EnemyProfiles")));
+        Record.Tag = Writer.AddString(GetString(Entry, TEXT("Tag")));
+        Record.Weight = GetWeight(Entry);
+        return true;
+    });
+
+    TArray<FFactionRecord> Factions;
+    bOk = bOk && ForEachEntry(Root, TEXT("Factions"), TEXT("Name"), OutError, [&](const TSharedPtr<FJsonObject>& Entry, FString& Error)
+    {
+        FFactionRecord& Record = Factions.AddDefaulted_GetRef();
+        Record.Name = Writer.AddString(GetString(Entry, TEXT("Name")));
+        Record.Philosophy = Writer.AddString(GetString(Entry, TEXT("Philosophy")));
+        Record.SignatureTactics = Writer.AddStringList(GetStringArray(Entry, TEXT("SignatureTactics")));
+        Record.OperatingDistricts = Writer.AddStringList(GetStringArray(Entry, TEXT("OperatingDistricts")));
+        Record.Tag = Writer.AddString(GetString(Entry, TEXT("Tag")));
+        Record.Weight = GetWeight(Entry);
+        return true;
+    });
+
+    TArray<FComplicationRecord> Complications;
+    bOk = bOk && ForEachEntry(Root, TEXT("Complications"), TEXT("Description"), OutError, [&](const TSharedPtr<FJsonObject>& Entry, FString& Error)
+    {
+        FComplicationRecord& Record = Complications.AddDefaulted_GetRef();
+        Record.Description = Writer.AddString(GetString(Entry, TEXT("Description")));
+        Record.Districts = Writer.AddStringList(GetStringArray(Entry, TEXT("Districts")));
+        Record.Factions = Writer.AddStringList(GetStringArray(Entry, TEXT("Factions")));
+        Record.Tag = Writer.AddString(GetString(Entry, TEXT("Tag")));
+        Record.Weight = GetWeight(Entry);
+        return true;
+    });
+
+    if (!bOk)
+    {
+        return false;
+    }
+
+    TArray<uint32> ExtractionConditions;
+    for (const FString& Condition : GetStringArray(Root, TEXT("ExtractionConditions")))
+    {
+        ExtractionConditions.Add(Writer.AddString(Condition));
+    }
+
+    if (Archetypes.Num() == 0 || Weapons.Num() == 0 || Implants.Num() == 0 || Districts.Num() == 0
+        || Factions.Num() == 0 || Complications.Num() == 0 || ExtractionConditions.Num() == 0)
+    {
+        OutError = TEXT("Every catalog table needs at least one entry");
+        return false;
+    }
+
+    // Brief codes store a mission-space rank in MissionBriefCode::RankBits. Compatibility rules
+    // only remove combinations, so the unconstrained product bounds the space from above.
+    const uint64 MaxRanks = uint64(1) << MissionBriefCode::RankBits;
+    uint64 SpaceBound = 1;
+    for (const uint64 Factor : { static_cast<uint64>(Districts.Num()), static_cast<uint64>(Factions.Num()), static_cast<uint64>(Complications.Num()),
+        NumArchetypeAbilities, static_cast<uint64>(Weapons.Num()), static_cast<uint64>(Implants.Num()), static_cast<uint64>(ExtractionConditions.Num()) })
+    {
+        if (Factor > MaxRanks / SpaceBound)
+        {
+            OutError = FString::Printf(TEXT("The catalog allows more than 2^%u mission combinations, which brief codes cannot address"), MissionBriefCode::RankBits);
+            return false;
+        }
+        SpaceBound *= Factor;
+    }
+
+    FHeader Header;
+    Header.Magic = Magic;
+    Header.Version = Version;
+
+    OutBytes.Reset();
+    OutBytes.AddZeroed(sizeof(FHeader));
+    AppendSection(OutBytes, Header, ESection::Strings, Writer.Strings);
+    AppendSection(OutBytes, Header, ESection::Lists, Writer.Lists);
+    AppendSection(OutBytes, Header, ESection::Abilities, Abilities);
+    AppendSection(OutBytes, Header, ESection::Archetypes, Archetypes);
+    AppendSection(OutBytes, Header, ESection::Weapons, Weapons);
+    AppendSection(OutBytes, Header, ESection::Implants, Implants);
+    AppendSection(OutBytes, Header, ESection::Districts, Districts);
+    AppendSection(OutBytes, Header, ESection::Factions, Factions);
+    AppendSection(OutBytes, Header, ESection::Complications, Complications);
+    AppendSection(OutBytes, Header, ESection::ExtractionConditions, ExtractionConditions);
+
+    Header.ContentHash = FCrc::MemCrc32(OutBytes.GetData() + sizeof(FHeader), OutBytes.Num() - sizeof(FHeader));
+    FMemory::Memcpy(OutBytes.GetData(), &Header, sizeof(FHeader));
+
+    return true;
+}
+
+bool FMissionCatalog::CookFile(const FString& SourcePath, const FString& CookedPath, FString& OutError)
+{
+    FString JsonText;
+    if (!FFileHelper::LoadFileToString(JsonText, *SourcePath))
+    {
+        OutError = FString::Printf(TEXT("Could not read %s"), *SourcePath);
+        return false;
+    }
+
+    TArray<uint8> Bytes;
+    if (!CookFromJson(JsonText, Bytes, OutError))
+    {
+        return false;
+    }
+
+    if (!FFileHelper::SaveArrayToFile(Bytes, *CookedPath))
+    {
+        OutError = FString::Printf(TEXT("Could not write %s"), *CookedPath);
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("FMissionCatalog - Cooked %s -> %s (%d bytes)"), *SourcePath, *CookedPath, Bytes.Num());
+    return true;
+}
+
+FMissionCatalog::~FMissionCatalog()
+{
+    Unmap();
+}
+
+bool FMissionCatalog::RecookAndReload(FString& OutError)
+{
+    FString JsonText;
+    if (!FFileHelper::LoadFileToString(JsonText, *GetSourcePath()))
+    {
+        OutError = FString::Printf(TEXT("Could not read %s"), *GetSourcePath());
+        return false;
+    }
+
+    // Cook into memory first so a broken edit leaves the current catalog in place
+    TArray<uint8> Bytes;
+    if (!CookFromJson(JsonText, Bytes, OutError))
+    {
+        return false;
+    }
+
+    // The mapping has to be released before the file can be replaced on every platform
+    Unmap();
+
+    const FString CookedPath = GetCookedPath();
+    if (FFileHelper::SaveArrayToFile(Bytes, *CookedPath) && MapCookedFile(CookedPath))
+    {
+        return true;
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("FMissionCatalog - Could not replace %s; using the recooked catalog from memory"), *CookedPath);
+    return AdoptBytes(MoveTemp(Bytes));
+}
+
+int32 FMissionCatalog::Num(ESection Section) const
+{
+    return Header ? static_cast<int32>(Header->Sections[static_cast<uint32>(Section)].Count) : 0;
+}
+
+const ANSICHAR* FMissionCatalog::GetString(uint32 Offset) const
+{
+    if (!Header)
+    {
+        return "";
+    }
+
+    const FSection& Strings = Header->Sections[static_cast<uint32>(ESection::Strings)];
+    const uint32 SafeOffset = Offset < Strings.Count ? Offset : 0;
+    return reinterpret_cast<const ANSICHAR*>(Data + Strings.Offset + SafeOffset);
+}
+
+TConstArrayView<uint32> FMissionCatalog::GetList(const FRange& Range) const
+{
+    const TConstArrayView<uint32> Lists = GetRecords<uint32>(ESection::Lists);
+    if (Range.First > static_cast<uint32>(Lists.Num()) || Range.Count > static_cast<uint32>(Lists.Num()) - Range.First)
+    {
+        return TConstArrayView<uint32>();
+    }
+
+    return Lists.Slice(Range.First, Range.Count);
+}
+
+bool FMissionCatalog::MapCookedFile(const FString& Path)
+{
+    Unmap();
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    MappedFile.Reset(PlatformFile.OpenMapped(*Path));
+    if (MappedFile)
+    {
+        MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+        if (MappedRegion && ValidateAndBind(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize()))
+        {
+            return true;
+        }
+
+        Unmap();
+        return false;
+    }
+
+    // Platforms without mapped file support read the file once instead
+    TArray<uint8> Bytes;
+    return FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent) && AdoptBytes(MoveTemp(Bytes));
+}
+
+bool FMissionCatalog::AdoptBytes(TArray<uint8>&& Bytes)
+{
+    Unmap();
+
+    OwnedBytes = MoveTemp(Bytes);
+    if (ValidateAndBind(OwnedBytes.GetData(), OwnedBytes.Num()))
+    {
+        return true;
+    }
+
+    Unmap();
+    return false;
+}
+
+bool FMissionCatalog::ValidateAndBind(const uint8* InData, int64 InSize)
+{
+    if (!InData || InSize < static_cast<int64>(sizeof(FHeader)))
+    {
+        return false;
+    }
+
+    const FHeader* InHeader = reinterpret_cast<const FHeader*>(InData);
+    if (InHeader->Magic != Magic || InHeader->Version != Version)
+    {
+        UE_LOG(LogTemp, Error, TEXT("FMissionCatalog - Unsupported catalog (magic 0x%08x, version %u)"), InHeader->Magic, InHeader->Version);
+        return false;
+    }
+
+    // Only section bounds are checked here, so binding stays O(1); record offsets are checked on access
+    for (uint32 SectionIndex = 0; SectionIndex < static_cast<uint32>(ESection::Count); ++SectionIndex)
+    {
+        const FSection& Section = InHeader->Sections[SectionIndex];
+        const int64 SectionEnd = static_cast<int64>(Section.Offset) + static_cast<int64>(Section.Count) * GetElementSize(static_cast<ESection>(SectionIndex));
+        if (Section.Offset % SectionAlignment != 0 || SectionEnd > InSize)
+        {
+            UE_LOG(LogTemp, Error, TEXT("FMissionCatalog - Section %u is out of bounds"), SectionIndex);
+            return false;
+        }
+    }
+
+    // A NUL-terminated pool guarantees every in-range string offset is terminated
+    const FSection& Strings = InHeader->Sections[static_cast<uint32>(ESection::Strings)];
+    if (Strings.Count == 0 || InData[Strings.Offset + Strings.Count - 1] != 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("FMissionCatalog - String pool is not terminated"));
+        return false;
+    }
+
+    Data = InData;
+    Size = InSize;
+    Header = InHeader;
+    LoadError.Reset();
+    return true;
+}
+
+void FMissionCatalog::Unmap()
+{
+    Header = nullptr;
+    Data = nullptr;
+    Size = 0;
+
+    MappedRegion.Reset();
+    MappedFile.Reset();
+    OwnedBytes.Empty();
+}
@@ -0,0 +1,96 @@
+#include "MissionCatalogIndex.h"
+
+#include "MissionCatalog.h"
+
+using namespace MissionCatalogFormat;
+
+namespace
+{
+    FName MakeName(const FMissionCatalog& Catalog, uint32 Offset)
+    {
+        return FName(UTF8_TO_TCHAR(Catalog.GetString(Offset)));
+    }
+}
+
+void FMissionCatalogIndex::FNameTable::Add(FName Name, int32 Index)
+{
+    if (Indices.Contains(Name))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("FMissionCatalogIndex - Duplicate catalog name '%s'; keeping the first entry"), *Name.ToString());
+        return;
+    }
+
+    Indices.Add(Name, Index);
+}
+
+int32 FMissionCatalogIndex::FNameTable::Find(FName Name) const
+{
+    const int32* Index = Indices.Find(Name);
+    return Index ? *Index : INDEX_NONE;
+}
+
+TUniquePtr<FMissionCatalogIndex>& FMissionCatalogIndex::GetStorage()
+{
+    static TUniquePtr<FMissionCatalogIndex> Index(new FMissionCatalogIndex());
+    return Index;
+}
+
+const FMissionCatalogIndex& FMissionCatalogIndex::Get()
+{
+    return *GetStorage();
+}
+
+void FMissionCatalogIndex::Rebuild()
+{
+    GetStorage().Reset(new FMissionCatalogIndex());
+}
+
+FMissionCatalogIndex::FMissionCatalogIndex()
+{
+    const FMissionCatalog& Catalog = FMissionCatalog::Get();
+
+    for (int32 Index = 0; Index < Catalog.Num(ESection::Archetypes); ++Index)
+    {
+        const FArchetypeRecord& Record = Catalog.GetArchetype(Index);
+        Archetypes.Add(MakeName(Catalog, Record.Name), Index);
+
+        TArray<FName>& AbilityNames = ArchetypeAbilities.AddDefaulted_GetRef();
+        for (const uint32 AbilityIndex : Catalog.GetList(Record.Abilities))
+        {
+            AbilityNames.Add(AbilityIndex < static_cast<uint32>(Catalog.Num(ESection::Abilities))
+                ? MakeName(Catalog, Catalog.GetAbility(AbilityIndex).Name)
+                : NAME_None);
+        }
+    }
+
+    for (int32 Index = 0; Index < Catalog.Num(ESection::Weapons); ++Index)
+    {
+        Weapons.Add(MakeName(Catalog, Catalog.GetWeapon(Index).Name), Index);
+    }
+    for (int32 Index = 0; Index < Catalog.Num(ESection::Implants); ++Index)
+    {
+        Implants.Add(MakeName(Catalog, Catalog.GetImplant(Index).Name), Index);
+    }
+    for (int32 Index = 0; Index < Catalog.Num(ESection::Districts); ++Index)
+    {
+        Districts.Add(MakeName(Catalog, Catalog.GetDistrict(Index).Name), Index);
+    }
+    for (int32 Index = 0; Index < Catalog.Num(ESection::Factions); ++Index)
+    {
+        Factions.Add(MakeName(Catalog, Catalog.GetFaction(Index).Name), Index);
+    }
+    for (int32 Index = 0; Index < Catalog.Num(ESection::Complications); ++Index)
+    {
+        Complications.Add(MakeName(Catalog, Catalog.GetComplication(Index).Description), Index);
+    }
+    for (int32 Index = 0; Index < Catalog.Num(ESection::ExtractionConditions); ++Index)
+    {
+        ExtractionConditions.Add(MakeName(Catalog, Catalog.GetExtractionCondition(Index)), Index);
+    }
+}
+
+int32 FMissionCatalogIndex::FindArchetypeAbility(int32 Archetype, FName AbilityName) const
+{
+    // Archetypes carry a handful of abilities, so this is a short scan of integer compares
+    return ArchetypeAbilities.IsValidIndex(Archetype) ? ArchetypeAbilities[Archetype].IndexOfByKey(AbilityName) : INDEX_NONE;
+}
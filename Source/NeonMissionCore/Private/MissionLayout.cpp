@@ -0,0 +1,575 @@
+#include "MissionLayout.h"
+
+#include "MissionCatalog.h"
+#include "MissionRandom.h"
+#include "MissionSpace.h"
+#include "Async/ParallelFor.h"
+
+using namespace MissionCatalogFormat;
+
+namespace
+{
+    constexpr int32 MinSectorSize = 8;
+    constexpr int32 MaxSectorSize = 64;
+    constexpr int32 MaxSectorsPerSide = 16;
+    constexpr int32 DoorWidth = 2;
+    constexpr int32 EnemyCandidatesPerSector = 3;
+    constexpr int32 HazardCandidatesPerSector = 2;
+
+    // Seed of the per-district room-rule weights; independent of the brief so a district always
+    // looks alike
+    constexpr int32 DistrictStyleSeed = 0x4C41594F;
+
+    constexpr int32 NumSectorKinds = static_cast<int32>(EMissionSectorKind::Count);
+
+    enum class ESide : uint8
+    {
+        West,
+        East,
+        North,
+        South,
+        Count
+    };
+
+    constexpr int32 NumSides = static_cast<int32>(ESide::Count);
+
+    // Door offset along every side of every sector, INDEX_NONE where the seam is closed. Both
+    // sectors of an open seam store the same offset, so their doors line up.
+    struct FSectorGraph
+    {
+        TArray<int32> Doors;
+
+        int32 GetDoor(int32 Sector, ESide Side) const { return Doors[Sector * NumSides + static_cast<int32>(Side)]; }
+    };
+
+    // Slot candidates of one sector, as tile indices into FMissionLayout::Tiles.
+    struct FSectorSlots
+    {
+        TArray<uint32, TInlineAllocator<EnemyCandidatesPerSector>> Enemies;
+        TArray<uint32, TInlineAllocator<HazardCandidatesPerSector>> Hazards;
+        // Open tile closest to the sector centre; player start and extraction use it
+        uint32 Anchor = 0;
+    };
+
+    // One sector's window onto the shared tile array. Sectors never write outside their window.
+    struct FSectorTiles
+    {
+        EMissionTile* Tiles = nullptr;
+        int32 Stride = 0;
+        int32 OriginX = 0;
+        int32 OriginY = 0;
+        int32 Size = 0;
+
+        EMissionTile& At(int32 X, int32 Y) const
+        {
+            return Tiles[(OriginY + Y) * Stride + OriginX + X];
+        }
+
+        uint32 ToTileIndex(int32 X, int32 Y) const
+        {
+            return static_cast<uint32>((OriginY + Y) * Stride + OriginX + X);
+        }
+
+        // Inclusive rectangle, clipped to the sector interior.
+        void Fill(int32 X0, int32 Y0, int32 X1, int32 Y1, EMissionTile Tile) const
+        {
+            for (int32 Y = FMath::Max(Y0, 1); Y <= FMath::Min(Y1, Size - 2); ++Y)
+            {
+                for (int32 X = FMath::Max(X0, 1); X <= FMath::Min(X1, Size - 2); ++X)
+                {
+                    At(X, Y) = Tile;
+                }
+            }
+        }
+    };
+
+    int32 FindRoot(TArray<int32>& Parents, int32 Sector)
+    {
+        while (Parents[Sector] != Sector)
+        {
+            Parents[Sector] = Parents[Parents[Sector]];
+            Sector = Parents[Sector];
+        }
+        return Sector;
+    }
+
+    // Random spanning tree over the sector grid (Kruskal over shuffled seams), so every sector is
+    // reachable, plus LoopChance of the remaining seams.
+    FSectorGraph BuildSectorGraph(int32 SectorsX, int32 SectorsY, int32 SectorSize, float LoopChance, FMissionCounterRandom& Random)
+    {
+        struct FSeam
+        {
+            int32 A;
+            int32 B;
+            // B is east of A; otherwise south of it
+            bool bEast;
+        };
+
+        const int32 NumSectors = SectorsX * SectorsY;
+
+        TArray<FSeam> Seams;
+        for (int32 Y = 0; Y < SectorsY; ++Y)
+        {
+            for (int32 X = 0; X < SectorsX; ++X)
+            {
+                const int32 Sector = Y * SectorsX + X;
+                if (X + 1 < SectorsX)
+                {
+                    Seams.Add({ Sector, Sector + 1, true });
+                }
+                if (Y + 1 < SectorsY)
+                {
+                    Seams.Add({ Sector, Sector + SectorsX, false });
+                }
+            }
+        }
+
+        for (int32 Index = Seams.Num() - 1; Index > 0; --Index)
+        {
+            Seams.Swap(Index, Random.RandRange(0, Index));
+        }
+
+        TArray<int32> Parents;
+        Parents.SetNumUninitialized(NumSectors);
+        for (int32 Sector = 0; Sector < NumSectors; ++Sector)
+        {
+            Parents[Sector] = Sector;
+        }
+
+        FSectorGraph Graph;
+        Graph.Doors.Init(INDEX_NONE, NumSectors * NumSides);
+
+        for (const FSeam& Seam : Seams)
+        {
+            // Both draws happen for every seam, so later seams do not depend on earlier outcomes
+            const float LoopRoll = Random.GetFraction();
+            const int32 Offset = Random.RandRange(2, SectorSize - 2 - DoorWidth);
+
+            const int32 RootA = FindRoot(Parents, Seam.A);
+            const int32 RootB = FindRoot(Parents, Seam.B);
+            if (RootA != RootB)
+            {
+                Parents[RootA] = RootB;
+            }
+            else if (LoopRoll >= LoopChance)
+            {
+                continue;
+            }
+
+            Graph.Doors[Seam.A * NumSides + static_cast<int32>(Seam.bEast ? ESide::East : ESide::South)] = Offset;
+            Graph.Doors[Seam.B * NumSides + static_cast<int32>(Seam.bEast ? ESide::West : ESide::North)] = Offset;
+        }
+
+        return Graph;
+    }
+
+    void GetDistrictWeights(int32 DistrictIndex, float (&OutWeights)[NumSectorKinds])
+    {
+        FMissionCounterRandom Random(DistrictStyleSeed, static_cast<uint64>(DistrictIndex));
+        for (float& Weight : OutWeights)
+        {
+            Weight = 0.25f + Random.GetFraction();
+        }
+    }
+
+    EMissionSectorKind PickSectorKind(const float (&Weights)[NumSectorKinds], FMissionCounterRandom& Random)
+    {
+        float Total = 0.0f;
+        for (const float Weight : Weights)
+        {
+            Total += Weight;
+        }
+
+        float Roll = Random.GetFraction() * Total;
+        for (int32 Kind = 0; Kind < NumSectorKinds - 1; ++Kind)
+        {
+            Roll -= Weights[Kind];
+            if (Roll < 0.0f)
+            {
+                return static_cast<EMissionSectorKind>(Kind);
+            }
+        }
+        return static_cast<EMissionSectorKind>(NumSectorKinds - 1);
+    }
+
+    // Expands one sector's room rule. Doors sit at offsets [2, Size - 4], and every rule keeps the
+    // interior tiles behind its doors connected.
+    void FillSector(const FSectorTiles& Sector, EMissionSectorKind Kind, const FSectorGraph& Graph, int32 SectorIndex, FMissionCounterRandom& Random)
+    {
+        const int32 Size = Sector.Size;
+        const int32 Last = Size - 1;
+        const int32 Center = Size / 2;
+        const EMissionTile Interior = Kind == EMissionSectorKind::Corridor ? EMissionTile::Wall : EMissionTile::Floor;
+
+        for (int32 Y = 0; Y < Size; ++Y)
+        {
+            for (int32 X = 0; X < Size; ++X)
+            {
+                const bool bBorder = X == 0 || Y == 0 || X == Last || Y == Last;
+                Sector.At(X, Y) = bBorder ? EMissionTile::Wall : Interior;
+            }
+        }
+
+        switch (Kind)
+        {
+        case EMissionSectorKind::Plaza:
+        {
+            const int32 NumCover = Random.RandRange(Size / 4, Size / 2);
+            for (int32 Index = 0; Index < NumCover; ++Index)
+            {
+                const int32 X = Random.RandRange(3, Size - 4);
+                const int32 Y = Random.RandRange(3, Size - 4);
+                const bool bVertical = Random.GetFraction() < 0.5f;
+                const int32 EndX = bVertical ? X : X + 1;
+                const int32 EndY = bVertical ? Y + 1 : Y;
+
+                // Pieces never touch, not even diagonally, so they cannot wall off a tile
+                bool bClear = true;
+                for (int32 NearY = Y - 1; NearY <= EndY + 1; ++NearY)
+                {
+                    for (int32 NearX = X - 1; NearX <= EndX + 1; ++NearX)
+                    {
+                        bClear &= Sector.At(NearX, NearY) == EMissionTile::Floor;
+                    }
+                }
+
+                if (bClear)
+                {
+                    Sector.At(X, Y) = EMissionTile::Cover;
+                    Sector.At(EndX, EndY) = EMissionTile::Cover;
+                }
+            }
+            break;
+        }
+        case EMissionSectorKind::Corridor:
+        {
+            Sector.Fill(Center - 2, Center - 2, Center + 1, Center + 1, EMissionTile::Floor);
+            for (int32 Side = 0; Side < NumSides; ++Side)
+            {
+                const int32 Offset = Graph.GetDoor(SectorIndex, static_cast<ESide>(Side));
+                if (Offset == INDEX_NONE)
+                {
+                    continue;
+                }
+
+                // Straight lane in from the door, then a bend onto the central room
+                switch (static_cast<ESide>(Side))
+                {
+                case ESide::West:
+                    Sector.Fill(1, Offset, Center, Offset + 1, EMissionTile::Floor);
+                    break;
+                case ESide::East:
+                    Sector.Fill(Center - 1, Offset, Last - 1, Offset + 1, EMissionTile::Floor);
+                    break;
+                case ESide::North:
+                    Sector.Fill(Offset, 1, Offset + 1, Center, EMissionTile::Floor);
+                    break;
+                default:
+                    Sector.Fill(Offset, Center - 1, Offset + 1, Last - 1, EMissionTile::Floor);
+                    break;
+                }
+
+                const bool bHorizontalLane = Side == static_cast<int32>(ESide::West) || Side == static_cast<int32>(ESide::East);
+                if (bHorizontalLane)
+                {
+                    Sector.Fill(Center - 1, FMath::Min(Offset, Center - 1), Center, FMath::Max(Offset + 1, Center), EMissionTile::Floor);
+                }
+                else
+                {
+                    Sector.Fill(FMath::Min(Offset, Center - 1), Center - 1, FMath::Max(Offset + 1, Center), Center, EMissionTile::Floor);
+                }
+            }
+            break;
+        }
+        case EMissionSectorKind::Block:
+        {
+            // Three-tile walkway around the footprint; single cover tiles on its middle lane
+            Sector.Fill(4, 4, Size - 5, Size - 5, EMissionTile::Wall);
+            const int32 NumCover = Size / 4;
+            for (int32 Index = 0; Index < NumCover; ++Index)
+            {
+                const int32 Along = Random.RandRange(4, Size - 5);
+                switch (static_cast<ESide>(Random.RandRange(0, NumSides - 1)))
+                {
+                case ESide::West:
+                    Sector.At(2, Along) = EMissionTile::Cover;
+                    break;
+                case ESide::East:
+                    Sector.At(Size - 3, Along) = EMissionTile::Cover;
+                    break;
+                case ESide::North:
+                    Sector.At(Along, 2) = EMissionTile::Cover;
+                    break;
+                default:
+                    Sector.At(Along, Size - 3) = EMissionTile::Cover;
+                    break;
+                }
+            }
+            break;
+        }
+        default:
+        {
+            // Rows stop short of the walls and each has a two-tile gap
+            for (int32 Y = 3; Y <= Size - 4; Y += 4)
+            {
+                const int32 Gap = Random.RandRange(3, Size - 5);
+                for (int32 X = 3; X <= Size - 4; ++X)
+                {
+                    if (X != Gap && X != Gap + 1)
+                    {
+                        Sector.At(X, Y) = EMissionTile::Cover;
+                    }
+                }
+            }
+            break;
+        }
+        }
+
+        for (int32 Side = 0; Side < NumSides; ++Side)
+        {
+            const int32 Offset = Graph.GetDoor(SectorIndex, static_cast<ESide>(Side));
+            if (Offset == INDEX_NONE)
+            {
+                continue;
+            }
+
+            for (int32 Along = Offset; Along < Offset + DoorWidth; ++Along)
+            {
+                switch (static_cast<ESide>(Side))
+                {
+                case ESide::West:
+                    Sector.At(0, Along) = EMissionTile::Door;
+                    break;
+                case ESide::East:
+                    Sector.At(Last, Along) = EMissionTile::Door;
+                    break;
+                case ESide::North:
+                    Sector.At(Along, 0) = EMissionTile::Door;
+                    break;
+                default:
+                    Sector.At(Along, Last) = EMissionTile::Door;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Picks slot candidates among floor tiles at least two tiles from the sector walls. Enemy
+    // spawns prefer tiles next to cover.
+    void CollectSectorSlots(const FSectorTiles& Sector, FMissionCounterRandom& Random, FSectorSlots& OutSlots)
+    {
+        const int32 Size = Sector.Size;
+        const int32 Center = Size / 2;
+
+        int32 AnchorX = Center;
+        int32 AnchorY = Center;
+        int32 BestDistance = MAX_int32;
+        for (int32 Y = 2; Y <= Size - 3; ++Y)
+        {
+            for (int32 X = 2; X <= Size - 3; ++X)
+            {
+                const int32 Distance = FMath::Abs(X - Center) + FMath::Abs(Y - Center);
+                if (Sector.At(X, Y) == EMissionTile::Floor && Distance < BestDistance)
+                {
+                    AnchorX = X;
+                    AnchorY = Y;
+                    BestDistance = Distance;
+                }
+            }
+        }
+        OutSlots.Anchor = Sector.ToTileIndex(AnchorX, AnchorY);
+
+        TArray<uint32, TInlineAllocator<256>> Open;
+        TArray<uint32, TInlineAllocator<64>> Sheltered;
+        for (int32 Y = 2; Y <= Size - 3; ++Y)
+        {
+            for (int32 X = 2; X <= Size - 3; ++X)
+            {
+                if (Sector.At(X, Y) != EMissionTile::Floor || (X == AnchorX && Y == AnchorY))
+                {
+                    continue;
+                }
+
+                const uint32 TileIndex = Sector.ToTileIndex(X, Y);
+                Open.Add(TileIndex);
+                if (Sector.At(X - 1, Y) == EMissionTile::Cover || Sector.At(X + 1, Y) == EMissionTile::Cover
+                    || Sector.At(X, Y - 1) == EMissionTile::Cover || Sector.At(X, Y + 1) == EMissionTile::Cover)
+                {
+                    Sheltered.Add(TileIndex);
+                }
+            }
+        }
+
+        for (int32 Index = 0; Index < EnemyCandidatesPerSector && Open.Num() > 0; ++Index)
+        {
+            uint32 TileIndex;
+            if (Sheltered.Num() > 0)
+            {
+                const int32 Pick = Random.RandRange(0, Sheltered.Num() - 1);
+                TileIndex = Sheltered[Pick];
+                Sheltered.RemoveAtSwap(Pick, 1, EAllowShrinking::No);
+                Open.RemoveSingleSwap(TileIndex, EAllowShrinking::No);
+            }
+            else
+            {
+                const int32 Pick = Random.RandRange(0, Open.Num() - 1);
+                TileIndex = Open[Pick];
+                Open.RemoveAtSwap(Pick, 1, EAllowShrinking::No);
+            }
+            OutSlots.Enemies.Add(TileIndex);
+        }
+
+        for (int32 Index = 0; Index < HazardCandidatesPerSector && Open.Num() > 0; ++Index)
+        {
+            const int32 Pick = Random.RandRange(0, Open.Num() - 1);
+            OutSlots.Hazards.Add(Open[Pick]);
+            Open.RemoveAtSwap(Pick, 1, EAllowShrinking::No);
+        }
+    }
+
+    template <typename ArrayType>
+    void Shuffle(ArrayType& Values, FMissionCounterRandom& Random)
+    {
+        for (int32 Index = Values.Num() - 1; Index > 0; --Index)
+        {
+            Values.Swap(Index, Random.RandRange(0, Index));
+        }
+    }
+}
+
+namespace MissionLayout
+{
+    FMissionLayout Generate(const FMissionBriefHandle& Handle, const FMissionLayoutSettings& Settings)
+    {
+        FMissionLayout Layout;
+
+        const int64 Rank = MissionSpace::RankBrief(Handle);
+        if (Rank == INDEX_NONE)
+        {
+            return Layout;
+        }
+
+        const FMissionCatalog& Catalog = FMissionCatalog::Get();
+        const FDistrictRecord& District = Catalog.GetDistrict(Handle.DistrictIndex);
+
+        const int32 SectorsX = FMath::Clamp(Settings.SectorsX, 1, MaxSectorsPerSide);
+        const int32 SectorsY = FMath::Clamp(Settings.SectorsY, 1, MaxSectorsPerSide);
+        const int32 SectorSize = FMath::Clamp(Settings.SectorSize, MinSectorSize, MaxSectorSize);
+        const int32 NumSectors = SectorsX * SectorsY;
+
+        Layout.Seed = static_cast<int32>(FMissionCounterRandom::Mix(static_cast<uint64>(Rank) ^ FMissionCounterRandom::Mix(static_cast<uint32>(Settings.Variant))));
+        Layout.Width = static_cast<uint16>(SectorsX * SectorSize);
+        Layout.Height = static_cast<uint16>(SectorsY * SectorSize);
+        Layout.SectorSize = static_cast<uint8>(SectorSize);
+        Layout.SectorsX = static_cast<uint8>(SectorsX);
+        Layout.SectorsY = static_cast<uint8>(SectorsY);
+        Layout.Tiles.SetNumUninitialized(Layout.Width * Layout.Height);
+        Layout.SectorKinds.SetNumUninitialized(NumSectors);
+
+        // Stream 0 drives the graph, the room rules and the final slot selection; stream 1 + s
+        // belongs to sector s
+        FMissionCounterRandom Random(Layout.Seed, 0);
+        const FSectorGraph Graph = BuildSectorGraph(SectorsX, SectorsY, SectorSize, Settings.LoopChance, Random);
+
+        float Weights[NumSectorKinds];
+        GetDistrictWeights(Handle.DistrictIndex, Weights);
+        for (EMissionSectorKind& Kind : Layout.SectorKinds)
+        {
+            Kind = PickSectorKind(Weights, Random);
+        }
+
+        TArray<FSectorSlots> SectorSlots;
+        SectorSlots.SetNum(NumSectors);
+        EMissionTile* Tiles = Layout.Tiles.GetData();
+        const int32 Stride = Layout.Width;
+
+        ParallelFor(TEXT("MissionLayout::Generate"), NumSectors, 1, [&](int32 SectorIndex)
+        {
+            FSectorTiles Sector;
+            Sector.Tiles = Tiles;
+            Sector.Stride = Stride;
+            Sector.OriginX = (SectorIndex % SectorsX) * SectorSize;
+            Sector.OriginY = (SectorIndex / SectorsX) * SectorSize;
+            Sector.Size = SectorSize;
+
+            FMissionCounterRandom SectorRandom(Layout.Seed, 1 + static_cast<uint64>(SectorIndex));
+            FillSector(Sector, Layout.SectorKinds[SectorIndex], Graph, SectorIndex, SectorRandom);
+            CollectSectorSlots(Sector, SectorRandom, SectorSlots[SectorIndex]);
+        }, Settings.bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+        // Player start in a random sector, extraction in the sector the most doors away from it
+        const int32 StartSector = Random.RandRange(0, NumSectors - 1);
+        TArray<int32> Distances;
+        Distances.Init(INDEX_NONE, NumSectors);
+        TArray<int32> Queue;
+        Queue.Reserve(NumSectors);
+        Queue.Add(StartSector);
+        Distances[StartSector] = 0;
+        int32 ExtractionSector = StartSector;
+        for (int32 Head = 0; Head < Queue.Num(); ++Head)
+        {
+            const int32 Sector = Queue[Head];
+            if (Distances[Sector] > Distances[ExtractionSector])
+            {
+                ExtractionSector = Sector;
+            }
+
+            const int32 Neighbours[NumSides] = { Sector - 1, Sector + 1, Sector - SectorsX, Sector + SectorsX };
+            for (int32 Side = 0; Side < NumSides; ++Side)
+            {
+                if (Graph.GetDoor(Sector, static_cast<ESide>(Side)) != INDEX_NONE && Distances[Neighbours[Side]] == INDEX_NONE)
+                {
+                    Distances[Neighbours[Side]] = Distances[Sector] + 1;
+                    Queue.Add(Neighbours[Side]);
+                }
+            }
+        }
+
+        // Nothing spawns in the player's own sector
+        TArray<uint32> EnemyTiles;
+        TArray<uint32> HazardTiles;
+        for (int32 Sector = 0; Sector < NumSectors; ++Sector)
+        {
+            if (Sector != StartSector)
+            {
+                EnemyTiles.Append(SectorSlots[Sector].Enemies);
+                HazardTiles.Append(SectorSlots[Sector].Hazards);
+            }
+        }
+        Shuffle(EnemyTiles, Random);
+        Shuffle(HazardTiles, Random);
+        EnemyTiles.SetNum(FMath::Min(EnemyTiles.Num(), FMath::Max(Settings.EnemySpawnCount, 0)));
+        HazardTiles.SetNum(FMath::Min(HazardTiles.Num(), FMath::Max(Settings.HazardSlotCount, 0)));
+
+        auto AddSlot = [&Layout](uint32 TileIndex, EMissionLayoutSlot Type, int32 Variant)
+        {
+            FMissionLayoutSlot& Slot = Layout.Slots.AddDefaulted_GetRef();
+            Slot.X = static_cast<uint16>(TileIndex % Layout.Width);
+            Slot.Y = static_cast<uint16>(TileIndex / Layout.Width);
+            Slot.Type = Type;
+            Slot.Variant = static_cast<uint8>(FMath::Min(Variant, 255));
+        };
+
+        const int32 NumProfiles = FMath::Max(static_cast<int32>(District.EnemyProfiles.Count), 1);
+        const int32 NumHazards = FMath::Max(static_cast<int32>(District.Hazards.Count), 1);
+
+        Layout.Slots.Reserve(2 + EnemyTiles.Num() + HazardTiles.Num());
+        Layout.SlotOffsets[static_cast<int32>(EMissionLayoutSlot::PlayerStart)] = Layout.Slots.Num();
+        AddSlot(SectorSlots[StartSector].Anchor, EMissionLayoutSlot::PlayerStart, 0);
+        Layout.SlotOffsets[static_cast<int32>(EMissionLayoutSlot::Extraction)] = Layout.Slots.Num();
+        AddSlot(SectorSlots[ExtractionSector].Anchor, EMissionLayoutSlot::Extraction, 0);
+        Layout.SlotOffsets[static_cast<int32>(EMissionLayoutSlot::EnemySpawn)] = Layout.Slots.Num();
+        for (int32 Index = 0; Index < EnemyTiles.Num(); ++Index)
+        {
+            AddSlot(EnemyTiles[Index], EMissionLayoutSlot::EnemySpawn, Index % NumProfiles);
+        }
+        Layout.SlotOffsets[static_cast<int32>(EMissionLayoutSlot::Hazard)] = Layout.Slots.Num();
+        for (int32 Index = 0; Index < HazardTiles.Num(); ++Index)
+        {
+            AddSlot(HazardTiles[Index], EMissionLayoutSlot::Hazard, Index % NumHazards);
+        }
+        Layout.SlotOffsets[static_cast<int32>(EMissionLayoutSlot::Count)] = Layout.Slots.Num();
+
+        return Layout;
+    }
+}
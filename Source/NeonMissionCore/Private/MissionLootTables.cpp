@@ -0,0 +1,433 @@
+#include "MissionLootTables.h"
+
+#include "MissionCatalog.h"
+#include "MissionCatalogIndex.h"
+#include "MissionRandom.h"
+#include "Algo/StableSort.h"
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+using namespace MissionCatalogFormat;
+
+namespace
+{
+    // Requests rolled by one worker in RollBatch
+    constexpr int32 RequestsPerBatchSlice = 256;
+
+    // Separates loot streams from brief streams of the same seed
+    constexpr uint64 LootStreamSalt = 0x4C4F4F54ull << 32;
+
+    constexpr int32 MaxRollsPerTable = 64;
+
+    constexpr int32 NumOutcomes = static_cast<int32>(EMissionExtractionOutcome::Count);
+
+    const TCHAR* const OutcomeNames[NumOutcomes] = { TEXT("Failed"), TEXT("Standard"), TEXT("Premium") };
+
+    FString GetString(const TSharedPtr<FJsonObject>& Object, const TCHAR* Field)
+    {
+        FString Value;
+        Object->TryGetStringField(Field, Value);
+        return Value;
+    }
+
+    int32 GetInt(const TSharedPtr<FJsonObject>& Object, const TCHAR* Field, int32 Default)
+    {
+        int32 Value = Default;
+        Object->TryGetNumberField(Field, Value);
+        return Value;
+    }
+
+    // Calls Visitor for every object in the named array; fails if any entry is not an object.
+    template <typename VisitorType>
+    bool ForEachObject(const TSharedPtr<FJsonObject>& Root, const TCHAR* ArrayName, const FString& Context, FString& OutError, VisitorType&& Visitor)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Entries = nullptr;
+        if (!Root->TryGetArrayField(ArrayName, Entries))
+        {
+            OutError = FString::Printf(TEXT("%sMissing array '%s'"), *Context, ArrayName);
+            return false;
+        }
+
+        for (int32 Index = 0; Index < Entries->Num(); ++Index)
+        {
+            const TSharedPtr<FJsonObject>* Entry = nullptr;
+            if (!(*Entries)[Index]->TryGetObject(Entry))
+            {
+                OutError = FString::Printf(TEXT("%s%s[%d] must be an object"), *Context, ArrayName, Index);
+                return false;
+            }
+
+            if (!Visitor(*Entry, Index))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Longest nested-table chain below Table; fails on cycles. Depths is INDEX_NONE for unvisited
+    // tables and MAX_int32 while a table is on the current path.
+    bool GetNestingDepth(int32 Table, const TArray<TArray<int32>>& Children, TArray<int32>& Depths, int32& OutDepth)
+    {
+        if (Depths[Table] == MAX_int32)
+        {
+            return false;
+        }
+        if (Depths[Table] != INDEX_NONE)
+        {
+            OutDepth = Depths[Table];
+            return true;
+        }
+
+        Depths[Table] = MAX_int32;
+        int32 Depth = 0;
+        for (const int32 Child : Children[Table])
+        {
+            int32 ChildDepth = 0;
+            if (!GetNestingDepth(Child, Children, Depths, ChildDepth))
+            {
+                return false;
+            }
+            Depth = FMath::Max(Depth, ChildDepth + 1);
+        }
+
+        Depths[Table] = Depth;
+        OutDepth = Depth;
+        return true;
+    }
+}
+
+FString FMissionLootTables::GetDefaultPath()
+{
+    return FPaths::ProjectDir() / TEXT("Data/LootTables.json");
+}
+
+bool FMissionLootTables::LoadFromJson(const FString& JsonText, FString& OutError)
+{
+    TSharedPtr<FJsonObject> Root;
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+    if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+    {
+        OutError = FString::Printf(TEXT("Invalid JSON: %s"), *Reader->GetErrorMessage());
+        return false;
+    }
+
+    TArray<FString> ItemList;
+    Root->TryGetStringArrayField(TEXT("Items"), ItemList);
+    if (ItemList.Num() == 0 || ItemList.Num() > MAX_uint16)
+    {
+        OutError = TEXT("'Items' must list between 1 and 65535 item names");
+        return false;
+    }
+
+    TArray<FName> NewItemNames;
+    TMap<FString, int32> ItemIndices;
+    for (const FString& Item : ItemList)
+    {
+        if (ItemIndices.Contains(Item))
+        {
+            OutError = FString::Printf(TEXT("Item '%s' is listed twice"), *Item);
+            return false;
+        }
+        ItemIndices.Add(Item, NewItemNames.Add(FName(*Item)));
+    }
+
+    // Names first, so entries can reference tables defined later in the file
+    TMap<FString, int32> TableIndices;
+    bool bOk = ForEachObject(Root, TEXT("Tables"), FString(), OutError, [&](const TSharedPtr<FJsonObject>& Entry, int32 Index)
+    {
+        const FString Name = GetString(Entry, TEXT("Name"));
+        if (Name.IsEmpty() || TableIndices.Contains(Name))
+        {
+            OutError = FString::Printf(TEXT("Tables[%d] needs a unique non-empty 'Name'"), Index);
+            return false;
+        }
+        TableIndices.Add(Name, Index);
+        return true;
+    });
+
+    TArray<FTable> NewTables;
+    TArray<TArray<int32>> Children;
+    NewTables.SetNum(TableIndices.Num());
+    Children.SetNum(TableIndices.Num());
+
+    bOk = bOk && ForEachObject(Root, TEXT("Tables"), FString(), OutError, [&](const TSharedPtr<FJsonObject>& TableObject, int32 TableIndex)
+    {
+        const FString TableName = GetString(TableObject, TEXT("Name"));
+        FTable& Table = NewTables[TableIndex];
+        Table.Rolls = GetInt(TableObject, TEXT("Rolls"), 1);
+        if (Table.Rolls < 1 || Table.Rolls > MaxRollsPerTable)
+        {
+            OutError = FString::Printf(TEXT("Table '%s': 'Rolls' must be between 1 and %d"), *TableName, MaxRollsPerTable);
+            return false;
+        }
+
+        TArray<uint16> Outcomes;
+        TArray<float> Weights;
+        const bool bEntriesOk = ForEachObject(TableObject, TEXT("Entries"), FString::Printf(TEXT("Table '%s': "), *TableName), OutError,
+            [&](const TSharedPtr<FJsonObject>& EntryObject, int32 EntryIndex)
+        {
+            const FString ItemName = GetString(EntryObject, TEXT("Item"));
+            const FString NestedName = GetString(EntryObject, TEXT("Table"));
+
+            FEntry& Entry = Table.Entries.AddDefaulted_GetRef();
+            if (!ItemName.IsEmpty() && !NestedName.IsEmpty())
+            {
+                OutError = FString::Printf(TEXT("Table '%s': entry %d sets both 'Item' and 'Table'"), *TableName, EntryIndex);
+                return false;
+            }
+            if (!ItemName.IsEmpty())
+            {
+                const int32* Item = ItemIndices.Find(ItemName);
+                if (!Item)
+                {
+                    OutError = FString::Printf(TEXT("Table '%s' references unknown item '%s'"), *TableName, *ItemName);
+                    return false;
+                }
+                Entry.Item = *Item;
+            }
+            if (!NestedName.IsEmpty())
+            {
+                const int32* Nested = TableIndices.Find(NestedName);
+                if (!Nested)
+                {
+                    OutError = FString::Printf(TEXT("Table '%s' references unknown table '%s'"), *TableName, *NestedName);
+                    return false;
+                }
+                Entry.Table = *Nested;
+                Children[TableIndex].AddUnique(*Nested);
+            }
+
+            const int32 MinQuantity = GetInt(EntryObject, TEXT("Min"), 1);
+            const int32 MaxQuantity = GetInt(EntryObject, TEXT("Max"), MinQuantity);
+            if (MinQuantity < 1 || MaxQuantity < MinQuantity || MaxQuantity > MAX_uint16)
+            {
+                OutError = FString::Printf(TEXT("Table '%s': entry %d needs 1 <= Min <= Max <= 65535"), *TableName, EntryIndex);
+                return false;
+            }
+            Entry.MinQuantity = static_cast<uint16>(MinQuantity);
+            Entry.MaxQuantity = static_cast<uint16>(MaxQuantity);
+
+            double Weight = 1.0;
+            EntryObject->TryGetNumberField(TEXT("Weight"), Weight);
+            Outcomes.Add(static_cast<uint16>(EntryIndex));
+            Weights.Add(static_cast<float>(Weight));
+            return true;
+        });
+
+        if (!bEntriesOk)
+        {
+            return false;
+        }
+        if (Outcomes.Num() > MAX_uint16)
+        {
+            OutError = FString::Printf(TEXT("Table '%s' has more than 65535 entries"), *TableName);
+            return false;
+        }
+
+        Table.Picks.Build(Outcomes, Weights);
+        if (Table.Picks.IsEmpty())
+        {
+            OutError = FString::Printf(TEXT("Table '%s' has no entry with a positive weight"), *TableName);
+            return false;
+        }
+        return true;
+    });
+
+    if (!bOk)
+    {
+        return false;
+    }
+
+    TArray<int32> Depths;
+    Depths.Init(INDEX_NONE, NewTables.Num());
+    for (const TPair<FString, int32>& Table : TableIndices)
+    {
+        int32 Depth = 0;
+        if (!GetNestingDepth(Table.Value, Children, Depths, Depth))
+        {
+            OutError = FString::Printf(TEXT("Table '%s' nests itself"), *Table.Key);
+            return false;
+        }
+        if (Depth > MaxNestingDepth)
+        {
+            OutError = FString::Printf(TEXT("Table '%s' nests %d levels deep (at most %d)"), *Table.Key, Depth, MaxNestingDepth);
+            return false;
+        }
+    }
+
+    // Reward rules, applied from least to most specific so the most specific rule wins
+    struct FRule
+    {
+        int32 Outcome;
+        int32 Faction;
+        int32 District;
+        int32 Table;
+        int32 Specificity;
+    };
+
+    const FMissionCatalog& Catalog = FMissionCatalog::Get();
+    const FMissionCatalogIndex& CatalogIndex = FMissionCatalogIndex::Get();
+    const int32 NewNumFactions = Catalog.Num(ESection::Factions);
+    const int32 NewNumDistricts = Catalog.Num(ESection::Districts);
+
+    TArray<FRule> Rules;
+    bOk = ForEachObject(Root, TEXT("Rewards"), FString(), OutError, [&](const TSharedPtr<FJsonObject>& Entry, int32 Index)
+    {
+        FRule& Rule = Rules.AddDefaulted_GetRef();
+
+        const FString OutcomeName = GetString(Entry, TEXT("Outcome"));
+        Rule.Outcome = INDEX_NONE;
+        for (int32 Outcome = 0; Outcome < NumOutcomes; ++Outcome)
+        {
+            if (OutcomeName == OutcomeNames[Outcome])
+            {
+                Rule.Outcome = Outcome;
+            }
+        }
+        if (Rule.Outcome == INDEX_NONE)
+        {
+            OutError = FString::Printf(TEXT("Rewards[%d]: 'Outcome' must be Failed, Standard or Premium"), Index);
+            return false;
+        }
+
+        const int32* Table = TableIndices.Find(GetString(Entry, TEXT("Table")));
+        if (!Table)
+        {
+            OutError = FString::Printf(TEXT("Rewards[%d] references unknown table '%s'"), Index, *GetString(Entry, TEXT("Table")));
+            return false;
+        }
+        Rule.Table = *Table;
+
+        const FString FactionName = GetString(Entry, TEXT("Faction"));
+        const FString DistrictName = GetString(Entry, TEXT("District"));
+        Rule.Faction = FactionName.IsEmpty() ? INDEX_NONE : CatalogIndex.FindFaction(FName(*FactionName));
+        Rule.District = DistrictName.IsEmpty() ? INDEX_NONE : CatalogIndex.FindDistrict(FName(*DistrictName));
+        if ((!FactionName.IsEmpty() && Rule.Faction == INDEX_NONE) || (!DistrictName.IsEmpty() && Rule.District == INDEX_NONE))
+        {
+            OutError = FString::Printf(TEXT("Rewards[%d] references an unknown faction or district"), Index);
+            return false;
+        }
+
+        Rule.Specificity = (Rule.Faction != INDEX_NONE ? 2 : 0) + (Rule.District != INDEX_NONE ? 1 : 0);
+        return true;
+    });
+
+    if (!bOk)
+    {
+        return false;
+    }
+
+    Algo::StableSortBy(Rules, &FRule::Specificity);
+
+    TArray<int32> NewRewardTables;
+    NewRewardTables.Init(INDEX_NONE, NumOutcomes * NewNumFactions * NewNumDistricts);
+    for (const FRule& Rule : Rules)
+    {
+        for (int32 Faction = 0; Faction < NewNumFactions; ++Faction)
+        {
+            for (int32 District = 0; District < NewNumDistricts; ++District)
+            {
+                if ((Rule.Faction == INDEX_NONE || Rule.Faction == Faction) && (Rule.District == INDEX_NONE || Rule.District == District))
+                {
+                    NewRewardTables[(Rule.Outcome * NewNumFactions + Faction) * NewNumDistricts + District] = Rule.Table;
+                }
+            }
+        }
+    }
+
+    ItemNames = MoveTemp(NewItemNames);
+    Tables = MoveTemp(NewTables);
+    RewardTables = MoveTemp(NewRewardTables);
+    NumFactions = NewNumFactions;
+    NumDistricts = NewNumDistricts;
+    return true;
+}
+
+int32 FMissionLootTables::FindRewardTable(const FMissionLootRequest& Request) const
+{
+    const int32 Outcome = static_cast<int32>(Request.Outcome);
+    if (Outcome >= NumOutcomes || Request.Faction >= NumFactions || Request.District >= NumDistricts)
+    {
+        return INDEX_NONE;
+    }
+
+    return RewardTables[(Outcome * NumFactions + Request.Faction) * NumDistricts + Request.District];
+}
+
+template <typename RandomType>
+void FMissionLootTables::RollTable(int32 TableIndex, int32 Depth, RandomType& Random, TArray<FMissionLootDrop>& OutDrops) const
+{
+    const FTable& Table = Tables[TableIndex];
+    for (int32 Pick = 0; Pick < Table.Rolls; ++Pick)
+    {
+        const FEntry& Entry = Table.Entries[Table.Picks.Sample(Random)];
+        if (Entry.Table != INDEX_NONE)
+        {
+            // Load rejects deeper chains; the check only guards against a corrupt table set
+            if (Depth < MaxNestingDepth)
+            {
+                RollTable(Entry.Table, Depth + 1, Random, OutDrops);
+            }
+        }
+        else if (Entry.Item != INDEX_NONE)
+        {
+            FMissionLootDrop& Drop = OutDrops.AddDefaulted_GetRef();
+            Drop.Item = static_cast<uint16>(Entry.Item);
+            Drop.Quantity = static_cast<uint16>(Random.RandRange(Entry.MinQuantity, Entry.MaxQuantity));
+        }
+    }
+}
+
+void FMissionLootTables::Roll(int32 Seed, const FMissionLootRequest& Request, TArray<FMissionLootDrop>& OutDrops) const
+{
+    const int32 Table = FindRewardTable(Request);
+    if (Table == INDEX_NONE)
+    {
+        return;
+    }
+
+    FMissionCounterRandom Random(Seed, FMissionCounterRandom::Mix(Request.RollIndex ^ LootStreamSalt));
+    RollTable(Table, 0, Random, OutDrops);
+}
+
+void FMissionLootTables::RollBatch(int32 Seed, TConstArrayView<FMissionLootRequest> Requests, TArray<FMissionLootDrop>& OutDrops, TArray<int32>& OutOffsets) const
+{
+    OutDrops.Reset();
+    OutOffsets.SetNumUninitialized(Requests.Num() + 1);
+    OutOffsets[0] = 0;
+
+    // Each slice rolls into its own array and records per-request drop counts; the slices are
+    // concatenated afterwards, so the output does not depend on how the work was split
+    const int32 NumSlices = FMath::DivideAndRoundUp(Requests.Num(), RequestsPerBatchSlice);
+    TArray<TArray<FMissionLootDrop>> SliceDrops;
+    SliceDrops.SetNum(NumSlices);
+
+    ParallelFor(TEXT("FMissionLootTables::RollBatch"), NumSlices, 1, [this, Seed, Requests, &SliceDrops, &OutOffsets](int32 Slice)
+    {
+        const int32 First = Slice * RequestsPerBatchSlice;
+        const int32 Last = FMath::Min(First + RequestsPerBatchSlice, Requests.Num());
+        TArray<FMissionLootDrop>& Drops = SliceDrops[Slice];
+        for (int32 Index = First; Index < Last; ++Index)
+        {
+            const int32 Before = Drops.Num();
+            Roll(Seed, Requests[Index], Drops);
+            OutOffsets[Index + 1] = Drops.Num() - Before;
+        }
+    });
+
+    for (int32 Index = 0; Index < Requests.Num(); ++Index)
+    {
+        OutOffsets[Index + 1] += OutOffsets[Index];
+    }
+
+    OutDrops.Reserve(OutOffsets.Last());
+    for (const TArray<FMissionLootDrop>& Drops : SliceDrops)
+    {
+        OutDrops.Append(Drops);
+    }
+}
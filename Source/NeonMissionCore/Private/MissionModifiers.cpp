@@ -0,0 +1,234 @@
+#include "MissionModifiers.h"
+
+#include "MissionCatalog.h"
+
+using namespace MissionCatalogFormat;
+
+namespace
+{
+    struct FStatPhrase
+    {
+        const TCHAR* Phrase;
+        EMissionStat Stat;
+    };
+
+    // Lower case; longer phrases first so "critical damage" wins over "damage"
+    const FStatPhrase StatPhrases[] = {
+        { TEXT("movement speed"), EMissionStat::MovementSpeed },
+        { TEXT("move speed"), EMissionStat::MovementSpeed },
+        { TEXT("critical damage"), EMissionStat::CriticalDamage },
+        { TEXT("weapon damage"), EMissionStat::WeaponDamage },
+        { TEXT("damage"), EMissionStat::WeaponDamage },
+        { TEXT("hack success"), EMissionStat::HackSuccess },
+        { TEXT("evasion"), EMissionStat::Evasion }
+    };
+
+    // Effects that only apply in some situations are left to gameplay code
+    const TCHAR* const ConditionalWords[] = { TEXT(" when "), TEXT(" while "), TEXT(" after "), TEXT("stacking") };
+
+    // Magnitude of "Increases ..." / "Reduces ..." effects that name no number
+    constexpr float DefaultEffectMagnitude = 0.1f;
+
+    constexpr int32 NumStats = static_cast<int32>(EMissionStat::Count);
+}
+
+TUniquePtr<FMissionImplantModifiers>& FMissionImplantModifiers::GetStorage()
+{
+    static TUniquePtr<FMissionImplantModifiers> Compiled(new FMissionImplantModifiers());
+    return Compiled;
+}
+
+const FMissionImplantModifiers& FMissionImplantModifiers::Get()
+{
+    return *GetStorage();
+}
+
+void FMissionImplantModifiers::Rebuild()
+{
+    GetStorage().Reset(new FMissionImplantModifiers());
+}
+
+FMissionImplantModifiers::FMissionImplantModifiers()
+{
+    const FMissionCatalog& Catalog = FMissionCatalog::Get();
+    const int32 NumImplants = Catalog.Num(ESection::Implants);
+
+    ImplantOffsets.Reserve(NumImplants + 1);
+    ImplantOffsets.Add(0);
+    for (int32 Implant = 0; Implant < NumImplants; ++Implant)
+    {
+        for (const uint32 EffectOffset : Catalog.GetList(Catalog.GetImplant(Implant).Effects))
+        {
+            const FString Effect = UTF8_TO_TCHAR(Catalog.GetString(EffectOffset));
+            FMissionModifier Modifier;
+            if (CompileEffect(Effect, Modifier))
+            {
+                Modifiers.Add(Modifier);
+            }
+            else
+            {
+                UE_LOG(LogTemp, Verbose, TEXT("FMissionImplantModifiers - '%s' is not a stat modifier"), *Effect);
+            }
+        }
+        ImplantOffsets.Add(Modifiers.Num());
+    }
+}
+
+TConstArrayView<FMissionModifier> FMissionImplantModifiers::GetModifiers(int32 Implant) const
+{
+    if (Implant < 0 || Implant + 1 >= ImplantOffsets.Num())
+    {
+        return TConstArrayView<FMissionModifier>();
+    }
+
+    return TConstArrayView<FMissionModifier>(Modifiers.GetData() + ImplantOffsets[Implant], ImplantOffsets[Implant + 1] - ImplantOffsets[Implant]);
+}
+
+bool FMissionImplantModifiers::CompileEffect(const FString& Effect, FMissionModifier& OutModifier)
+{
+    const FString Text = Effect.TrimStartAndEnd().ToLower();
+
+    for (const TCHAR* Word : ConditionalWords)
+    {
+        if (Text.Contains(Word))
+        {
+            return false;
+        }
+    }
+
+    const FStatPhrase* Phrase = nullptr;
+    for (const FStatPhrase& Candidate : StatPhrases)
+    {
+        if (Text.Contains(Candidate.Phrase))
+        {
+            Phrase = &Candidate;
+            break;
+        }
+    }
+    if (!Phrase)
+    {
+        return false;
+    }
+
+    // "+15%", "-10", "x1.5"
+    int32 Position = 0;
+    float Sign = 1.0f;
+    bool bMultiply = false;
+    if (Text.Len() > 0 && (Text[0] == TEXT('+') || Text[0] == TEXT('-')))
+    {
+        Sign = Text[0] == TEXT('-') ? -1.0f : 1.0f;
+        ++Position;
+    }
+    else if (Text.Len() > 0 && Text[0] == TEXT('x'))
+    {
+        bMultiply = true;
+        ++Position;
+    }
+
+    const int32 NumberStart = Position;
+    while (Position < Text.Len() && (FChar::IsDigit(Text[Position]) || Text[Position] == TEXT('.')))
+    {
+        ++Position;
+    }
+
+    OutModifier.Stat = Phrase->Stat;
+    if (Position > NumberStart)
+    {
+        const float Number = FCString::Atof(*Text.Mid(NumberStart, Position - NumberStart));
+        const bool bPercent = Position < Text.Len() && Text[Position] == TEXT('%');
+        OutModifier.Op = bMultiply ? EMissionModifierOp::Multiply : (bPercent ? EMissionModifierOp::AddPercent : EMissionModifierOp::AddFlat);
+        OutModifier.Value = bMultiply ? Number : Sign * (bPercent ? Number / 100.0f : Number);
+        return true;
+    }
+
+    if (bMultiply || Sign < 0.0f)
+    {
+        return false;
+    }
+    if (Text.StartsWith(TEXT("increases")) || Text.StartsWith(TEXT("boosts")))
+    {
+        OutModifier.Op = EMissionModifierOp::AddPercent;
+        OutModifier.Value = DefaultEffectMagnitude;
+        return true;
+    }
+    if (Text.StartsWith(TEXT("reduces")) || Text.StartsWith(TEXT("decreases")))
+    {
+        OutModifier.Op = EMissionModifierOp::AddPercent;
+        OutModifier.Value = -DefaultEffectMagnitude;
+        return true;
+    }
+
+    return false;
+}
+
+void FMissionStatCache::SetSource(FName Source, TConstArrayView<FMissionModifier> SourceModifiers)
+{
+    FSource* Existing = Sources.FindByPredicate([Source](const FSource& Candidate) { return Candidate.Name == Source; });
+    if (!Existing)
+    {
+        Existing = &Sources.AddDefaulted_GetRef();
+        Existing->Name = Source;
+    }
+
+    Existing->Modifiers = SourceModifiers;
+    bDirty = true;
+    ++Revision;
+}
+
+void FMissionStatCache::RemoveSource(FName Source)
+{
+    if (Sources.RemoveAll([Source](const FSource& Candidate) { return Candidate.Name == Source; }) > 0)
+    {
+        bDirty = true;
+        ++Revision;
+    }
+}
+
+void FMissionStatCache::Reset()
+{
+    Sources.Reset();
+    bDirty = true;
+    ++Revision;
+}
+
+bool FMissionStatCache::HasSource(FName Source) const
+{
+    return Sources.ContainsByPredicate([Source](const FSource& Candidate) { return Candidate.Name == Source; });
+}
+
+void FMissionStatCache::Recompute() const
+{
+    float Percentages[NumStats] = {};
+    float Products[NumStats];
+    for (int32 Stat = 0; Stat < NumStats; ++Stat)
+    {
+        Products[Stat] = 1.0f;
+        FlatBonuses[Stat] = 0.0f;
+    }
+
+    for (const FSource& Source : Sources)
+    {
+        for (const FMissionModifier& Modifier : Source.Modifiers)
+        {
+            const int32 Stat = static_cast<int32>(Modifier.Stat);
+            switch (Modifier.Op)
+            {
+            case EMissionModifierOp::AddPercent:
+                Percentages[Stat] += Modifier.Value;
+                break;
+            case EMissionModifierOp::Multiply:
+                Products[Stat] *= Modifier.Value;
+                break;
+            default:
+                FlatBonuses[Stat] += Modifier.Value;
+                break;
+            }
+        }
+    }
+
+    for (int32 Stat = 0; Stat < NumStats; ++Stat)
+    {
+        Multipliers[Stat] = FMath::Max(0.0f, 1.0f + Percentages[Stat]) * Products[Stat];
+    }
+    bDirty = false;
+}
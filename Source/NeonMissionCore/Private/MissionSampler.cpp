@@ -0,0 +1,258 @@
+#include "MissionSampler.h"
+
+#include "MissionCatalog.h"
+#include "MissionCatalogIndex.h"
+
+using namespace MissionCatalogFormat;
+
+namespace
+{
+    // Bitset of the named entries; an empty name list selects every entry.
+    TBitArray<> MakeNameMask(const FMissionCatalog& Catalog, const FRange& Names, int32 NumEntries,
+        int32 (FMissionCatalogIndex::*Find)(FName) const, const ANSICHAR* Context)
+    {
+        const TConstArrayView<uint32> NameOffsets = Catalog.GetList(Names);
+        TBitArray<> Mask(NameOffsets.Num() == 0, NumEntries);
+
+        const FMissionCatalogIndex& CatalogIndex = FMissionCatalogIndex::Get();
+        for (const uint32 NameOffset : NameOffsets)
+        {
+            const FName Name(UTF8_TO_TCHAR(Catalog.GetString(NameOffset)));
+            const int32 Index = (CatalogIndex.*Find)(Name);
+            if (Index == INDEX_NONE)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("FMissionSampler - %s references unknown entry '%s'"), UTF8_TO_TCHAR(Context), *Name.ToString());
+                continue;
+            }
+
+            Mask[Index] = true;
+        }
+
+        return Mask;
+    }
+
+    // Builds an alias table over the set bits of Mask using per-entry weights.
+    void BuildMaskedTable(FMissionAliasTable& Table, const TBitArray<>& Mask, const TArray<float>& EntryWeights)
+    {
+        TArray<uint16> Outcomes;
+        TArray<float> Weights;
+        for (TConstSetBitIterator<> It(Mask); It; ++It)
+        {
+            Outcomes.Add(static_cast<uint16>(It.GetIndex()));
+            Weights.Add(EntryWeights[It.GetIndex()]);
+        }
+
+        Table.Build(Outcomes, Weights);
+    }
+}
+
+void FMissionAliasTable::Build(TConstArrayView<uint16> InOutcomes, TConstArrayView<float> Weights)
+{
+    check(InOutcomes.Num() == Weights.Num());
+
+    Outcomes.Reset();
+    AliasOutcomes.Reset();
+    Thresholds.Reset();
+    OutcomeProbabilities.Reset();
+
+    double TotalWeight = 0.0;
+    for (int32 Index = 0; Index < InOutcomes.Num(); ++Index)
+    {
+        if (Weights[Index] > 0.0f)
+        {
+            Outcomes.Add(InOutcomes[Index]);
+            OutcomeProbabilities.Add(Weights[Index]);
+            TotalWeight += Weights[Index];
+        }
+    }
+
+    const int32 Count = Outcomes.Num();
+    if (Count == 0)
+    {
+        return;
+    }
+
+    AliasOutcomes.SetNumUninitialized(Count);
+    Thresholds.SetNumUninitialized(Count);
+
+    // Scale so the average column holds exactly 1.0, then pair under-full with over-full columns
+    TArray<double> Scaled;
+    Scaled.SetNumUninitialized(Count);
+    TArray<int32> Small;
+    TArray<int32> Large;
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        OutcomeProbabilities[Index] = static_cast<float>(OutcomeProbabilities[Index] / TotalWeight);
+        Scaled[Index] = OutcomeProbabilities[Index] * Count;
+        (Scaled[Index] < 1.0 ? Small : Large).Add(Index);
+    }
+
+    while (Small.Num() > 0 && Large.Num() > 0)
+    {
+        const int32 Under = Small.Pop(EAllowShrinking::No);
+        const int32 Over = Large.Pop(EAllowShrinking::No);
+
+        Thresholds[Under] = static_cast<float>(Scaled[Under]);
+        AliasOutcomes[Under] = Outcomes[Over];
+
+        Scaled[Over] = (Scaled[Over] + Scaled[Under]) - 1.0;
+        (Scaled[Over] < 1.0 ? Small : Large).Add(Over);
+    }
+
+    // Leftovers are full columns up to rounding error
+    for (const int32 Index : Large)
+    {
+        Thresholds[Index] = 1.0f;
+        AliasOutcomes[Index] = Outcomes[Index];
+    }
+    for (const int32 Index : Small)
+    {
+        Thresholds[Index] = 1.0f;
+        AliasOutcomes[Index] = Outcomes[Index];
+    }
+}
+
+float FMissionAliasTable::GetOutcomeProbability(uint16 Outcome) const
+{
+    const int32 Index = Outcomes.IndexOfByKey(Outcome);
+    return Index == INDEX_NONE ? 0.0f : OutcomeProbabilities[Index];
+}
+
+TUniquePtr<FMissionSampler>& FMissionSampler::GetStorage()
+{
+    static TUniquePtr<FMissionSampler> Sampler(new FMissionSampler());
+    return Sampler;
+}
+
+const FMissionSampler& FMissionSampler::Get()
+{
+    return *GetStorage();
+}
+
+void FMissionSampler::Rebuild()
+{
+    GetStorage().Reset(new FMissionSampler());
+}
+
+FMissionSampler::FMissionSampler()
+{
+    const FMissionCatalog& Catalog = FMissionCatalog::Get();
+
+    NumDistricts = Catalog.Num(ESection::Districts);
+    NumFactions = Catalog.Num(ESection::Factions);
+    const int32 NumComplications = Catalog.Num(ESection::Complications);
+
+    TArray<float> DistrictWeights;
+    for (int32 DistrictIndex = 0; DistrictIndex < NumDistricts; ++DistrictIndex)
+    {
+        DistrictWeights.Add(Catalog.GetDistrict(DistrictIndex).Weight);
+    }
+
+    // Entry -> allowed districts / factions, as declared in the catalog
+    TArray<float> FactionWeights;
+    TArray<TBitArray<>> FactionDistricts;
+    for (int32 FactionIndex = 0; FactionIndex < NumFactions; ++FactionIndex)
+    {
+        const FFactionRecord& Faction = Catalog.GetFaction(FactionIndex);
+        FactionWeights.Add(Faction.Weight);
+        FactionDistricts.Add(MakeNameMask(Catalog, Faction.OperatingDistricts, NumDistricts, &FMissionCatalogIndex::FindDistrict, Catalog.GetString(Faction.Name)));
+    }
+
+    // Transposed to district -> complications and faction -> complications for the intersections below
+    TArray<TBitArray<>> DistrictComplications;
+    DistrictComplications.Init(TBitArray<>(false, NumComplications), NumDistricts);
+    TArray<TBitArray<>> FactionComplications;
+    FactionComplications.Init(TBitArray<>(false, NumComplications), NumFactions);
+
+    TArray<float> ComplicationWeights;
+    for (int32 ComplicationIndex = 0; ComplicationIndex < NumComplications; ++ComplicationIndex)
+    {
+        const FComplicationRecord& Complication = Catalog.GetComplication(ComplicationIndex);
+        const ANSICHAR* Context = Catalog.GetString(Complication.Description);
+        const TBitArray<> DistrictMask = MakeNameMask(Catalog, Complication.Districts, NumDistricts, &FMissionCatalogIndex::FindDistrict, Context);
+        const TBitArray<> FactionMask = MakeNameMask(Catalog, Complication.Factions, NumFactions, &FMissionCatalogIndex::FindFaction, Context);
+        ComplicationWeights.Add(Complication.Weight);
+
+        for (TConstSetBitIterator<> It(DistrictMask); It; ++It)
+        {
+            DistrictComplications[It.GetIndex()][ComplicationIndex] = true;
+        }
+        for (TConstSetBitIterator<> It(FactionMask); It; ++It)
+        {
+            FactionComplications[It.GetIndex()][ComplicationIndex] = true;
+        }
+    }
+
+    CompatibleFactions.Init(TBitArray<>(false, NumFactions), NumDistricts);
+    CompatibleComplications.SetNum(NumDistricts * NumFactions);
+    ComplicationTables.SetNum(NumDistricts * NumFactions);
+    FactionTables.SetNum(NumDistricts);
+
+    TArray<uint16> DistrictOutcomes;
+    TArray<float> CompatibleDistrictWeights;
+
+    for (int32 DistrictIndex = 0; DistrictIndex < NumDistricts; ++DistrictIndex)
+    {
+        for (int32 FactionIndex = 0; FactionIndex < NumFactions; ++FactionIndex)
+        {
+            const int32 PairIndex = DistrictIndex * NumFactions + FactionIndex;
+
+            if (FactionDistricts[FactionIndex][DistrictIndex])
+            {
+                CompatibleComplications[PairIndex] = TBitArray<>::BitwiseAND(
+                    DistrictComplications[DistrictIndex], FactionComplications[FactionIndex], EBitwiseOperatorFlags::MinSize);
+            }
+            else
+            {
+                CompatibleComplications[PairIndex] = TBitArray<>(false, NumComplications);
+            }
+
+            BuildMaskedTable(ComplicationTables[PairIndex], CompatibleComplications[PairIndex], ComplicationWeights);
+
+            // A faction only counts as present if it leaves at least one complication to roll
+            CompatibleFactions[DistrictIndex][FactionIndex] = !ComplicationTables[PairIndex].IsEmpty();
+        }
+
+        BuildMaskedTable(FactionTables[DistrictIndex], CompatibleFactions[DistrictIndex], FactionWeights);
+
+        if (FactionTables[DistrictIndex].IsEmpty())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("FMissionSampler - District '%s' has no compatible faction/complication and will never be rolled"),
+                UTF8_TO_TCHAR(Catalog.GetString(Catalog.GetDistrict(DistrictIndex).Name)));
+            continue;
+        }
+
+        DistrictOutcomes.Add(static_cast<uint16>(DistrictIndex));
+        CompatibleDistrictWeights.Add(DistrictWeights[DistrictIndex]);
+    }
+
+    DistrictTable.Build(DistrictOutcomes, CompatibleDistrictWeights);
+
+    if (DistrictTable.IsEmpty())
+    {
+        UE_LOG(LogTemp, Error, TEXT("FMissionSampler - Mission catalog has no compatible district/faction/complication combination"));
+    }
+}
+
+bool FMissionSampler::IsCompatible(int32 District, int32 Faction, int32 Complication) const
+{
+    if (District < 0 || District >= NumDistricts || Faction < 0 || Faction >= NumFactions)
+    {
+        return false;
+    }
+
+    const TBitArray<>& Mask = CompatibleComplications[District * NumFactions + Faction];
+    return Mask.IsValidIndex(Complication) && Mask[Complication];
+}
+
+double FMissionSampler::GetTripleProbability(int32 District, int32 Faction, int32 Complication) const
+{
+    if (!IsCompatible(District, Faction, Complication))
+    {
+        return 0.0;
+    }
+
+    return static_cast<double>(DistrictTable.GetOutcomeProbability(static_cast<uint16>(District)))
+        * FactionTables[District].GetOutcomeProbability(static_cast<uint16>(Faction))
+        * ComplicationTables[District * NumFactions + Faction].GetOutcomeProbability(static_cast<uint16>(Complication));
+}
@@ -0,0 +1,217 @@
+#include "MissionSpace.h"
+
+#include "MissionCatalog.h"
+#include "MissionRandom.h"
+#include "MissionSampler.h"
+
+namespace
+{
+    constexpr int32 FeistelRounds = 4;
+
+    // District/faction/complication triple allowed by the catalog's compatibility rules
+    struct FMissionSpaceTriple
+    {
+        uint16 District = 0;
+        uint16 Faction = 0;
+        uint16 Complication = 0;
+    };
+
+    uint64 MakeTripleKey(int32 District, int32 Faction, int32 Complication)
+    {
+        return (static_cast<uint64>(District) << 32) | (static_cast<uint64>(Faction) << 16) | static_cast<uint64>(Complication);
+    }
+
+    struct FMissionSpaceLayout
+    {
+        int64 NumTriples = 0;
+        int64 NumArchetypeAbilities = 0;
+        int64 NumWeapons = 0;
+        int64 NumImplants = 0;
+        int64 NumExtractionConditions = 0;
+        int64 Total = 0;
+
+        // Compatible triples ordered by district, faction, complication
+        TArray<FMissionSpaceTriple> Triples;
+        TMap<uint64, int32> TripleIndices;
+
+        // Flattened archetype/ability digit -> (archetype, ability within archetype)
+        TArray<TPair<uint16, uint16>> ArchetypeAbilities;
+
+        // Archetype -> first flattened digit of its abilities
+        TArray<int32> ArchetypeAbilityOffsets;
+    };
+
+    FMissionSpaceLayout BuildLayout()
+    {
+        FMissionSpaceLayout Layout;
+
+        const FMissionCatalog& Catalog = FMissionCatalog::Get();
+        const int32 NumArchetypes = Catalog.Num(MissionCatalogFormat::ESection::Archetypes);
+        Layout.ArchetypeAbilityOffsets.Reserve(NumArchetypes);
+        for (int32 ArchetypeIndex = 0; ArchetypeIndex < NumArchetypes; ++ArchetypeIndex)
+        {
+            Layout.ArchetypeAbilityOffsets.Add(Layout.ArchetypeAbilities.Num());
+            const int32 NumAbilities = Catalog.GetList(Catalog.GetArchetype(ArchetypeIndex).Abilities).Num();
+            for (int32 AbilityIndex = 0; AbilityIndex < NumAbilities; ++AbilityIndex)
+            {
+                Layout.ArchetypeAbilities.Emplace(static_cast<uint16>(ArchetypeIndex), static_cast<uint16>(AbilityIndex));
+            }
+        }
+
+        const FMissionSampler& Sampler = FMissionSampler::Get();
+        const int32 NumDistricts = Catalog.Num(MissionCatalogFormat::ESection::Districts);
+        for (int32 DistrictIndex = 0; DistrictIndex < NumDistricts; ++DistrictIndex)
+        {
+            for (TConstSetBitIterator<> FactionIt(Sampler.GetCompatibleFactions(DistrictIndex)); FactionIt; ++FactionIt)
+            {
+                for (TConstSetBitIterator<> ComplicationIt(Sampler.GetCompatibleComplications(DistrictIndex, FactionIt.GetIndex())); ComplicationIt; ++ComplicationIt)
+                {
+                    Layout.TripleIndices.Add(MakeTripleKey(DistrictIndex, FactionIt.GetIndex(), ComplicationIt.GetIndex()), Layout.Triples.Num());
+
+                    FMissionSpaceTriple& Triple = Layout.Triples.AddDefaulted_GetRef();
+                    Triple.District = static_cast<uint16>(DistrictIndex);
+                    Triple.Faction = static_cast<uint16>(FactionIt.GetIndex());
+                    Triple.Complication = static_cast<uint16>(ComplicationIt.GetIndex());
+                }
+            }
+        }
+
+        Layout.NumTriples = Layout.Triples.Num();
+        Layout.NumArchetypeAbilities = Layout.ArchetypeAbilities.Num();
+        Layout.NumWeapons = Catalog.Num(MissionCatalogFormat::ESection::Weapons);
+        Layout.NumImplants = Catalog.Num(MissionCatalogFormat::ESection::Implants);
+        Layout.NumExtractionConditions = Catalog.Num(MissionCatalogFormat::ESection::ExtractionConditions);
+
+        Layout.Total = Layout.NumTriples * Layout.NumArchetypeAbilities
+            * Layout.NumWeapons * Layout.NumImplants * Layout.NumExtractionConditions;
+
+        return Layout;
+    }
+
+    FMissionSpaceLayout& GetMutableLayout()
+    {
+        static FMissionSpaceLayout Layout = BuildLayout();
+        return Layout;
+    }
+
+    const FMissionSpaceLayout& GetLayout()
+    {
+        return GetMutableLayout();
+    }
+
+    uint64 FeistelEncrypt(uint64 Value, uint64 Key, uint32 HalfBits)
+    {
+        const uint64 HalfMask = (uint64(1) << HalfBits) - 1;
+        uint64 Left = Value >> HalfBits;
+        uint64 Right = Value & HalfMask;
+
+        for (int32 Round = 0; Round < FeistelRounds; ++Round)
+        {
+            const uint64 RoundValue = FMissionCounterRandom::Mix(Right ^ FMissionCounterRandom::Mix(Key + Round)) & HalfMask;
+            const uint64 NewRight = Left ^ RoundValue;
+            Left = Right;
+            Right = NewRight;
+        }
+
+        return (Left << HalfBits) | Right;
+    }
+}
+
+namespace MissionSpace
+{
+    int64 GetTotalCombinations()
+    {
+        return GetLayout().Total;
+    }
+
+    FMissionBriefHandle UnrankBrief(int64 Rank)
+    {
+        const FMissionSpaceLayout& Layout = GetLayout();
+        checkf(Rank >= 0 && Rank < Layout.Total, TEXT("Mission rank %lld outside [0, %lld)"), Rank, Layout.Total);
+
+        int64 Remaining = Rank;
+        auto TakeDigit = [&Remaining](int64 Radix)
+        {
+            const int64 Digit = Remaining % Radix;
+            Remaining /= Radix;
+            return Digit;
+        };
+
+        FMissionBriefHandle Handle;
+        Handle.ExtractionIndex = static_cast<uint16>(TakeDigit(Layout.NumExtractionConditions));
+        Handle.ImplantIndex = static_cast<uint16>(TakeDigit(Layout.NumImplants));
+        Handle.WeaponIndex = static_cast<uint16>(TakeDigit(Layout.NumWeapons));
+
+        const TPair<uint16, uint16>& ArchetypeAbility = Layout.ArchetypeAbilities[TakeDigit(Layout.NumArchetypeAbilities)];
+        Handle.ArchetypeIndex = ArchetypeAbility.Key;
+        Handle.AbilityIndex = ArchetypeAbility.Value;
+
+        const FMissionSpaceTriple& Triple = Layout.Triples[TakeDigit(Layout.NumTriples)];
+        Handle.DistrictIndex = Triple.District;
+        Handle.FactionIndex = Triple.Faction;
+        Handle.ComplicationIndex = Triple.Complication;
+
+        return Handle;
+    }
+
+    int64 RankBrief(const FMissionBriefHandle& Handle)
+    {
+        if (!Handle.IsValid())
+        {
+            return INDEX_NONE;
+        }
+
+        const FMissionSpaceLayout& Layout = GetLayout();
+
+        const int32* TripleIndex = Layout.TripleIndices.Find(MakeTripleKey(Handle.DistrictIndex, Handle.FactionIndex, Handle.ComplicationIndex));
+        if (!TripleIndex)
+        {
+            return INDEX_NONE;
+        }
+
+        int64 Rank = *TripleIndex;
+        Rank = Rank * Layout.NumArchetypeAbilities + Layout.ArchetypeAbilityOffsets[Handle.ArchetypeIndex] + Handle.AbilityIndex;
+        Rank = Rank * Layout.NumWeapons + Handle.WeaponIndex;
+        Rank = Rank * Layout.NumImplants + Handle.ImplantIndex;
+        Rank = Rank * Layout.NumExtractionConditions + Handle.ExtractionIndex;
+
+        return Rank;
+    }
+
+    int64 PermuteRank(int64 Index, int32 Seed)
+    {
+        const int64 Total = GetLayout().Total;
+        checkf(Index >= 0 && Index < Total, TEXT("Mission index %lld outside [0, %lld)"), Index, Total);
+
+        // Smallest even-width power-of-two domain covering the space; it is less than four times
+        // the space, so cycle walking takes fewer than four encryptions on average.
+        const uint32 HalfBits = FMath::Max<uint32>(1, (FMath::CeilLogTwo64(static_cast<uint64>(Total)) + 1) / 2);
+        const uint64 Key = FMissionCounterRandom::Mix(static_cast<uint64>(static_cast<uint32>(Seed)));
+
+        uint64 Value = static_cast<uint64>(Index);
+        do
+        {
+            Value = FeistelEncrypt(Value, Key, HalfBits);
+        }
+        while (Value >= static_cast<uint64>(Total));
+
+        return static_cast<int64>(Value);
+    }
+
+    FMissionBriefHandle GetRotationBrief(int32 Seed, int64 RotationIndex)
+    {
+        const int64 Total = GetLayout().Total;
+        if (Total <= 0)
+        {
+            return FMissionBriefHandle();
+        }
+
+        const int64 Wrapped = ((RotationIndex % Total) + Total) % Total;
+        return UnrankBrief(PermuteRank(Wrapped, Seed));
+    }
+
+    void Rebuild()
+    {
+        GetMutableLayout() = BuildLayout();
+    }
+}
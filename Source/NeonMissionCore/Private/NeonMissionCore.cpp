@@ -0,0 +1,33 @@
+#include "NeonMissionCore.h"
+
+#include "MissionCatalog.h"
+#include "MissionCatalogIndex.h"
+#include "MissionModifiers.h"
+#include "MissionSampler.h"
+#include "MissionSpace.h"
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, NeonMissionCore);
+
+namespace NeonMissionCore
+{
+    void RebuildDerivedData()
+    {
+        // Each step reads the ones before it
+        FMissionCatalogIndex::Rebuild();
+        FMissionSampler::Rebuild();
+        MissionSpace::Rebuild();
+        FMissionImplantModifiers::Rebuild();
+    }
+
+    bool ReloadCatalog(FString& OutError)
+    {
+        if (!FMissionCatalog::Get().RecookAndReload(OutError))
+        {
+            return false;
+        }
+
+        RebuildDerivedData();
+        return true;
+    }
+}
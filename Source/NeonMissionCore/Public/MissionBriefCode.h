@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MissionBriefHandle.h"
+
+enum class EMissionBriefCodeResult : uint8
+{
+    Ok,
+    UnknownVersion,  // Written by a newer (or unknown) code format
+    StaleCatalog,    // Written against different catalog content
+    InvalidRank,     // Outside the current mission space
+    Malformed        // Share string could not be parsed
+};
+
+// Versioned 8-byte codes for mission briefs, for saves, replay headers, share codes and caches.
+// Layout, most significant first:
+//   [63:60] format version
+//   [59:40] catalog tag (content hash of the cooked catalog folded to 20 bits)
+//   [39:0]  MissionSpace rank
+// A code only decodes against the catalog it was encoded with; anything else is rejected rather
+// than silently resolving to a different brief.
+namespace MissionBriefCode
+{
+    constexpr uint32 FormatVersion = 1;
+
+    constexpr uint32 RankBits = 40;
+    constexpr uint32 CatalogTagBits = 20;
+    constexpr uint32 VersionBits = 4;
+
+    // Tag of the currently loaded catalog.
+    NEONMISSIONCORE_API uint32 GetCatalogTag();
+
+    // Returns false for handles that do not rank (unknown indices, incompatible combinations) and
+    // when the mission space is too large for the rank field.
+    NEONMISSIONCORE_API bool Encode(const FMissionBriefHandle& Handle, uint64& OutCode);
+
+    NEONMISSIONCORE_API EMissionBriefCodeResult Decode(uint64 Code, FMissionBriefHandle& OutHandle);
+
+    // 13-character Crockford base32 string; parsing ignores case and '-' separators.
+    NEONMISSIONCORE_API FString ToShareString(uint64 Code);
+    NEONMISSIONCORE_API bool ParseShareString(const FString& ShareString, uint64& OutCode);
+
+    // Serialises the handle as its 8-byte code. Loading returns false (and leaves a default
+    // handle) when the stored code no longer decodes.
+    NEONMISSIONCORE_API bool Serialize(FArchive& Ar, FMissionBriefHandle& Handle);
+}
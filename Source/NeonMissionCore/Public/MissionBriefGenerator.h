@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+#include "MissionBriefHandle.h"
+
+enum class EMissionSequenceMode : uint8
+{
+    // One FRandomStream shared by every draw; brief k depends on all briefs before it.
+    Sequential,
+    // Brief k depends only on (seed, k); batches are generated in parallel.
+    CounterBased
+};
+
+// Seeded mission brief sequence over the catalog. District, faction and complication draws honour
+// catalog weights and compatibility rules; the remaining draws are uniform. Not thread-safe; use
+// GenerateAt for lock-free generation from worker threads. Every draw is a default handle while the
+// catalog is empty or not loaded.
+class NEONMISSIONCORE_API FMissionBriefGenerator
+{
+public:
+    void Seed(int32 InSeed);
+
+    // Seeds from the clock if Seed was never called.
+    void EnsureSeeded();
+
+    void SetMode(EMissionSequenceMode NewMode) { Mode = NewMode; }
+    EMissionSequenceMode GetMode() const { return Mode; }
+
+    int32 GetSeed() const { return CurrentSeed; }
+
+    FMissionBriefHandle Next();
+
+    // Appends Count briefs; counter-based batches are generated in parallel.
+    void NextBatch(int32 Count, TArray<FMissionBriefHandle>& OutHandles);
+
+    // Claims Count consecutive counter-based indices and returns the first, so callers can
+    // generate (or expand) them however they like.
+    int64 ReserveIndices(int32 Count);
+
+    // Brief number RotationIndex of the current seed's rotation (see MissionSpace).
+    FMissionBriefHandle Rotation(int64 RotationIndex);
+
+    // Next Count briefs of the rotation; no duplicates until it wraps.
+    void NextUnique(int32 Count, TArray<FMissionBriefHandle>& OutHandles);
+
+    // Pure function of (Seed, BriefIndex); safe to call from any thread.
+    static FMissionBriefHandle GenerateAt(int32 Seed, int64 BriefIndex);
+
+    static int64 GetTotalCombinations();
+
+private:
+    FRandomStream RandomStream;
+    EMissionSequenceMode Mode = EMissionSequenceMode::Sequential;
+    int32 CurrentSeed = 0;
+    // Next counter-based brief index; batches advance it by Count so consecutive batches never overlap.
+    int64 NextBriefIndex = 0;
+    // Next position in the seeded rotation used by NextUnique.
+    int64 NextRotationIndex = 0;
+    bool bHasSeed = false;
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Compact mission brief: indices into the mission catalog tables instead of copies of the entries.
+// A handle is trivially copyable and never allocates. Game code resolves it to the Blueprint-facing
+// entries through NeonAscendantData (GetDistrict(Handle), ExpandBrief(Handle), ...).
+struct NEONMISSIONCORE_API FMissionBriefHandle
+{
+    uint16 DistrictIndex = 0;
+    uint16 FactionIndex = 0;
+    uint16 ArchetypeIndex = 0;
+    // Index into the archetype's ability list, not into a global ability table.
+    uint16 AbilityIndex = 0;
+    uint16 WeaponIndex = 0;
+    uint16 ImplantIndex = 0;
+    uint16 ComplicationIndex = 0;
+    uint16 ExtractionIndex = 0;
+
+    // True when every index resolves against the current catalog.
+    bool IsValid() const;
+
+    bool operator==(const FMissionBriefHandle& Other) const
+    {
+        return DistrictIndex == Other.DistrictIndex
+            && FactionIndex == Other.FactionIndex
+            && ArchetypeIndex == Other.ArchetypeIndex
+            && AbilityIndex == Other.AbilityIndex
+            && WeaponIndex == Other.WeaponIndex
+            && ImplantIndex == Other.ImplantIndex
+            && ComplicationIndex == Other.ComplicationIndex
+            && ExtractionIndex == Other.ExtractionIndex;
+    }
+
+    bool operator!=(const FMissionBriefHandle& Other) const
+    {
+        return !(*this == Other);
+    }
+};
+
+static_assert(sizeof(FMissionBriefHandle) == 16, "FMissionBriefHandle is expected to stay a 16-byte POD");
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MissionBriefHandle.h"
+
+// Independent brief sequence derived from (Seed, StreamId). Brief j of stream s is
+// FMissionBriefGenerator::GenerateAt(Seed, s * 2^LocalIndexBits + j), so stream 0 is the plain
+// counter-based sequence, different streams never share a brief index, and a stream's output does
+// not depend on which thread draws it or on what other streams do. A stream is a small value owned
+// by one caller; drawing from it reads the catalog but takes no locks.
+class NEONMISSIONCORE_API FMissionBriefStream
+{
+public:
+    static constexpr uint32 LocalIndexBits = 40;
+    static constexpr uint32 MaxStreamId = (1u << (63 - LocalIndexBits)) - 1;
+
+    FMissionBriefStream() = default;
+    FMissionBriefStream(int32 InSeed, uint32 InStreamId);
+
+    FMissionBriefHandle Next();
+
+    // Appends the next Count briefs.
+    void NextBatch(int32 Count, TArray<FMissionBriefHandle>& OutHandles);
+
+    // Brief number LocalIndex of this stream, without advancing it.
+    FMissionBriefHandle At(int64 LocalIndex) const;
+
+    int32 GetSeed() const { return Seed; }
+    uint32 GetStreamId() const { return StreamId; }
+    int64 GetPosition() const { return NextLocalIndex; }
+
+private:
+    int32 Seed = 0;
+    uint32 StreamId = 0;
+    int64 NextLocalIndex = 0;
+};
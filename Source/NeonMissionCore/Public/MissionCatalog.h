@@ -0,0 +1,195 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+// Cooked mission catalog: a header, a UTF-8 string pool and fixed-size little-endian records that
+// refer to strings and lists by offset. The file is memory-mapped and read in place, so loading is
+// one mmap regardless of catalog size. Produced from Data/MissionCatalog.json by the
+// CookMissionCatalog commandlet (or automatically in non-shipping builds when the source is newer).
+namespace MissionCatalogFormat
+{
+    constexpr uint32 Magic = 0x5441434E; // 'NCAT'
+    constexpr uint32 Version = 2;
+
+    enum class ESection : uint32
+    {
+        Strings,              // UTF-8, NUL-terminated; Count is the size in bytes
+        Lists,                // uint32 elements referenced by FRange
+        Abilities,
+        Archetypes,
+        Weapons,
+        Implants,
+        Districts,
+        Factions,
+        Complications,
+        ExtractionConditions, // uint32 string offsets
+        Count
+    };
+
+    struct FSection
+    {
+        uint32 Offset = 0;
+        uint32 Count = 0;
+    };
+
+    struct FHeader
+    {
+        uint32 Magic = 0;
+        uint32 Version = 0;
+        // CRC of everything after the header; identifies catalog content
+        uint32 ContentHash = 0;
+        uint32 Reserved = 0;
+        FSection Sections[static_cast<uint32>(ESection::Count)];
+    };
+
+    // Slice of the Lists section
+    struct FRange
+    {
+        uint32 First = 0;
+        uint32 Count = 0;
+    };
+
+    struct FAbilityRecord
+    {
+        uint32 Name;
+        uint32 Description;
+        uint32 DamageType;
+        int32 CooldownSeconds;
+        uint32 bHasCooldown;
+    };
+
+    struct FArchetypeRecord
+    {
+        uint32 Name;
+        uint32 Role;
+        uint32 Signature;
+        FRange Abilities;           // Ability record indices
+    };
+
+    struct FWeaponRecord
+    {
+        uint32 Name;
+        uint32 Category;
+        uint32 Description;
+        uint32 DamageProfile;
+    };
+
+    struct FImplantRecord
+    {
+        uint32 Name;
+        uint32 Slot;
+        FRange Effects;             // String offsets
+    };
+
+    struct FDistrictRecord
+    {
+        uint32 Name;
+        uint32 Description;
+        FRange Hazards;             // String offsets
+        FRange EnemyProfiles;       // String offsets
+        uint32 Tag;                 // Gameplay tag name, may be empty
+        float Weight;
+    };
+
+    struct FFactionRecord
+    {
+        uint32 Name;
+        uint32 Philosophy;
+        FRange SignatureTactics;    // String offsets
+        FRange OperatingDistricts;  // String offsets
+        uint32 Tag;                 // Gameplay tag name, may be empty
+        float Weight;
+    };
+
+    struct FComplicationRecord
+    {
+        uint32 Description;
+        FRange Districts;           // String offsets
+        FRange Factions;            // String offsets
+        uint32 Tag;                 // Gameplay tag name, may be empty
+        float Weight;
+    };
+}
+
+class NEONMISSIONCORE_API FMissionCatalog
+{
+public:
+    // Maps the cooked catalog on first use. If it is missing or corrupt the catalog stays empty
+    // (IsLoaded is false, every section has no entries) and GetLoadError says why.
+    static FMissionCatalog& Get();
+
+    // Replaces the project-relative default paths. Only takes effect if called before the first
+    // Get().
+    static void SetPaths(const FString& SourcePath, const FString& CookedPath);
+
+    static FString GetSourcePath();
+    static FString GetCookedPath();
+
+    // Cooks JSON source data into the binary format.
+    static bool CookFromJson(const FString& JsonText, TArray<uint8>& OutBytes, FString& OutError);
+
+    // Cooks SourcePath and writes the result to CookedPath.
+    static bool CookFile(const FString& SourcePath, const FString& CookedPath, FString& OutError);
+
+    ~FMissionCatalog();
+
+    bool IsLoaded() const { return Header != nullptr; }
+    const FString& GetLoadError() const { return LoadError; }
+    uint32 GetContentHash() const { return Header ? Header->ContentHash : 0; }
+
+    // Re-cooks the source into memory and, if it is valid, swaps it in. The caller must make sure
+    // nothing reads the catalog while this runs (see NeonMissionCore::ReloadCatalog).
+    bool RecookAndReload(FString& OutError);
+
+    int32 Num(MissionCatalogFormat::ESection Section) const;
+
+    const MissionCatalogFormat::FAbilityRecord& GetAbility(int32 Index) const { return GetRecords<MissionCatalogFormat::FAbilityRecord>(MissionCatalogFormat::ESection::Abilities)[Index]; }
+    const MissionCatalogFormat::FArchetypeRecord& GetArchetype(int32 Index) const { return GetRecords<MissionCatalogFormat::FArchetypeRecord>(MissionCatalogFormat::ESection::Archetypes)[Index]; }
+    const MissionCatalogFormat::FWeaponRecord& GetWeapon(int32 Index) const { return GetRecords<MissionCatalogFormat::FWeaponRecord>(MissionCatalogFormat::ESection::Weapons)[Index]; }
+    const MissionCatalogFormat::FImplantRecord& GetImplant(int32 Index) const { return GetRecords<MissionCatalogFormat::FImplantRecord>(MissionCatalogFormat::ESection::Implants)[Index]; }
+    const MissionCatalogFormat::FDistrictRecord& GetDistrict(int32 Index) const { return GetRecords<MissionCatalogFormat::FDistrictRecord>(MissionCatalogFormat::ESection::Districts)[Index]; }
+    const MissionCatalogFormat::FFactionRecord& GetFaction(int32 Index) const { return GetRecords<MissionCatalogFormat::FFactionRecord>(MissionCatalogFormat::ESection::Factions)[Index]; }
+    const MissionCatalogFormat::FComplicationRecord& GetComplication(int32 Index) const { return GetRecords<MissionCatalogFormat::FComplicationRecord>(MissionCatalogFormat::ESection::Complications)[Index]; }
+    uint32 GetExtractionCondition(int32 Index) const { return GetRecords<uint32>(MissionCatalogFormat::ESection::ExtractionConditions)[Index]; }
+
+    // NUL-terminated UTF-8 string in the mapped pool.
+    const ANSICHAR* GetString(uint32 Offset) const;
+
+    TConstArrayView<uint32> GetList(const MissionCatalogFormat::FRange& Range) const;
+
+private:
+    FMissionCatalog() = default;
+
+    bool MapCookedFile(const FString& Path);
+    bool AdoptBytes(TArray<uint8>&& Bytes);
+    bool ValidateAndBind(const uint8* InData, int64 InSize);
+    void Unmap();
+
+    template <typename RecordType>
+    TConstArrayView<RecordType> GetRecords(MissionCatalogFormat::ESection Section) const
+    {
+        if (!Header)
+        {
+            return TConstArrayView<RecordType>();
+        }
+
+        const MissionCatalogFormat::FSection& Info = Header->Sections[static_cast<uint32>(Section)];
+        return TConstArrayView<RecordType>(reinterpret_cast<const RecordType*>(Data + Info.Offset), Info.Count);
+    }
+
+    TUniquePtr<IMappedFileHandle> MappedFile;
+    TUniquePtr<IMappedFileRegion> MappedRegion;
+
+    // Fallback storage when the platform cannot map files
+    TArray<uint8> OwnedBytes;
+
+    const uint8* Data = nullptr;
+    int64 Size = 0;
+    const MissionCatalogFormat::FHeader* Header = nullptr;
+
+    // Set when the first load failed; cleared by a successful reload
+    FString LoadError;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Name lookups over the loaded mission catalog, rebuilt whenever the catalog is. Keys are FNames,
+// so a lookup hashes once and compares integers instead of strings. Every Find* returns
+// INDEX_NONE when nothing matches.
+class NEONMISSIONCORE_API FMissionCatalogIndex
+{
+public:
+    static const FMissionCatalogIndex& Get();
+
+    // Rebuilds the index after the catalog was reloaded. Nothing may be reading it meanwhile.
+    static void Rebuild();
+
+    int32 FindArchetype(FName Name) const { return Archetypes.Find(Name); }
+    int32 FindWeapon(FName Name) const { return Weapons.Find(Name); }
+    int32 FindImplant(FName Name) const { return Implants.Find(Name); }
+    int32 FindDistrict(FName Name) const { return Districts.Find(Name); }
+    int32 FindFaction(FName Name) const { return Factions.Find(Name); }
+    int32 FindComplication(FName Description) const { return Complications.Find(Description); }
+    int32 FindExtractionCondition(FName Condition) const { return ExtractionConditions.Find(Condition); }
+
+    // Position of the ability in the archetype's ability list.
+    int32 FindArchetypeAbility(int32 Archetype, FName AbilityName) const;
+
+private:
+    FMissionCatalogIndex();
+
+    static TUniquePtr<FMissionCatalogIndex>& GetStorage();
+
+    struct FNameTable
+    {
+        TMap<FName, int32> Indices;
+
+        void Add(FName Name, int32 Index);
+        int32 Find(FName Name) const;
+    };
+
+    FNameTable Archetypes;
+    FNameTable Weapons;
+    FNameTable Implants;
+    FNameTable Districts;
+    FNameTable Factions;
+    FNameTable Complications;
+    FNameTable ExtractionConditions;
+
+    // Ability names per archetype, in catalog order
+    TArray<TArray<FName>> ArchetypeAbilities;
+};
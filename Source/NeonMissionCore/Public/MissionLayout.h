@@ -0,0 +1,117 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MissionBriefHandle.h"
+
+enum class EMissionTile : uint8
+{
+    // Blocks movement and sight.
+    Wall,
+    Floor,
+    // Floor tile on a sector seam.
+    Door,
+    // Waist-high: blocks movement, not sight. Enemy spawns prefer tiles next to it.
+    Cover
+};
+
+// Room rule a sector was filled with.
+enum class EMissionSectorKind : uint8
+{
+    // Open floor with scattered cover.
+    Plaza,
+    // Solid block with lanes carved from every door to a small central room.
+    Corridor,
+    // Building footprint ringed by a walkway.
+    Block,
+    // Rows of cover with gaps.
+    Yard,
+    Count
+};
+
+enum class EMissionLayoutSlot : uint8
+{
+    PlayerStart,
+    Extraction,
+    EnemySpawn,
+    Hazard,
+    Count
+};
+
+struct FMissionLayoutSlot
+{
+    uint16 X = 0;
+    uint16 Y = 0;
+    EMissionLayoutSlot Type = EMissionLayoutSlot::PlayerStart;
+    // Enemy spawns: index into the district's enemy profiles. Hazards: index into its hazards.
+    uint8 Variant = 0;
+};
+
+struct FMissionLayoutSettings
+{
+    // 0 is the brief's own layout; other values give alternative layouts of the same brief.
+    int32 Variant = 0;
+    int32 SectorsX = 4;
+    int32 SectorsY = 4;
+    // Tiles per sector side, walls included. Clamped to [8, 64].
+    int32 SectorSize = 16;
+    // Chance that a seam outside the spanning tree also gets a door, so the map has loops.
+    float LoopChance = 0.25f;
+    int32 EnemySpawnCount = 12;
+    int32 HazardSlotCount = 6;
+    // Fill sectors on worker threads. The result is identical either way.
+    bool bParallel = true;
+};
+
+// Tile grid of a mission map plus the slots spawning and hazard placement read. Tiles are in
+// tile units with (0, 0) in a corner; callers pick the tile size and the world origin. Every
+// Floor and Door tile is reachable from the player start, so IsWalkable is enough to build
+// blocking geometry or a navigation mesh from.
+struct FMissionLayout
+{
+    int32 Seed = 0;
+    uint16 Width = 0;
+    uint16 Height = 0;
+    uint8 SectorSize = 0;
+    uint8 SectorsX = 0;
+    uint8 SectorsY = 0;
+
+    // Row-major, Width * Height.
+    TArray<EMissionTile> Tiles;
+    // Row-major, SectorsX * SectorsY.
+    TArray<EMissionSectorKind> SectorKinds;
+    // Grouped by type; see GetSlots.
+    TArray<FMissionLayoutSlot> Slots;
+    int32 SlotOffsets[static_cast<int32>(EMissionLayoutSlot::Count) + 1] = {};
+
+    bool IsValid() const { return Tiles.Num() > 0; }
+
+    // Outside the grid is wall.
+    EMissionTile GetTile(int32 X, int32 Y) const
+    {
+        return X >= 0 && Y >= 0 && X < Width && Y < Height ? Tiles[Y * Width + X] : EMissionTile::Wall;
+    }
+
+    bool IsWalkable(int32 X, int32 Y) const
+    {
+        const EMissionTile Tile = GetTile(X, Y);
+        return Tile == EMissionTile::Floor || Tile == EMissionTile::Door;
+    }
+
+    TConstArrayView<FMissionLayoutSlot> GetSlots(EMissionLayoutSlot Type) const
+    {
+        const int32 First = SlotOffsets[static_cast<int32>(Type)];
+        return TConstArrayView<FMissionLayoutSlot>(Slots.GetData() + First, SlotOffsets[static_cast<int32>(Type) + 1] - First);
+    }
+};
+
+// Seeded tile layouts for mission briefs. The seed is the brief's mission-space rank (see
+// MissionSpace), so a brief always gets the same map. A grammar expands the layout in three
+// steps: a sector graph (random spanning tree plus loops, one door per open seam), then a room
+// rule per sector, then slot selection. The district picks the room-rule weights, so a district
+// keeps its character across missions, and its hazard and enemy profile lists drive the slot
+// variants. Sectors only write their own tiles and draw from their own counter-based stream, so
+// they are filled in parallel without changing the result. Any thread; reads the catalog.
+namespace MissionLayout
+{
+    NEONMISSIONCORE_API FMissionLayout Generate(const FMissionBriefHandle& Handle, const FMissionLayoutSettings& Settings = FMissionLayoutSettings());
+}
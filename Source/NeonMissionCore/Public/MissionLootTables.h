@@ -0,0 +1,101 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MissionSampler.h"
+
+enum class EMissionExtractionOutcome : uint8
+{
+    Failed,
+    Standard,
+    // The extraction condition's bonus objective was met.
+    Premium,
+    Count
+};
+
+struct FMissionLootDrop
+{
+    uint16 Item = 0;
+    uint16 Quantity = 0;
+};
+
+// One reward roll: who it is for and the key that picks the reward table.
+struct FMissionLootRequest
+{
+    // Identifies the roll within the seed; see FMissionLootTables::MakeRollIndex.
+    uint64 RollIndex = 0;
+    uint16 Faction = 0;
+    uint16 District = 0;
+    EMissionExtractionOutcome Outcome = EMissionExtractionOutcome::Standard;
+};
+
+// Reward tables loaded from Data/LootTables.json. A table is a weighted list of entries; an entry
+// drops an item, rolls a nested table or drops nothing. Reward rules map (outcome, faction,
+// district) to a table, the most specific rule winning, and are resolved into a flat grid at load
+// time, so picking the table is one index and each pick inside a table is an alias-table draw.
+// A roll is a pure function of (seed, request): the same seed and roll index always give the same
+// drops, on any thread and in any batch, which is what makes rewards auditable.
+class NEONMISSIONCORE_API FMissionLootTables
+{
+public:
+    // Longest chain of nested tables a roll follows.
+    static constexpr int32 MaxNestingDepth = 8;
+    static constexpr int32 MaxSquadSize = 256;
+
+    // Data/LootTables.json in the project directory.
+    static FString GetDefaultPath();
+
+    // Parses and validates the tables; faction and district names resolve against the loaded
+    // catalog. Unknown names, unknown tables and nesting cycles are errors. Leaves the current
+    // tables untouched on failure.
+    bool LoadFromJson(const FString& JsonText, FString& OutError);
+
+    bool IsEmpty() const { return Tables.Num() == 0; }
+
+    int32 NumItems() const { return ItemNames.Num(); }
+    FName GetItemName(int32 Item) const { return ItemNames[Item]; }
+
+    // Roll index of squad member SquadSlot (< MaxSquadSize) in mission MissionIndex.
+    static uint64 MakeRollIndex(int64 MissionIndex, int32 SquadSlot)
+    {
+        return (static_cast<uint64>(MissionIndex) << 8) | static_cast<uint64>(SquadSlot & (MaxSquadSize - 1));
+    }
+
+    // Appends the drops of one roll. Any thread.
+    void Roll(int32 Seed, const FMissionLootRequest& Request, TArray<FMissionLootDrop>& OutDrops) const;
+
+    // Rolls every request (a squad, a simulated season) in parallel. Replaces both outputs; the
+    // drops of request i are OutDrops[OutOffsets[i], OutOffsets[i + 1]). Same drops as calling
+    // Roll for each request in order.
+    void RollBatch(int32 Seed, TConstArrayView<FMissionLootRequest> Requests, TArray<FMissionLootDrop>& OutDrops, TArray<int32>& OutOffsets) const;
+
+private:
+    struct FEntry
+    {
+        // Item index, or INDEX_NONE
+        int32 Item = INDEX_NONE;
+        // Nested table index, or INDEX_NONE
+        int32 Table = INDEX_NONE;
+        uint16 MinQuantity = 1;
+        uint16 MaxQuantity = 1;
+    };
+
+    struct FTable
+    {
+        FMissionAliasTable Picks;   // Outcomes are entry indices
+        TArray<FEntry> Entries;
+        int32 Rolls = 1;
+    };
+
+    template <typename RandomType>
+    void RollTable(int32 TableIndex, int32 Depth, RandomType& Random, TArray<FMissionLootDrop>& OutDrops) const;
+
+    int32 FindRewardTable(const FMissionLootRequest& Request) const;
+
+    TArray<FName> ItemNames;
+    TArray<FTable> Tables;
+
+    // Table index per (outcome, faction, district), INDEX_NONE where no rule applies
+    TArray<int32> RewardTables;
+    int32 NumFactions = 0;
+    int32 NumDistricts = 0;
+};
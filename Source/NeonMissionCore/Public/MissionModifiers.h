@@ -0,0 +1,114 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EMissionStat : uint8
+{
+    MovementSpeed,
+    WeaponDamage,
+    CriticalDamage,
+    HackSuccess,
+    Evasion,
+    Count
+};
+
+enum class EMissionModifierOp : uint8
+{
+    // Summed per stat, then applied once: +15% and +10% give x1.25.
+    AddPercent,
+    // Multiplied in after the percentages.
+    Multiply,
+    // Added to the base value before any scaling.
+    AddFlat
+};
+
+struct FMissionModifier
+{
+    EMissionStat Stat = EMissionStat::MovementSpeed;
+    EMissionModifierOp Op = EMissionModifierOp::AddPercent;
+    // Percentages as fractions: +15% is 0.15.
+    float Value = 0.0f;
+};
+
+// Implant effects compiled into typed modifiers, rebuilt whenever the catalog is. Effects are free
+// text ("+15% movement speed"); a leading signed number (optionally a percentage) plus a known stat
+// phrase becomes a modifier, and "Increases"/"Reduces" without a number use a default magnitude.
+// Effects that are not stat changes ("Unlocks ...") or are conditional ("... when ...") compile to
+// nothing.
+class NEONMISSIONCORE_API FMissionImplantModifiers
+{
+public:
+    static const FMissionImplantModifiers& Get();
+
+    // Recompiles after the catalog was reloaded. Nothing may be reading it meanwhile.
+    static void Rebuild();
+
+    TConstArrayView<FMissionModifier> GetModifiers(int32 Implant) const;
+
+    // Compiles one effect string; false if it is not a stat change.
+    static bool CompileEffect(const FString& Effect, FMissionModifier& OutModifier);
+
+private:
+    FMissionImplantModifiers();
+
+    static TUniquePtr<FMissionImplantModifiers>& GetStorage();
+
+    TArray<FMissionModifier> Modifiers;
+    // Implant i owns Modifiers[ImplantOffsets[i], ImplantOffsets[i + 1])
+    TArray<int32> ImplantOffsets;
+};
+
+// Aggregated stats of one character. Modifiers are grouped by source (an implant, a buff, a
+// status) so a source can be replaced or removed as a whole; any change only marks the cache
+// dirty, and the aggregate is rebuilt on the next read. Reads between changes are one array load.
+class NEONMISSIONCORE_API FMissionStatCache
+{
+public:
+    // Replaces the modifiers of Source.
+    void SetSource(FName Source, TConstArrayView<FMissionModifier> SourceModifiers);
+    void RemoveSource(FName Source);
+    void Reset();
+
+    bool HasSource(FName Source) const;
+
+    // (1 + summed percentages) * product of multipliers.
+    float GetMultiplier(EMissionStat Stat) const
+    {
+        Refresh();
+        return Multipliers[static_cast<int32>(Stat)];
+    }
+
+    // (Base + flat bonuses) * GetMultiplier(Stat).
+    float Apply(EMissionStat Stat, float Base) const
+    {
+        Refresh();
+        return (Base + FlatBonuses[static_cast<int32>(Stat)]) * Multipliers[static_cast<int32>(Stat)];
+    }
+
+    // Bumped by every change, so consumers can tell whether values they pushed elsewhere are stale.
+    uint32 GetRevision() const { return Revision; }
+
+private:
+    void Refresh() const
+    {
+        if (bDirty)
+        {
+            Recompute();
+        }
+    }
+
+    void Recompute() const;
+
+    struct FSource
+    {
+        FName Name;
+        TArray<FMissionModifier, TInlineAllocator<4>> Modifiers;
+    };
+
+    TArray<FSource, TInlineAllocator<4>> Sources;
+    uint32 Revision = 0;
+
+    mutable float Multipliers[static_cast<int32>(EMissionStat::Count)] = { 1.0f, 1.0f, 1.0f, 1.0f, 1.0f };
+    mutable float FlatBonuses[static_cast<int32>(EMissionStat::Count)] = {};
+    mutable bool bDirty = false;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Counter-based random source (SplitMix64). Every draw is a pure function of
+// (seed, stream index, draw number), so brief k can be produced without producing
+// briefs 0..k-1 and any number of streams can be evaluated in parallel.
+struct FMissionCounterRandom
+{
+    FMissionCounterRandom(int32 Seed, uint64 StreamIndex)
+        : Key(MakeKey(Seed, StreamIndex))
+        , Counter(0)
+    {
+    }
+
+    uint32 GetUnsignedInt()
+    {
+        return UnsignedIntAt(Key, ++Counter);
+    }
+
+    // Same contract as FRandomStream::RandRange: inclusive on both ends.
+    int32 RandRange(int32 Min, int32 Max)
+    {
+        const uint64 Range = static_cast<uint64>(static_cast<int64>(Max) - Min + 1);
+        return Min + static_cast<int32>((static_cast<uint64>(GetUnsignedInt()) * Range) >> 32);
+    }
+
+    // Uniform float in [0, 1).
+    float GetFraction()
+    {
+        return ToFraction(GetUnsignedInt());
+    }
+
+    // Stateless form: draw number Counter (1-based) of the stream keyed MakeKey(Seed, StreamIndex)
+    // is what the Counter-th call on that stream returns. Loops drawing the same counter from many
+    // keys kept in a plain array carry no per-stream object and vectorize.
+    static uint64 MakeKey(int32 Seed, uint64 StreamIndex)
+    {
+        return Mix(static_cast<uint64>(static_cast<uint32>(Seed)) ^ Mix(StreamIndex + GoldenGamma));
+    }
+
+    static uint32 UnsignedIntAt(uint64 StreamKey, uint64 DrawCounter)
+    {
+        return static_cast<uint32>(Mix(StreamKey + DrawCounter * GoldenGamma) >> 32);
+    }
+
+    static float FractionAt(uint64 StreamKey, uint64 DrawCounter)
+    {
+        return ToFraction(UnsignedIntAt(StreamKey, DrawCounter));
+    }
+
+    static uint64 Mix(uint64 Value)
+    {
+        Value = (Value ^ (Value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        Value = (Value ^ (Value >> 27)) * 0x94D049BB133111EBull;
+        return Value ^ (Value >> 31);
+    }
+
+private:
+    static constexpr uint64 GoldenGamma = 0x9E3779B97F4A7C15ull;
+
+    static float ToFraction(uint32 Value)
+    {
+        return static_cast<float>(Value >> 8) * (1.0f / 16777216.0f);
+    }
+
+    uint64 Key;
+    uint64 Counter;
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/BitArray.h"
+
+// Weighted sampling table (Vose's alias method): O(1) per draw regardless of outcome count.
+struct NEONMISSIONCORE_API FMissionAliasTable
+{
+    // Outcomes and weights are parallel arrays; non-positive weights are never drawn.
+    void Build(TConstArrayView<uint16> InOutcomes, TConstArrayView<float> Weights);
+
+    bool IsEmpty() const { return Outcomes.Num() == 0; }
+    int32 Num() const { return Outcomes.Num(); }
+
+    // Normalised probability of each column's own outcome, for analysis tools.
+    float GetOutcomeProbability(uint16 Outcome) const;
+
+    // Works with FRandomStream and FMissionCounterRandom.
+    template <typename RandomType>
+    uint16 Sample(RandomType& Random) const
+    {
+        if (Outcomes.Num() == 0)
+        {
+            return 0;
+        }
+
+        const int32 Column = Random.RandRange(0, Outcomes.Num() - 1);
+        return Random.GetFraction() < Thresholds[Column] ? Outcomes[Column] : AliasOutcomes[Column];
+    }
+
+private:
+    TArray<uint16> Outcomes;
+    TArray<uint16> AliasOutcomes;
+    TArray<float> Thresholds;
+    TArray<float> OutcomeProbabilities;
+};
+
+// Weighted, compatibility-aware draws over the mission catalog. Compatibility between districts,
+// factions and complications is resolved into bitsets once when the catalog loads, and every
+// conditional distribution gets its own alias table, so a draw never retries.
+class NEONMISSIONCORE_API FMissionSampler
+{
+public:
+    static const FMissionSampler& Get();
+
+    // Rebuilds the tables after the catalog was reloaded. Nothing may be sampling meanwhile.
+    static void Rebuild();
+
+    template <typename RandomType>
+    uint16 SampleDistrict(RandomType& Random) const
+    {
+        return DistrictTable.Sample(Random);
+    }
+
+    template <typename RandomType>
+    uint16 SampleFaction(uint16 District, RandomType& Random) const
+    {
+        return FactionTables[District].Sample(Random);
+    }
+
+    template <typename RandomType>
+    uint16 SampleComplication(uint16 District, uint16 Faction, RandomType& Random) const
+    {
+        return ComplicationTables[District * NumFactions + Faction].Sample(Random);
+    }
+
+    bool IsCompatible(int32 District, int32 Faction, int32 Complication) const;
+
+    // Factions that can appear in the district (with at least one compatible complication).
+    const TBitArray<>& GetCompatibleFactions(int32 District) const { return CompatibleFactions[District]; }
+
+    // Complications allowed for the district/faction pair.
+    const TBitArray<>& GetCompatibleComplications(int32 District, int32 Faction) const { return CompatibleComplications[District * NumFactions + Faction]; }
+
+    // Probability that a draw produces the given district/faction/complication triple.
+    double GetTripleProbability(int32 District, int32 Faction, int32 Complication) const;
+
+private:
+    FMissionSampler();
+
+    static TUniquePtr<FMissionSampler>& GetStorage();
+
+    int32 NumDistricts = 0;
+    int32 NumFactions = 0;
+
+    FMissionAliasTable DistrictTable;
+    TArray<FMissionAliasTable> FactionTables;        // Indexed by district
+    TArray<FMissionAliasTable> ComplicationTables;   // Indexed by district * NumFactions + faction
+
+    TArray<TBitArray<>> CompatibleFactions;          // Indexed by district
+    TArray<TBitArray<>> CompatibleComplications;     // Indexed by district * NumFactions + faction
+};
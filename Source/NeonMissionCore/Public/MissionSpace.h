@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MissionBriefHandle.h"
+
+// The finite space of mission briefs, addressed by rank in [0, GetTotalCombinations()).
+// Ranks are mixed-radix numbers over the catalog tables (district most significant,
+// extraction condition least significant). District, faction and complication share one digit
+// that only enumerates combinations allowed by the catalog's compatibility rules; archetype and
+// ability share another because the number of abilities differs per archetype. The space is
+// unweighted: every compatible brief has exactly one rank.
+namespace MissionSpace
+{
+    NEONMISSIONCORE_API int64 GetTotalCombinations();
+
+    // Maps a rank to its brief. Rank must be in [0, GetTotalCombinations()).
+    NEONMISSIONCORE_API FMissionBriefHandle UnrankBrief(int64 Rank);
+
+    // Inverse of UnrankBrief. Returns INDEX_NONE for handles that do not resolve or break a
+    // compatibility rule.
+    NEONMISSIONCORE_API int64 RankBrief(const FMissionBriefHandle& Handle);
+
+    // Seeded bijection of [0, GetTotalCombinations()) onto itself (Feistel network with
+    // cycle walking). Walking the permuted indices 0..N-1 visits N distinct briefs.
+    NEONMISSIONCORE_API int64 PermuteRank(int64 Index, int32 Seed);
+
+    // Brief number RotationIndex of the rotation keyed by Seed; wraps after every brief was visited.
+    // A default handle when the space is empty (catalog not loaded).
+    NEONMISSIONCORE_API FMissionBriefHandle GetRotationBrief(int32 Seed, int64 RotationIndex);
+
+    // Rebuilds the layout after the catalog was reloaded. Nothing may be ranking meanwhile.
+    NEONMISSIONCORE_API void Rebuild();
+}
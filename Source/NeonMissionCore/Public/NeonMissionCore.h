@@ -0,0 +1,14 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace NeonMissionCore
+{
+    // Rebuilds the name index, sampler, mission-space layout and compiled implant modifiers from the
+    // loaded catalog. Nothing may be generating, sampling or ranking briefs meanwhile.
+    NEONMISSIONCORE_API void RebuildDerivedData();
+
+    // Re-cooks the catalog source and, if it is valid, swaps it in and rebuilds the derived data.
+    // Same threading rules as RebuildDerivedData.
+    NEONMISSIONCORE_API bool ReloadCatalog(FString& OutError);
+}
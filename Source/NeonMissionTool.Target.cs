@@ -0,0 +1,24 @@
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+// Console program that cooks, generates and validates missions through NeonMissionCore without
+// loading the engine. Program targets inside a project need a source build of the engine.
+public class NeonMissionToolTarget : TargetRules
+{
+	public NeonMissionToolTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Program;
+		LinkType = TargetLinkType.Monolithic;
+		DefaultBuildSettings = BuildSettingsVersion.V6;
+		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_3;
+		LaunchModuleName = "NeonMissionTool";
+
+		bCompileAgainstEngine = false;
+		bCompileAgainstCoreUObject = false;
+		bCompileAgainstApplicationCore = false;
+		bBuildDeveloperTools = false;
+		bCompileICU = false;
+		bUseLoggingInShipping = true;
+		bIsBuildingConsoleApplication = true;
+	}
+}
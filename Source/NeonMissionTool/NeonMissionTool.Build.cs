@@ -0,0 +1,17 @@
+using UnrealBuildTool;
+
+public class NeonMissionTool : ModuleRules
+{
+    public NeonMissionTool(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PrivateIncludePathModuleNames.Add("Launch");
+
+        PrivateDependencyModuleNames.AddRange(new string[]
+        {
+            "Core",
+            "NeonMissionCore"
+        });
+    }
+}
@@ -0,0 +1,167 @@
+#include "RequiredProgramMainCPPInclude.h"
+
+#include "Async/ParallelFor.h"
+#include "MissionBriefCode.h"
+#include "MissionBriefGenerator.h"
+#include "MissionCatalog.h"
+#include "MissionRandom.h"
+#include "MissionSampler.h"
+#include "MissionSpace.h"
+
+IMPLEMENT_APPLICATION(NeonMissionTool, "NeonMissionTool");
+
+namespace
+{
+    constexpr int32 SlicesPerRun = 64;
+
+    void PrintUsage()
+    {
+        UE_LOG(LogTemp, Display, TEXT("Usage: NeonMissionTool -Cook=<catalog.json> -Output=<catalog.ncat>"));
+        UE_LOG(LogTemp, Display, TEXT("       NeonMissionTool -Catalog=<catalog.ncat> [-Source=<catalog.json>] -Seed=<n> -Count=<n> [-Validate] [-Print=<n>]"));
+    }
+
+    int32 Cook(const TCHAR* CommandLine, const FString& SourcePath)
+    {
+        FString OutputPath;
+        if (!FParse::Value(CommandLine, TEXT("Output="), OutputPath))
+        {
+            PrintUsage();
+            return 1;
+        }
+
+        FString Error;
+        if (!FMissionCatalog::CookFile(SourcePath, OutputPath, Error))
+        {
+            UE_LOG(LogTemp, Error, TEXT("NeonMissionTool: cooking %s failed: %s"), *SourcePath, *Error);
+            return 1;
+        }
+
+        UE_LOG(LogTemp, Display, TEXT("NeonMissionTool: cooked %s to %s"), *SourcePath, *OutputPath);
+        return 0;
+    }
+
+    // Generates Count briefs in parallel slices; with bValidate every brief must resolve, obey the
+    // compatibility rules and survive an 8-byte code round trip.
+    int32 Generate(const TCHAR* CommandLine)
+    {
+        FString CatalogPath;
+        FString SourcePath;
+        int32 Seed = 0;
+        int64 Count = 0;
+        int32 PrintCount = 0;
+        if (!FParse::Value(CommandLine, TEXT("Catalog="), CatalogPath) || !FParse::Value(CommandLine, TEXT("Seed="), Seed) || !FParse::Value(CommandLine, TEXT("Count="), Count) || Count <= 0)
+        {
+            PrintUsage();
+            return 1;
+        }
+
+        FParse::Value(CommandLine, TEXT("Source="), SourcePath);
+        FParse::Value(CommandLine, TEXT("Print="), PrintCount);
+        const bool bValidate = FParse::Param(CommandLine, TEXT("Validate"));
+
+        FMissionCatalog::SetPaths(SourcePath, CatalogPath);
+        const FMissionCatalog& Catalog = FMissionCatalog::Get();
+        if (!Catalog.IsLoaded())
+        {
+            UE_LOG(LogTemp, Error, TEXT("NeonMissionTool: %s"), *Catalog.GetLoadError());
+            return 1;
+        }
+
+        const FMissionSampler& Sampler = FMissionSampler::Get();
+        UE_LOG(LogTemp, Display, TEXT("NeonMissionTool: catalog %s (hash 0x%08x), %lld distinct briefs"),
+            *CatalogPath, Catalog.GetContentHash(), FMissionBriefGenerator::GetTotalCombinations());
+
+        for (int64 Index = 0; Index < FMath::Min<int64>(PrintCount, Count); ++Index)
+        {
+            const FMissionBriefHandle Handle = FMissionBriefGenerator::GenerateAt(Seed, Index);
+            uint64 Code = 0;
+            MissionBriefCode::Encode(Handle, Code);
+            UE_LOG(LogTemp, Display, TEXT("  %lld: %s  %s / %s / %s"), Index, *MissionBriefCode::ToShareString(Code),
+                UTF8_TO_TCHAR(Catalog.GetString(Catalog.GetDistrict(Handle.DistrictIndex).Name)),
+                UTF8_TO_TCHAR(Catalog.GetString(Catalog.GetFaction(Handle.FactionIndex).Name)),
+                UTF8_TO_TCHAR(Catalog.GetString(Catalog.GetComplication(Handle.ComplicationIndex).Description)));
+        }
+
+        // Per-slice failure counts and checksums; the combined checksum identifies the sequence, so
+        // two runs (or the game and the tool) can be compared without writing briefs out
+        TArray<int64> SliceFailures;
+        SliceFailures.SetNumZeroed(SlicesPerRun);
+        TArray<uint64> SliceChecksums;
+        SliceChecksums.SetNumZeroed(SlicesPerRun);
+        const int64 SliceSize = FMath::DivideAndRoundUp<int64>(Count, SlicesPerRun);
+
+        const double StartTime = FPlatformTime::Seconds();
+        ParallelFor(TEXT("NeonMissionTool"), SlicesPerRun, 1, [&](int32 Slice)
+        {
+            const int64 SliceBegin = FMath::Min(Count, Slice * SliceSize);
+            const int64 SliceEnd = FMath::Min(Count, SliceBegin + SliceSize);
+            for (int64 Index = SliceBegin; Index < SliceEnd; ++Index)
+            {
+                const FMissionBriefHandle Handle = FMissionBriefGenerator::GenerateAt(Seed, Index);
+                SliceChecksums[Slice] += FMissionCounterRandom::Mix(static_cast<uint64>(Index) ^ static_cast<uint64>(MissionSpace::RankBrief(Handle)));
+                if (!bValidate)
+                {
+                    continue;
+                }
+
+                uint64 Code = 0;
+                FMissionBriefHandle Decoded;
+                const bool bValid = Handle.IsValid()
+                    && Sampler.IsCompatible(Handle.DistrictIndex, Handle.FactionIndex, Handle.ComplicationIndex)
+                    && MissionBriefCode::Encode(Handle, Code)
+                    && MissionBriefCode::Decode(Code, Decoded) == EMissionBriefCodeResult::Ok
+                    && Decoded == Handle;
+
+                if (!bValid)
+                {
+                    ++SliceFailures[Slice];
+                }
+            }
+        });
+        const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+        int64 Failures = 0;
+        uint64 Checksum = 0;
+        for (int32 Slice = 0; Slice < SlicesPerRun; ++Slice)
+        {
+            Failures += SliceFailures[Slice];
+            Checksum += SliceChecksums[Slice];
+        }
+
+        UE_LOG(LogTemp, Display, TEXT("NeonMissionTool: %s %lld briefs (seed %d) in %.3f s (%.1f M/s), checksum %016llx"),
+            bValidate ? TEXT("generated and validated") : TEXT("generated"), Count, Seed, Seconds, Count / FMath::Max(Seconds, 1e-9) / 1e6, Checksum);
+
+        if (Failures > 0)
+        {
+            UE_LOG(LogTemp, Error, TEXT("NeonMissionTool: %lld briefs failed validation"), Failures);
+            return 1;
+        }
+
+        return 0;
+    }
+}
+
+INT32_MAIN_INT32_ARGC_TCHAR_ARGV()
+{
+    FTaskTagScope Scope(ETaskTag::EGameThread);
+    ON_SCOPE_EXIT
+    {
+        FEngineLoop::AppPreExit();
+        FModuleManager::Get().UnloadModulesAtShutdown();
+        FEngineLoop::AppExit();
+    };
+
+    const FString CommandLine = FCommandLine::BuildFromArgV(nullptr, ArgC, ArgV, nullptr);
+    if (GEngineLoop.PreInit(*CommandLine) != 0)
+    {
+        return 1;
+    }
+
+    FString CookSourcePath;
+    if (FParse::Value(*CommandLine, TEXT("Cook="), CookSourcePath))
+    {
+        return Cook(*CommandLine, CookSourcePath);
+    }
+
+    return Generate(*CommandLine);
+}